@@ -1,9 +1,45 @@
 #include <MqttManager.hpp>
+#include <WifiManager.hpp>
+
+namespace {
+
+char telemetryRecord[1024]; // Only written on the dispatcher, when entering CONNECTED
+
+// Publish the record written to telemetryRecord on /telemetry/<component>/<record>
+void publishTelemetry(MqttManager& mqtt, componentId_t component, const char* record, std::size_t length) {
+    if (length >= sizeof(telemetryRecord)) {
+        EVENT_LOG(WARN, MqttManager, "%s %s record needs %u bytes, not published", enum_names::nameOf(component),
+                  record, static_cast<unsigned>(length));
+        return;
+    }
+    mqtt.publish(std::string("/telemetry/") + enum_names::nameOf(component) + "/" + record,
+                 std::string(telemetryRecord, length));
+}
+
+// One JSON record per component, for tuning reconnect backoff across units
+template <typename State>
+void publishStateStats(MqttManager& mqtt, componentId_t component, const StateStats<State>& stats, State current) {
+    publishTelemetry(mqtt, component, "states", stats.writeJson(telemetryRecord, sizeof(telemetryRecord), current));
+}
+
+} // namespace
 
 void MqttManager::init() {
     esp_mqtt_client_config_t mqtt_cfg = {};
     mqtt_cfg.broker.address.uri = CONFIG_MQTT_BROKER_URI; // Use URI for the broker address
 
+    // Wi-Fi up starts the connect latency, any other Wi-Fi state drops it, entering CONNECTED here records it
+    wifiSubscription = EventBus::getInstance().subscribe(
+        EventFilter::any().components(componentId_t::WifiManager).types(eventType_t::STATE_CHANGED),
+        [this](const Event& event) {
+            if (event.is(componentId_t::WifiManager, wifiState_t::CONNECTED)) {
+                wifiToConnected.start();
+            } else {
+                wifiToConnected.cancel();
+            }
+        });
+
+    start();
     client = esp_mqtt_client_init(&mqtt_cfg);
     esp_mqtt_client_register_event(client, MQTT_EVENT_ANY, &MqttManager::eventHandler, this);
     esp_mqtt_client_start(client);
@@ -37,47 +73,87 @@ int MqttManager::unsubscribe(const std::string& topic) {
     return msg_id;
 }
 
-void MqttManager::eventHandler(void* handler_args, esp_event_base_t base, int32_t event_id, void* event_data) {
-    auto& self = MqttManager::getInstance();
-    esp_mqtt_event_handle_t event = static_cast<esp_mqtt_event_handle_t>(event_data);
+MqttManager::Reaction MqttManager::handle(mqttState_t state, const ActiveEvent& event) {
+    switch (static_cast<mqttSignal_t>(event.signal)) {
+        case mqttSignal_t::CONNECTED:
+            return state == mqttState_t::CONNECTED ? handled() : transitionTo(mqttState_t::CONNECTED);
 
-    ESP_LOGD(TAG, "Event dispatched from event loop base=%s, event_id=%" PRIi32, base, event_id);
+        case mqttSignal_t::DISCONNECTED:
+            return state == mqttState_t::DISCONNECTED ? handled() : transitionTo(mqttState_t::DISCONNECTED);
 
-    switch (static_cast<esp_mqtt_event_id_t>(event_id)) {
-        case MQTT_EVENT_CONNECTED:
-            self.setState(mqttState_t::CONNECTED);
+        case mqttSignal_t::SUBSCRIBED:
+            ESP_LOGI(TAG, "MQTT_EVENT_SUBSCRIBED, msg_id=%d", static_cast<int>(event.param));
+            if (state == mqttState_t::CONNECTED) {
+                // test
+                publish("/topic/qos1", "data");
+            }
+            return handled();
+
+        case mqttSignal_t::UNSUBSCRIBED:
+            ESP_LOGI(TAG, "MQTT_EVENT_UNSUBSCRIBED, msg_id=%d", static_cast<int>(event.param));
+            return handled();
+
+        case mqttSignal_t::PUBLISHED:
+            ESP_LOGI(TAG, "MQTT_EVENT_PUBLISHED, msg_id=%d", static_cast<int>(event.param));
+            return handled();
+    }
+    return unhandled();
+}
+
+void MqttManager::onEntry(mqttState_t state) {
+    switch (state) {
+        case mqttState_t::CONNECTED:
             ESP_LOGI(TAG, "MQTT_EVENT_CONNECTED");
-            
             {
                 // test
-                self.publish("/topic/qos1", "data_3");
-                self.subscribe("/topic/qos1");
-                self.unsubscribe("/topic/qos1");
+                publish("/topic/qos1", "data_3");
+                subscribe("/topic/qos1");
+                unsubscribe("/topic/qos1");
             }
+            publishStateStats(*this, componentId_t::WifiManager, WifiManager::getInstance().stateStats(),
+                              WifiManager::getInstance().getState());
+            publishStateStats(*this, componentId_t::MqttManager, stateStats(), state);
+            wifiToConnected.stop(); // Here rather than on the bus, so this connect is in the record below
+            publishTelemetry(*this, componentId_t::MqttManager, "connect_latency",
+                             wifiToConnected.writeJson(telemetryRecord, sizeof(telemetryRecord)));
+            break;
+
+        case mqttState_t::DISCONNECTED:
+            ESP_LOGI(TAG, "MQTT_EVENT_DISCONNECTED");
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Runs on the MQTT client's task: state changes are only posted, payloads that the client frees after the callback
+// returns are logged here
+void MqttManager::eventHandler(void* handler_args, esp_event_base_t base, int32_t event_id, void* event_data) {
+    auto& self = *static_cast<MqttManager*>(handler_args);
+    esp_mqtt_event_handle_t event = static_cast<esp_mqtt_event_handle_t>(event_data);
+
+    ESP_LOGD(TAG, "Event dispatched from event loop base=%s, event_id=%" PRIi32, base, event_id);
 
+    switch (static_cast<esp_mqtt_event_id_t>(event_id)) {
+        case MQTT_EVENT_CONNECTED:
+            self.post(mqttSignal_t::CONNECTED);
             break;
 
         case MQTT_EVENT_DISCONNECTED:
-            self.setState(mqttState_t::DISCONNECTED);
-            ESP_LOGI(TAG, "MQTT_EVENT_DISCONNECTED");
+            self.post(mqttSignal_t::DISCONNECTED);
             break;
 
         case MQTT_EVENT_SUBSCRIBED:
-            ESP_LOGI(TAG, "MQTT_EVENT_SUBSCRIBED, msg_id=%d", event->msg_id);
-            
-            {
-                // test
-                self.publish("/topic/qos1", "data");
-            }
-
+            self.post(mqttSignal_t::SUBSCRIBED, event->msg_id);
             break;
 
         case MQTT_EVENT_UNSUBSCRIBED:
-            ESP_LOGI(TAG, "MQTT_EVENT_UNSUBSCRIBED, msg_id=%d", event->msg_id);
+            self.post(mqttSignal_t::UNSUBSCRIBED, event->msg_id);
             break;
 
         case MQTT_EVENT_PUBLISHED:
-            ESP_LOGI(TAG, "MQTT_EVENT_PUBLISHED, msg_id=%d", event->msg_id);
+            self.post(mqttSignal_t::PUBLISHED, event->msg_id);
             break;
 
         case MQTT_EVENT_DATA:
@@ -100,4 +176,4 @@ void MqttManager::eventHandler(void* handler_args, esp_event_base_t base, int32_
             ESP_LOGI(TAG, "Other event id:%d", event->event_id);
             break;
     }
-}
\ No newline at end of file
+}
@@ -10,24 +10,33 @@
 #include <esp_netif.h>
 #include <esp_log.h>
 #include <mqtt_client.h>
-#include <condition_variable>
-#include <mutex>
 
 #include <../../src/credentials.h>
-#include <StatefulObject.hpp>
+#include <ActiveObject.hpp>
 
 /* MQTT configuration */
 constexpr auto MQTT_SERVER = CONFIG_MQTT_BROKER_SERVER;
 constexpr auto MQTT_USERNAME = CONFIG_MQTT_BROKER_USERNAME;
 constexpr auto MQTT_PASSWORD = CONFIG_MQTT_BROKER_PASSWORD;
 
-enum class mqttState_t {
-    NOT_INITIALIZED,
+#define MQTT_STATES(X) X(NOT_INITIALIZED) X(DISCONNECTED) X(CONNECTED)
+
+enum class mqttState_t : std::uint16_t {
+    MQTT_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(mqttState_t, MQTT_STATES)
+
+// Events posted from the MQTT client's event handler, param is the msg_id where the client reports one
+enum class mqttSignal_t : std::uint16_t {
+    CONNECTED,
     DISCONNECTED,
-    CONNECTED
+    SUBSCRIBED,
+    UNSUBSCRIBED,
+    PUBLISHED
 };
 
-class MqttManager : public StatefulObjectLogged<mqttState_t> {
+class MqttManager : public ActiveObject<mqttState_t> {
 public:
     static MqttManager& getInstance() {
         static MqttManager instance; // Get the singleton instance
@@ -46,21 +55,18 @@ public:
 
     int unsubscribe(const std::string& topic);
 
-private:
-    MqttManager()
-        : StatefulObjectLogged<mqttState_t>("MqttManager", mqttState_t::NOT_INITIALIZED) {
+    // From WifiManager entering CONNECTED to this entering CONNECTED, while Wi-Fi stayed up
+    const LatencyStats<>& connectLatency() const {
+        return wifiToConnected;
     }
 
-    ~MqttManager() {
+private:
+    MqttManager() : ActiveObject<mqttState_t>(componentId_t::MqttManager, kHierarchy, mqttState_t::NOT_INITIALIZED) {
     }
 
-    std::string getStateAsString() const override {
-        switch (getState()) {
-            case mqttState_t::NOT_INITIALIZED: return "NOT_INITIALIZED";
-            case mqttState_t::DISCONNECTED: return "DISCONNECTED";
-            case mqttState_t::CONNECTED: return "CONNECTED";
-            default: return "UNKNOWN";
-        }
+    ~MqttManager() {
+        EventBus::getInstance().unsubscribe(wifiSubscription);
+        stop();
     }
 
     esp_mqtt_client_handle_t getMqttClient() {
@@ -75,10 +81,19 @@ private:
 
     static void eventHandler(void* handler_args, esp_event_base_t base, int32_t event_id, void* event_data);
 
-    std::mutex mtx;
-    std::condition_variable cv;
+    void post(mqttSignal_t signal, int msgId = 0) {
+        ActiveObject::post({static_cast<std::uint16_t>(signal), static_cast<std::uint32_t>(msgId)});
+    }
+
+    Reaction handle(mqttState_t state, const ActiveEvent& event) override;
+
+    void onEntry(mqttState_t state) override;
+
+    static constexpr Hierarchy kHierarchy{}; // Flat, all states are top-level
 
     static constexpr const char* TAG = "MqttManager";
 
     esp_mqtt_client_handle_t client{nullptr};
+    LatencyStats<> wifiToConnected;
+    EventBus::SubscriptionId wifiSubscription{EventBus::kInvalidSubscription};
 };
\ No newline at end of file
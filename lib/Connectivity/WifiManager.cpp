@@ -1,8 +1,24 @@
 #include <WifiManager.hpp>
+#include <TimeService.hpp>
 
 int WifiManager::wifi_reconnect_retry_count = 0;
 EventGroupHandle_t WifiManager::s_wifi_event_group = xEventGroupCreate();
 
+// reconnectTask calls esp_wifi_connect() without passing through CONNECTING, hence DISCONNECTED -> CONNECTED
+const WifiManager::Table WifiManager::kTransitions{
+    {
+        {wifiState_t::NOT_INITIALIZED, wifiState_t::CONNECTING},
+        {wifiState_t::NOT_INITIALIZED, wifiState_t::DISCONNECTED},
+        {wifiState_t::CONNECTING, wifiState_t::CONNECTED},
+        {wifiState_t::CONNECTING, wifiState_t::DISCONNECTED},
+        {wifiState_t::DISCONNECTED, wifiState_t::CONNECTING},
+        {wifiState_t::DISCONNECTED, wifiState_t::CONNECTED},
+        {wifiState_t::CONNECTED, wifiState_t::DISCONNECTED},
+    },
+    {
+        {wifiState_t::CONNECTED, &WifiManager::onConnected},
+    }};
+
 void WifiManager::init() {
     s_wifi_event_group = xEventGroupCreate();
     ESP_ERROR_CHECK(esp_netif_init());
@@ -42,8 +58,7 @@ void WifiManager::reconnectTask() {
 
     int backoffDelay = 10; // Start with 10 seconds
     while (true) {
-        std::unique_lock<std::mutex> lock(mtx);
-        cv.wait(lock, [this] { return getState() == wifiState_t::DISCONNECTED; });
+        waitFor(wifiState_t::DISCONNECTED);
 
         ESP_LOGI(TAG, "Attempting to reconnect to Wi-Fi...");
 
@@ -57,9 +72,7 @@ void WifiManager::reconnectTask() {
             esp_restart();
         }
 
-        cv.wait_for(lock, std::chrono::seconds(backoffDelay), [this] { return getState() == wifiState_t::CONNECTED; });
-
-        if (isConnected()) {
+        if (waitFor(wifiState_t::CONNECTED, std::chrono::seconds(backoffDelay))) {
             ESP_LOGD(TAG, "Connection restored. ReconnectTask will now wait for the next disconnect event.");
 
             backoffDelay = 10; // Reset backoff delay
@@ -93,15 +106,17 @@ void WifiManager::checkInternetConnectivityTask() {
     ESP_LOGD(TAG, "checkInternetConnectivityTask Started");
 
     while (true) {
-        std::unique_lock<std::mutex> lock(mtx);
-
-        // Wait for a notification (e.g., WiFi connected event)
-        cv.wait_for(lock, std::chrono::seconds(300), [this] { return isConnected(); });
+        // Sleep until WiFi is connected (e.g., WiFi connected event)
+        waitFor(wifiState_t::CONNECTED);
 
         if (!checkInternetConnectivity()) {
             ESP_LOGD(TAG, "No internet connectivity, triggering reconnection...");
             reconnect();
+            continue;
         }
+
+        // Check again in 300 seconds, or right after the link went down and came back
+        waitUntilChanged(wifiState_t::CONNECTED, std::chrono::seconds(300));
     }
 }
 
@@ -127,36 +142,32 @@ void WifiManager::updateCredentials(const std::string& ssid, const std::string&
     ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
     ESP_LOGI(TAG, "WiFi credentials updated. Reconnecting...");
 
-    setState(wifiState_t::DISCONNECTED);
-    cv.notify_all();
+    changeToState(wifiState_t::DISCONNECTED);
 }
 
 void WifiManager::reconnect() {
-    setState(wifiState_t::DISCONNECTED);
-    cv.notify_all();
+    changeToState(wifiState_t::DISCONNECTED);
+}
+
+void WifiManager::onConnected(WifiManager&, wifiState_t, wifiState_t) {
+    wifi_reconnect_retry_count = 0;
+    xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
+    TimeService::getInstance().startSntp(); // Wall-clock time for logs and samples, started on the first connect
 }
 
 void WifiManager::eventHandler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data) {
     auto& self = WifiManager::getInstance();
 
     if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
-        self.setState(wifiState_t::CONNECTING);
+        self.changeToState(wifiState_t::CONNECTING);
         ESP_ERROR_CHECK(esp_wifi_connect());
 
     } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
         ESP_LOGI(TAG, "Wifi connect to the AP FAIL or DISCONNECTED");
-        self.setState(wifiState_t::DISCONNECTED);
-
-        // Notify the reconnectTask to start
-        self.cv.notify_all();
+        self.changeToState(wifiState_t::DISCONNECTED);
     } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
         auto* event = static_cast<ip_event_got_ip_t*>(event_data);
         ESP_LOGI(TAG, "Wifi Successfully CONNECTED. Got IP: " IPSTR, IP2STR(&event->ip_info.ip));
-        self.setState(wifiState_t::CONNECTED);
-        wifi_reconnect_retry_count = 0;
-        xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
-
-        // Notify the reconnectTask that the connection is restored
-        self.cv.notify_all();
+        self.changeToState(wifiState_t::CONNECTED);
     }
 }
@@ -12,28 +12,28 @@
 #include <freertos/event_groups.h>
 #include <ping/ping_sock.h>
 #include <string.h>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 
 #include <../../src/credentials.h>
-#include <StatefulObject.hpp>
+#include <StateMachine.hpp>
 
 /* WiFi configuration */
 constexpr auto WIFI_SSID = CONFIG_WIFI_SSID;
 constexpr auto WIFI_PASS = CONFIG_WIFI_PASSWORD;
 constexpr auto WIFI_RECONNECT_ATTEMPT_MAXIMUM_RETRY = 5;
 
-enum class wifiState_t {
-    NOT_INITIALIZED,
-    DISCONNECTED,
-    CONNECTING,
-    CONNECTED
+#define WIFI_STATES(X) X(NOT_INITIALIZED) X(DISCONNECTED) X(CONNECTING) X(CONNECTED)
+
+enum class wifiState_t : std::uint16_t {
+    WIFI_STATES(ENUM_NAMES_VALUE)
 };
 
-class WifiManager : public StatefulObjectLogged<wifiState_t> {
+DEFINE_ENUM_NAMES(wifiState_t, WIFI_STATES)
+
+class WifiManager : public StateMachineLogged<wifiState_t, WifiManager> {
 public:
     static WifiManager& getInstance() {
         static WifiManager instance; // Get the singleton instance
@@ -54,7 +54,12 @@ private:
     static void eventHandler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data);
     void checkWifiSignalStrength();
 
-    WifiManager() : StatefulObjectLogged<wifiState_t>("WifiManager", wifiState_t::NOT_INITIALIZED) {
+    // Entry action of CONNECTED, reconnectTask itself waits on the state
+    static void onConnected(WifiManager& self, wifiState_t from, wifiState_t to);
+
+    WifiManager()
+        : StateMachineLogged<wifiState_t, WifiManager>(componentId_t::WifiManager, kTransitions, *this,
+                                                       wifiState_t::NOT_INITIALIZED) {
         std::thread(&WifiManager::reconnectTask, this).detach();
     }
 
@@ -64,18 +69,7 @@ private:
         }
     }
 
-    std::string getStateAsString() const override {
-        switch (getState()) {
-            case wifiState_t::NOT_INITIALIZED: return "NOT_INITIALIZED";
-            case wifiState_t::DISCONNECTED: return "DISCONNECTED";
-            case wifiState_t::CONNECTING: return "CONNECTING";
-            case wifiState_t::CONNECTED: return "CONNECTED";
-            default: return "UNKNOWN";
-        }
-    }
-
-    std::mutex mtx;
-    std::condition_variable cv;
+    static const Table kTransitions;
     std::thread wifiCheckThread;
     static constexpr const char* TAG = "WifiManager";
     static int wifi_reconnect_retry_count;
@@ -0,0 +1,169 @@
+/**
+ * @file Decimator.hpp
+ * @brief decimation kernels that reduce 1-4 kHz raw streams to publishable rates: a box-car average (keep one averaged
+ * sample per Factor) and a streaming FIR decimator (low-pass with the given taps, keep every Factor-th output).
+ *
+ * both work on contiguous rows, e.g. the channels of a SampleFrame. loops are written so the compiler can vectorize
+ * them without reassociating float sums: the FIR accumulates every output in its own lane, tap by tap over contiguous
+ * polyphase rows, instead of running one dot product per output. on the host that becomes SSE/AVX code at -O3 (see env:bm_all); on the ESP32
+ * the same loops compile to scalar code.
+ *
+ * samples are float or int16_t. int16_t is fixed point: sums are taken in int32_t, FIR taps are Q15 and results are
+ * rounded and saturated back to int16_t.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include "SampleFrame.hpp"
+#include "SampleTraits.hpp"
+
+#ifndef DSP_MAX_BLOCK
+#define DSP_MAX_BLOCK 256 // Input samples a FirDecimator filters in one pass
+#endif
+
+namespace dsp {
+
+// Mean of every Factor input samples. returns the samples written, in.size() / Factor at most out.size()
+template <std::size_t Factor, typename T, std::size_t N>
+std::size_t decimateAverage(std::span<const T, N> in, std::span<T> out) {
+    static_assert(Factor > 0, "Factor is the number of input samples per output sample");
+    using Traits = SampleTraits<T>;
+    const std::size_t count = std::min(in.size() / Factor, out.size());
+    const T* __restrict source = in.data();
+    T* __restrict target = out.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        typename Traits::Accumulator sum{};
+        for (std::size_t k = 0; k < Factor; ++k) {
+            sum += source[i * Factor + k];
+        }
+        target[i] = Traits::fromSum(sum, Factor);
+    }
+    return count;
+}
+
+// Lets a mutable row, e.g. SampleFrame::channel(), be passed as input
+template <std::size_t Factor, typename T, std::size_t N>
+std::size_t decimateAverage(std::span<T, N> in, std::span<T> out) {
+    return decimateAverage<Factor>(std::span<const T, N>(in), out);
+}
+
+// Streaming low-pass + downsample of one channel, keeps the history it needs between blocks, so a stream can be fed
+// in blocks of any size. y[m] = sum over k of taps[k] * x[m * Factor + Factor - 1 - k]
+//
+// polyphase: each block is split into Factor phases (every Factor-th sample), and tap k only ever meets samples of
+// one phase, so the inner loop walks a contiguous phase row at the output rate instead of striding through the input
+template <typename T, std::size_t Taps, std::size_t Factor>
+class FirDecimator {
+    static_assert(Taps > 0 && Factor > 0, "a FirDecimator needs taps and a factor");
+    static_assert(DSP_MAX_BLOCK >= Factor, "DSP_MAX_BLOCK must hold a decimation group");
+
+public:
+    using Traits = SampleTraits<T>;
+    using Coefficient = typename Traits::Coefficient;
+    static constexpr std::size_t kChunkOutputs = DSP_MAX_BLOCK / Factor;
+    static constexpr std::size_t kPhaseHistory = (Taps + Factor - 1) / Factor - 1; // Per phase, from earlier blocks
+
+    explicit FirDecimator(const std::array<Coefficient, Taps>& taps) : taps(taps) {
+    }
+
+    // in.size() must be a multiple of Factor (a partial group at the end is ignored). returns the samples written,
+    // in.size() / Factor at most out.size()
+    std::size_t process(std::span<const T> in, std::span<T> out) {
+        std::size_t written = 0;
+        std::size_t groups = std::min(in.size() / Factor, out.size());
+        const T* source = in.data();
+        while (groups > 0) {
+            const std::size_t chunk = std::min(groups, kChunkOutputs);
+            filterChunk(source, chunk, out.data() + written);
+            source += chunk * Factor;
+            written += chunk;
+            groups -= chunk;
+        }
+        return written;
+    }
+
+    void reset() {
+        for (auto& phase : phases) {
+            std::fill(phase.begin(), phase.begin() + kPhaseHistory, T{});
+        }
+    }
+
+private:
+    void filterChunk(const T* source, std::size_t outputs, T* target) {
+        for (std::size_t r = 0; r < Factor; ++r) {
+            T* __restrict phase = phases[r].data() + kPhaseHistory;
+            for (std::size_t m = 0; m < outputs; ++m) {
+                phase[m] = source[m * Factor + r];
+            }
+        }
+
+        std::array<typename Traits::Accumulator, kChunkOutputs> sums{};
+        typename Traits::Accumulator* __restrict acc = sums.data();
+        // Tap k = q * Factor + s reads phase Factor - 1 - s, q outputs back
+        for (std::size_t k = 0; k < Taps; ++k) {
+            const typename Traits::Accumulator coefficient = taps[k];
+            const T* __restrict x = phases[Factor - 1 - k % Factor].data() + kPhaseHistory - k / Factor;
+            for (std::size_t m = 0; m < outputs; ++m) {
+                acc[m] += coefficient * static_cast<typename Traits::Accumulator>(x[m]);
+            }
+        }
+        for (std::size_t m = 0; m < outputs; ++m) {
+            target[m] = Traits::fromProducts(acc[m]);
+        }
+
+        for (auto& phase : phases) {
+            std::copy(phase.begin() + outputs, phase.begin() + outputs + kPhaseHistory, phase.begin());
+        }
+    }
+
+    std::array<Coefficient, Taps> taps;
+    alignas(DSP_ALIGNMENT) std::array<std::array<T, kPhaseHistory + kChunkOutputs>, Factor> phases{};
+};
+
+// Decimate every channel of a frame into a frame Factor times shorter
+template <std::size_t Factor, typename T, std::size_t Channels, std::size_t Samples>
+void decimateAverage(const SampleFrame<T, Channels, Samples>& in, SampleFrame<T, Channels, Samples / Factor>& out) {
+    std::size_t written = 0;
+    for (std::size_t c = 0; c < Channels; ++c) {
+        std::span<const T, Samples> row = in.channel(c);
+        written = decimateAverage<Factor>(std::span<const T>(row.data(), in.size()), std::span<T>(out.channel(c)));
+    }
+    out.setSize(written);
+    out.setFirstSampleTicks(in.getFirstSampleTicks());
+}
+
+// One FirDecimator per channel, fed a frame at a time
+template <typename T, std::size_t Channels, std::size_t Taps, std::size_t Factor>
+class FrameDecimator {
+public:
+    explicit FrameDecimator(const std::array<typename SampleTraits<T>::Coefficient, Taps>& taps)
+        : FrameDecimator(taps, std::make_index_sequence<Channels>{}) {
+    }
+
+    template <std::size_t Samples>
+    void process(const SampleFrame<T, Channels, Samples>& in, SampleFrame<T, Channels, Samples / Factor>& out) {
+        std::size_t written = 0;
+        for (std::size_t c = 0; c < Channels; ++c) {
+            std::span<const T, Samples> row = in.channel(c);
+            written = channels[c].process(std::span<const T>(row.data(), in.size()), std::span<T>(out.channel(c)));
+        }
+        out.setSize(written);
+        out.setFirstSampleTicks(in.getFirstSampleTicks());
+    }
+
+private:
+    template <std::size_t... I>
+    FrameDecimator(const std::array<typename SampleTraits<T>::Coefficient, Taps>& taps, std::index_sequence<I...>)
+        : channels{((void)I, FirDecimator<T, Taps, Factor>(taps))...} {
+    }
+
+    std::array<FirDecimator<T, Taps, Factor>, Channels> channels;
+};
+
+} // namespace dsp
@@ -0,0 +1,170 @@
+/**
+ * @file Fft.hpp
+ * @brief real-input FFT of a power-of-two size N, with its twiddle, bit-reversal and window tables computed at compile
+ * time: on the ESP32 they are constants in flash, nothing is generated or allocated at run time.
+ *
+ * the N real samples are transformed as N/2 complex ones (even samples real, odd samples imaginary) by an in-place
+ * radix-2 FFT, then split into the spectrum of the real signal, which costs about half of a complex FFT of size N.
+ * input and output share one buffer of N/2 complex values, so a 4096 point transform needs 16 KB, not 48 KB.
+ *
+ * packed output: data[k] is bin k for 0 < k < N/2; bin 0 and bin N/2 are both real, data[0] holds them as
+ * (bin 0, bin N/2).
+ *
+ */
+
+#pragma once
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace dsp {
+
+namespace detail {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// sin and cos for table generation, std::sin is not constexpr in C++20
+constexpr double sinConstexpr(double x) {
+    // Reduce to [-pi, pi], then to [-pi/2, pi/2] where the series converges fast
+    const double turns = x / (2 * kPi);
+    x -= 2 * kPi * static_cast<double>(static_cast<long long>(turns + (turns >= 0 ? 0.5 : -0.5)));
+    if (x > kPi / 2) {
+        x = kPi - x;
+    } else if (x < -kPi / 2) {
+        x = -kPi - x;
+    }
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 12; ++n) {
+        term *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cosConstexpr(double x) {
+    return sinConstexpr(x + kPi / 2);
+}
+
+// Plain complex product, std::complex * goes through a NaN-checking library call without -ffast-math
+inline std::complex<float> multiply(std::complex<float> a, std::complex<float> b) {
+    return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+
+} // namespace detail
+
+// Periodic Hann window, w[n] = 0.5 - 0.5 cos(2 pi n / N), the usual choice for spectra of continuous signals
+template <std::size_t N>
+constexpr std::array<float, N> hannWindow() {
+    std::array<float, N> window{};
+    for (std::size_t n = 0; n < N; ++n) {
+        window[n] = static_cast<float>(0.5 - 0.5 * detail::cosConstexpr(2 * detail::kPi * static_cast<double>(n) /
+                                                                         static_cast<double>(N)));
+    }
+    return window;
+}
+
+template <std::size_t N>
+class RealFft {
+    static_assert(N >= 4 && (N & (N - 1)) == 0, "N must be a power of two, 4 or more");
+    static_assert(N / 2 <= 0x10000, "bit-reversal indices are 16-bit");
+
+public:
+    static constexpr std::size_t kSize = N;
+    static constexpr std::size_t kHalf = N / 2;
+
+    // Spectrum of the N real samples in data, viewed as floats (see samples()), in packed form
+    static void transform(std::span<std::complex<float>, kHalf> data) {
+        permute(data);
+        butterflies(data);
+        split(data);
+    }
+
+    // The N real samples of data, what transform() reads. complex<float> is allowed to be accessed as float[2]
+    static std::span<float, N> samples(std::span<std::complex<float>, kHalf> data) {
+        return std::span<float, N>(reinterpret_cast<float*>(data.data()), N);
+    }
+
+private:
+    // W_N^k = exp(-2 pi i k / N), k < N/2. the complex FFT of size N/2 uses every other entry
+    static constexpr std::array<std::complex<float>, kHalf> makeTwiddles() {
+        std::array<std::complex<float>, kHalf> twiddles{};
+        for (std::size_t k = 0; k < kHalf; ++k) {
+            const double angle = -2 * detail::kPi * static_cast<double>(k) / static_cast<double>(N);
+            twiddles[k] = {static_cast<float>(detail::cosConstexpr(angle)),
+                           static_cast<float>(detail::sinConstexpr(angle))};
+        }
+        return twiddles;
+    }
+
+    static constexpr std::array<std::uint16_t, kHalf> makeBitReversal() {
+        std::array<std::uint16_t, kHalf> reversed{};
+        std::size_t bits = 0;
+        while ((std::size_t{1} << bits) < kHalf) {
+            ++bits;
+        }
+        for (std::size_t i = 0; i < kHalf; ++i) {
+            std::size_t r = 0;
+            for (std::size_t b = 0; b < bits; ++b) {
+                r |= ((i >> b) & 1) << (bits - 1 - b);
+            }
+            reversed[i] = static_cast<std::uint16_t>(r);
+        }
+        return reversed;
+    }
+
+    static constexpr std::array<std::complex<float>, kHalf> kTwiddles = makeTwiddles();
+    static constexpr std::array<std::uint16_t, kHalf> kBitReversal = makeBitReversal();
+
+    static void permute(std::span<std::complex<float>, kHalf> data) {
+        for (std::size_t i = 0; i < kHalf; ++i) {
+            const std::size_t r = kBitReversal[i];
+            if (i < r) {
+                std::swap(data[i], data[r]);
+            }
+        }
+    }
+
+    // Iterative radix-2 decimation in time over the N/2 complex values
+    static void butterflies(std::span<std::complex<float>, kHalf> data) {
+        for (std::size_t length = 2; length <= kHalf; length <<= 1) {
+            const std::size_t half = length / 2;
+            const std::size_t stride = N / length; // W_length^j = W_N^(j * N / length)
+            for (std::size_t start = 0; start < kHalf; start += length) {
+                for (std::size_t j = 0; j < half; ++j) {
+                    const std::complex<float> u = data[start + j];
+                    const std::complex<float> v = detail::multiply(data[start + j + half], kTwiddles[j * stride]);
+                    data[start + j] = u + v;
+                    data[start + j + half] = u - v;
+                }
+            }
+        }
+    }
+
+    // Z = FFT(x[2n] + i x[2n+1]) to X = FFT(x): X[k] = E[k] + W_N^k O[k] with E[k] = (Z[k] + conj(Z[N/2-k])) / 2 and
+    // O[k] = -i (Z[k] - conj(Z[N/2-k])) / 2, computed for k and N/2 - k together so it can run in place
+    static void split(std::span<std::complex<float>, kHalf> data) {
+        const std::complex<float> z0 = data[0];
+        data[0] = {z0.real() + z0.imag(), z0.real() - z0.imag()};
+        for (std::size_t k = 1; k <= kHalf / 2; ++k) {
+            const std::complex<float> zk = data[k];
+            const std::complex<float> zm = data[kHalf - k];
+            data[k] = bin(zk, zm, k);
+            data[kHalf - k] = bin(zm, zk, kHalf - k);
+        }
+    }
+
+    static std::complex<float> bin(std::complex<float> zk, std::complex<float> zm, std::size_t k) {
+        const float evenRe = 0.5f * (zk.real() + zm.real());
+        const float evenIm = 0.5f * (zk.imag() - zm.imag());
+        const float oddRe = 0.5f * (zk.imag() + zm.imag());
+        const float oddIm = -0.5f * (zk.real() - zm.real());
+        const std::complex<float> odd = detail::multiply({oddRe, oddIm}, kTwiddles[k]);
+        return {evenRe + odd.real(), evenIm + odd.imag()};
+    }
+};
+
+} // namespace dsp
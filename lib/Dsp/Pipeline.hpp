@@ -0,0 +1,96 @@
+/**
+ * @file Pipeline.hpp
+ * @brief a chain of processing stages fixed at compile time, the recipe a sensor runs on each raw sample between its
+ * sensorRead() and the SensorDataPublisher. the stages are held by value in a tuple and called in order, each one fed
+ * the output of the one before, so the whole chain inlines into one function: no virtual calls, no heap, and the
+ * state of every stage sits inside the sensor that owns the pipeline.
+ *
+ * a stage is any class with process(sample) returning the next sample (any type) and reset(), see Stages.hpp.
+ *
+ *   dsp::Pipeline recipe{dsp::Biquad<float>(dsp::lowPassBiquad(1000, 50)), dsp::Rms<float, 100>{},
+ *                        dsp::MinMax<float>{}, dsp::Threshold<float>(0.8f, 0.6f)};
+ *   bool alarm = recipe.process(sample);
+ *   float peakRms = recipe.stage<2>().max();
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <utility>
+
+namespace dsp {
+
+template <typename Stage, typename In>
+concept PipelineStage = requires(Stage stage, In sample) {
+    stage.process(sample);
+    stage.reset();
+};
+
+template <typename... Stages>
+class Pipeline {
+    static_assert(sizeof...(Stages) > 0, "a Pipeline needs stages");
+
+public:
+    Pipeline() = default;
+
+    explicit Pipeline(Stages... each) : stages(std::move(each)...) {
+    }
+
+    // Run one sample through every stage, returns what the last stage returns
+    template <typename In>
+    auto process(In sample) {
+        return run<0>(sample);
+    }
+
+    // Run a block through the chain sample by sample, returns the samples written, the smaller of the two sizes
+    template <typename In, typename Out>
+    std::size_t process(std::span<const In> in, std::span<Out> out) {
+        const std::size_t count = std::min(in.size(), out.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = run<0>(in[i]);
+        }
+        return count;
+    }
+
+    // Stage I, e.g. to read MinMax or Threshold counters or to retune a stage
+    template <std::size_t I>
+    auto& stage() {
+        return std::get<I>(stages);
+    }
+
+    template <std::size_t I>
+    const auto& stage() const {
+        return std::get<I>(stages);
+    }
+
+    static constexpr std::size_t size() {
+        return sizeof...(Stages);
+    }
+
+    // Clear the state of every stage, e.g. after a gap in the stream
+    void reset() {
+        std::apply([](Stages&... each) { (each.reset(), ...); }, stages);
+    }
+
+private:
+    template <std::size_t I, typename In>
+    auto run(In sample) {
+        if constexpr (I == sizeof...(Stages)) {
+            return sample;
+        } else {
+            static_assert(PipelineStage<std::tuple_element_t<I, std::tuple<Stages...>>, In>,
+                          "stage I cannot take the output of stage I - 1");
+            return run<I + 1>(std::get<I>(stages).process(sample));
+        }
+    }
+
+    std::tuple<Stages...> stages;
+};
+
+template <typename... Stages>
+Pipeline(Stages...) -> Pipeline<Stages...>;
+
+} // namespace dsp
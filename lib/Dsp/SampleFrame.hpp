@@ -0,0 +1,103 @@
+/**
+ * @file SampleFrame.hpp
+ * @brief fixed-size block of multi-channel samples stored channel-major (structure of arrays): every channel is one
+ * contiguous, aligned row, so per-channel kernels (decimation, filters, features) walk plain arrays the compiler can
+ * vectorize instead of striding through interleaved samples.
+ *
+ * drivers (ADC scan, I2S, accelerometer FIFOs) deliver samples interleaved, ch0 ch1 ch2 ch0 ch1 ch2 ...;
+ * deinterleave() sorts them into the rows once, interleave() goes back for drivers or formats that want it.
+ *
+ * usage:
+ *   SampleFrame<std::int16_t, 3, 256> frame;          // 3-axis accelerometer, 256 samples per axis
+ *   frame.deinterleave(fifo, TimeService::now());      // fifo holds 768 int16_t, x y z x y z ...
+ *   dsp::decimateAverage<4>(frame.channel(0), out);    // 64 samples of x
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#ifndef DSP_ALIGNMENT
+#ifdef PLATFORM_ESP32
+#define DSP_ALIGNMENT 16 // What esp-dsp kernels expect
+#else
+#define DSP_ALIGNMENT 64 // One cache line, a full AVX-512 vector
+#endif
+#endif
+
+template <typename T, std::size_t Channels, std::size_t Samples>
+class SampleFrame {
+    static_assert(Channels > 0 && Samples > 0, "a frame holds at least one sample of one channel");
+    static_assert(DSP_ALIGNMENT % sizeof(T) == 0, "rows are padded to DSP_ALIGNMENT in whole samples");
+
+public:
+    static constexpr std::size_t kChannels = Channels;
+    static constexpr std::size_t kSamples = Samples;
+    // Row length in samples, padded so every row starts aligned
+    static constexpr std::size_t kStride =
+        (Samples + DSP_ALIGNMENT / sizeof(T) - 1) / (DSP_ALIGNMENT / sizeof(T)) * (DSP_ALIGNMENT / sizeof(T));
+
+    std::span<T, Samples> channel(std::size_t index) {
+        return std::span<T, Samples>(rows.data() + index * kStride, Samples);
+    }
+
+    std::span<const T, Samples> channel(std::size_t index) const {
+        return std::span<const T, Samples>(rows.data() + index * kStride, Samples);
+    }
+
+    // Fill from interleaved samples, at most Samples per channel. returns the samples taken per channel, a trailing
+    // partial set of channels is ignored
+    std::size_t deinterleave(std::span<const T> interleaved, std::uint64_t firstTicks = 0) {
+        const std::size_t count = std::min(interleaved.size() / Channels, Samples);
+        for (std::size_t c = 0; c < Channels; ++c) {
+            T* row = rows.data() + c * kStride;
+            const T* source = interleaved.data() + c;
+            for (std::size_t i = 0; i < count; ++i) {
+                row[i] = source[i * Channels];
+            }
+        }
+        valid = count;
+        firstSampleTicks = firstTicks;
+        return count;
+    }
+
+    // Write the valid samples back interleaved, returns the number of values written
+    std::size_t interleave(std::span<T> out) const {
+        const std::size_t count = std::min(out.size() / Channels, valid);
+        for (std::size_t c = 0; c < Channels; ++c) {
+            const T* row = rows.data() + c * kStride;
+            T* target = out.data() + c;
+            for (std::size_t i = 0; i < count; ++i) {
+                target[i * Channels] = row[i];
+            }
+        }
+        return count * Channels;
+    }
+
+    // Samples per channel filled by the last deinterleave() or set by a kernel writing the rows directly
+    std::size_t size() const {
+        return valid;
+    }
+
+    void setSize(std::size_t samples) {
+        valid = std::min(samples, Samples);
+    }
+
+    // Monotonic ticks (TimeService::now()) of the first sample
+    std::uint64_t getFirstSampleTicks() const {
+        return firstSampleTicks;
+    }
+
+    void setFirstSampleTicks(std::uint64_t ticks) {
+        firstSampleTicks = ticks;
+    }
+
+private:
+    alignas(DSP_ALIGNMENT) std::array<T, Channels * kStride> rows{};
+    std::size_t valid{0};
+    std::uint64_t firstSampleTicks{0};
+};
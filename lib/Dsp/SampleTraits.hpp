@@ -0,0 +1,79 @@
+/**
+ * @file SampleTraits.hpp
+ * @brief arithmetic of the two sample types the dsp kernels support: float, and int16_t as Q15 fixed point (value / 32768)
+ * for parts or paths where float is too slow or too big. kernels are written once against these traits.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp {
+
+template <typename T>
+struct SampleTraits;
+
+template <>
+struct SampleTraits<float> {
+    using Accumulator = float;
+    using Wide = float; // Sums of squares
+    using Coefficient = float;
+
+    static float fromSum(float sum, std::size_t count) {
+        return sum / static_cast<float>(count);
+    }
+
+    static float fromProducts(float sum) {
+        return sum;
+    }
+
+    static float saturate(float value) {
+        return value;
+    }
+
+    static float rootMeanSquare(float sumOfSquares, std::size_t count) {
+        return std::sqrt(std::max(sumOfSquares, 0.0f) / static_cast<float>(count));
+    }
+};
+
+template <>
+struct SampleTraits<std::int16_t> {
+    using Accumulator = std::int32_t;
+    using Wide = std::int64_t;
+    using Coefficient = std::int16_t; // Q15
+
+    static std::int16_t fromSum(std::int32_t sum, std::size_t count) {
+        return static_cast<std::int16_t>(sum / static_cast<std::int32_t>(count));
+    }
+
+    static std::int16_t fromProducts(std::int32_t sum) {
+        return saturate((sum + (1 << 14)) >> 15);
+    }
+
+    static std::int16_t saturate(std::int32_t value) {
+        return static_cast<std::int16_t>(std::clamp<std::int32_t>(value, INT16_MIN, INT16_MAX));
+    }
+
+    static std::int16_t rootMeanSquare(std::int64_t sumOfSquares, std::size_t count) {
+        // float is exact enough for a 16-bit result and has hardware support on the ESP32, double does not
+        return saturate(static_cast<std::int32_t>(
+            std::lround(std::sqrt(static_cast<float>(sumOfSquares) / static_cast<float>(count)))));
+    }
+};
+
+// Q15 coefficient from a design value in [-1, 1), saturated
+constexpr std::int16_t toQ15(float value) {
+    const float scaled = value * 32768.0f;
+    if (scaled >= 32767.0f) {
+        return 32767;
+    }
+    if (scaled <= -32768.0f) {
+        return -32768;
+    }
+    return static_cast<std::int16_t>(scaled + (scaled >= 0 ? 0.5f : -0.5f));
+}
+
+} // namespace dsp
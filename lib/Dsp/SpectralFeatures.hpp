@@ -0,0 +1,258 @@
+/**
+ * @file SpectralFeatures.hpp
+ * @brief spectral feature stage for vibration sensors: collects windows of N samples, runs a Hann-windowed RealFft on
+ * each and keeps a handful of numbers per window instead of the waveform: energy per frequency band, the strongest
+ * peaks (frequency and amplitude), RMS and crest factor. a window of 4096 samples (16 KB as float, about 30 KB as
+ * JSON text) becomes 8 band energies, 3 peaks, RMS and crest factor: 64 bytes, or about 150 bytes of JSON.
+ *
+ * as the last stage of a Pipeline, process(sample) returns true once a window is complete, the sensor then
+ * publishes features().writeJson(). processWindow() takes a whole block, e.g. a SampleFrame channel.
+ *
+ *   dsp::SpectralFeatureExtractor<2048, 4> vibration(3200.0f, {0.0f, 10.0f, 100.0f, 500.0f, 1600.0f});
+ *   if (vibration.process(sample)) {
+ *       vibration.features().writeJson(payload, sizeof(payload));
+ *   }
+ *
+ * the mean of each window is removed first (accelerometers carry gravity), so band energies are mean squares that add
+ * up to the variance of the window (Parseval, corrected for the window), and RMS and crest factor describe the
+ * vibration only. windows do not overlap.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include "Fft.hpp"
+
+#ifndef SPECTRAL_PEAK_FLOOR
+#define SPECTRAL_PEAK_FLOOR 0.01f // Peaks below this fraction of the strongest amplitude are leakage or noise
+#endif
+
+namespace dsp {
+
+template <std::size_t Bands, std::size_t Peaks>
+struct SpectralFeatures {
+    std::array<float, Bands> bandEnergy{}; // Mean square in [edge b, edge b+1) Hz
+    std::array<float, Peaks> peakHz{};     // Strongest spectral peaks first, 0 where the window has fewer
+    std::array<float, Peaks> peakAmplitude{};
+    float rms{0.0f};
+    float crestFactor{0.0f}; // Largest |sample| / rms, about 1.41 for a sine, higher for impacts
+    std::uint32_t window{0}; // Windows completed, this one included
+
+    // Compact record, e.g. {"w":12,"rms":0.71,"crest":1.41,"bands":[0.5,0.002],"peaks":[[50.0,1.0]]}. returns the
+    // length of the full record like snprintf, out holds at most size - 1 characters of it
+    std::size_t writeJson(char* out, std::size_t size) const {
+        std::size_t length = 0;
+        auto put = [&](const char* format, auto... args) {
+            const std::size_t room = length < size ? size - length : 0;
+            const int written = std::snprintf(room > 0 ? out + length : nullptr, room, format, args...);
+            length += written > 0 ? static_cast<std::size_t>(written) : 0;
+        };
+        put("{\"w\":%lu,\"rms\":%.4g,\"crest\":%.3g,\"bands\":[", static_cast<unsigned long>(window),
+            static_cast<double>(rms), static_cast<double>(crestFactor));
+        for (std::size_t b = 0; b < Bands; ++b) {
+            put("%s%.4g", b == 0 ? "" : ",", static_cast<double>(bandEnergy[b]));
+        }
+        put("],\"peaks\":[");
+        for (std::size_t p = 0; p < Peaks && peakHz[p] > 0.0f; ++p) {
+            put("%s[%.1f,%.4g]", p == 0 ? "" : ",", static_cast<double>(peakHz[p]),
+                static_cast<double>(peakAmplitude[p]));
+        }
+        put("]}");
+        return length;
+    }
+};
+
+template <std::size_t N, std::size_t Bands, std::size_t Peaks = 3>
+class SpectralFeatureExtractor {
+    static_assert(Bands > 0, "a SpectralFeatureExtractor needs bands");
+
+public:
+    using Fft = RealFft<N>;
+    using Features = SpectralFeatures<Bands, Peaks>;
+    static constexpr std::size_t kBins = N / 2 + 1;
+
+    // Bands between the given edges in Hz, ascending, a bin belongs to the band its centre frequency falls in
+    SpectralFeatureExtractor(float sampleRateHz, const std::array<float, Bands + 1>& edgesHz)
+        : binHz(sampleRateHz / static_cast<float>(N)),
+          // sqrt(power) = |X| sqrt(kPowerScale), and a sine centred on a bin has |X| = amplitude * windowSum / 2
+          rootPowerToAmplitude(static_cast<float>(2.0 / windowSum()) / std::sqrt(kPowerScale)) {
+        for (std::size_t b = 0; b <= Bands; ++b) {
+            const float bin = std::ceil(edgesHz[b] / binHz);
+            firstBin[b] = static_cast<std::uint16_t>(std::clamp(bin, 0.0f, static_cast<float>(kBins)));
+        }
+    }
+
+    // Bands of equal width from 0 Hz to Nyquist
+    explicit SpectralFeatureExtractor(float sampleRateHz)
+        : SpectralFeatureExtractor(sampleRateHz, evenEdges(sampleRateHz)) {
+    }
+
+    // Add one sample, true when it completed a window and features() changed
+    bool process(float sample) {
+        Fft::samples(buffer)[filled] = sample;
+        if (++filled < N) {
+            return false;
+        }
+        filled = 0;
+        analyze();
+        return true;
+    }
+
+    // Analyze one whole window, independent of samples collected by process()
+    const Features& processWindow(std::span<const float, N> window) {
+        std::copy(window.begin(), window.end(), Fft::samples(buffer).begin());
+        analyze();
+        return latest;
+    }
+
+    const Features& features() const {
+        return latest;
+    }
+
+    float binWidthHz() const {
+        return binHz;
+    }
+
+    // Drop a partial window and the window count
+    void reset() {
+        filled = 0;
+        latest = {};
+    }
+
+private:
+    static constexpr std::array<float, N> kWindow = hannWindow<N>();
+
+    static constexpr double windowSum() {
+        double sum = 0;
+        for (float w : kWindow) {
+            sum += w;
+        }
+        return sum;
+    }
+
+    static constexpr double windowPower() {
+        double sum = 0;
+        for (float w : kWindow) {
+            sum += static_cast<double>(w) * w;
+        }
+        return sum;
+    }
+
+    // |X[k]|^2 to the mean square it stands for, bins 0 < k < N/2 also count their negative frequency
+    static constexpr float kPowerScale = static_cast<float>(2.0 / (static_cast<double>(N) * windowPower()));
+
+    static std::array<float, Bands + 1> evenEdges(float sampleRateHz) {
+        std::array<float, Bands + 1> edges{};
+        for (std::size_t b = 0; b <= Bands; ++b) {
+            edges[b] = sampleRateHz / 2 * static_cast<float>(b) / static_cast<float>(Bands);
+        }
+        edges[Bands] = sampleRateHz; // Nyquist bin included
+        return edges;
+    }
+
+    void analyze() {
+        std::span<float, N> x = Fft::samples(buffer);
+        float mean = 0.0f;
+        for (float value : x) {
+            mean += value;
+        }
+        mean /= static_cast<float>(N);
+
+        float sumOfSquares = 0.0f;
+        float largest = 0.0f;
+        for (std::size_t n = 0; n < N; ++n) {
+            const float centred = x[n] - mean;
+            sumOfSquares += centred * centred;
+            largest = std::max(largest, std::fabs(centred));
+            x[n] = centred * kWindow[n];
+        }
+        latest.rms = std::sqrt(sumOfSquares / static_cast<float>(N));
+        latest.crestFactor = latest.rms > 0.0f ? largest / latest.rms : 0.0f;
+
+        Fft::transform(buffer);
+        powerSpectrum();
+        bandEnergies();
+        findPeaks();
+        ++latest.window;
+    }
+
+    // Power of bin k into x[k], in place: bin k is read from floats 2k and 2k + 1, never behind a write
+    void powerSpectrum() {
+        std::span<float, N> power = Fft::samples(buffer);
+        const float dc = buffer[0].real();
+        const float nyquist = buffer[0].imag();
+        power[0] = dc * dc * kPowerScale / 2;
+        for (std::size_t k = 1; k < N / 2; ++k) {
+            power[k] = std::norm(buffer[k]) * kPowerScale;
+        }
+        power[N / 2] = nyquist * nyquist * kPowerScale / 2;
+    }
+
+    void bandEnergies() {
+        const std::span<float, N> power = Fft::samples(buffer);
+        for (std::size_t b = 0; b < Bands; ++b) {
+            float energy = 0.0f;
+            for (std::size_t k = firstBin[b]; k < firstBin[b + 1]; ++k) {
+                energy += power[k];
+            }
+            latest.bandEnergy[b] = energy;
+        }
+    }
+
+    // Largest local maxima of the power spectrum, refined between bins by a parabola through the magnitudes
+    void findPeaks() {
+        const std::span<float, N> power = Fft::samples(buffer);
+        std::array<std::size_t, Peaks> bins{};
+        std::size_t found = 0;
+        for (std::size_t k = 2; k < N / 2 - 1; ++k) {
+            if (power[k] <= power[k - 1] || power[k] < power[k + 1]) {
+                continue;
+            }
+            // Insert into the strongest-first list
+            std::size_t at = std::min(found, Peaks);
+            while (at > 0 && power[bins[at - 1]] < power[k]) {
+                if (at < Peaks) {
+                    bins[at] = bins[at - 1];
+                }
+                --at;
+            }
+            if (at < Peaks) {
+                bins[at] = k;
+                found = std::min(found + 1, Peaks);
+            }
+        }
+
+        const float floor = found > 0 ? power[bins[0]] * SPECTRAL_PEAK_FLOOR * SPECTRAL_PEAK_FLOOR : 0.0f;
+        for (std::size_t p = 0; p < Peaks; ++p) {
+            if (p >= found || power[bins[p]] < floor) {
+                latest.peakHz[p] = 0.0f;
+                latest.peakAmplitude[p] = 0.0f;
+                continue;
+            }
+            const std::size_t k = bins[p];
+            const float before = std::sqrt(power[k - 1]);
+            const float centre = std::sqrt(power[k]);
+            const float after = std::sqrt(power[k + 1]);
+            const float curvature = before - 2 * centre + after;
+            const float offset = curvature < 0.0f ? 0.5f * (before - after) / curvature : 0.0f;
+            latest.peakHz[p] = (static_cast<float>(k) + offset) * binHz;
+            latest.peakAmplitude[p] = (centre - 0.25f * (before - after) * offset) * rootPowerToAmplitude;
+        }
+    }
+
+    std::array<std::complex<float>, N / 2> buffer{};
+    std::array<std::uint16_t, Bands + 1> firstBin{};
+    float binHz;
+    float rootPowerToAmplitude;
+    std::size_t filled{0};
+    Features latest{};
+};
+
+} // namespace dsp
@@ -0,0 +1,273 @@
+/**
+ * @file Stages.hpp
+ * @brief per-sample processing stages for a Pipeline: MovingAverage, Fir, Biquad, Rms, MinMax and Threshold. every
+ * stage is a plain class with process(sample) and reset(), holds its state inline (no heap) and exists for float and
+ * for int16_t Q15 samples (see SampleTraits.hpp).
+ *
+ * fixed point: Fir taps are Q15, Biquad coefficients Q14 (|a1| reaches 2 for low cut-offs), sums are taken in
+ * int32_t/int64_t and results rounded and saturated to int16_t.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "SampleTraits.hpp"
+
+namespace dsp {
+
+// Mean of the last N samples, O(1) per sample from a running sum
+template <typename T, std::size_t N>
+class MovingAverage {
+    static_assert(N > 0, "MovingAverage needs a window");
+
+public:
+    T process(T sample) {
+        sum += static_cast<Accumulator>(sample) - static_cast<Accumulator>(window[head]);
+        window[head] = sample;
+        if (++head == N) {
+            head = 0;
+            if constexpr (std::is_floating_point_v<T>) {
+                // Float sums drift as samples come and go, rebuild once per window
+                sum = Accumulator{};
+                for (T value : window) {
+                    sum += value;
+                }
+            }
+        }
+        return SampleTraits<T>::fromSum(sum, N);
+    }
+
+    void reset() {
+        window.fill(T{});
+        sum = Accumulator{};
+        head = 0;
+    }
+
+private:
+    using Accumulator = typename SampleTraits<T>::Accumulator;
+
+    std::array<T, N> window{};
+    Accumulator sum{};
+    std::size_t head{0};
+};
+
+// Direct-form FIR, y[n] = sum over k of taps[k] * x[n - k]. the history is kept twice so the dot product reads one
+// contiguous stretch instead of wrapping around
+template <typename T, std::size_t Taps>
+class Fir {
+    static_assert(Taps > 0, "Fir needs taps");
+
+public:
+    using Coefficient = typename SampleTraits<T>::Coefficient;
+
+    explicit Fir(const std::array<Coefficient, Taps>& taps) {
+        // Reversed, so newest sample meets taps[0] walking forward through history
+        std::reverse_copy(taps.begin(), taps.end(), reversed.begin());
+    }
+
+    T process(T sample) {
+        history[head] = sample;
+        history[head + Taps] = sample;
+        head = head + 1 == Taps ? 0 : head + 1;
+        // history[head .. head + Taps) now runs oldest to newest
+        typename SampleTraits<T>::Accumulator sum{};
+        const T* x = history.data() + head;
+        for (std::size_t k = 0; k < Taps; ++k) {
+            sum += static_cast<typename SampleTraits<T>::Accumulator>(reversed[k]) * x[k];
+        }
+        return SampleTraits<T>::fromProducts(sum);
+    }
+
+    void reset() {
+        history.fill(T{});
+        head = 0;
+    }
+
+private:
+    std::array<Coefficient, Taps> reversed{};
+    std::array<T, 2 * Taps> history{};
+    std::size_t head{0};
+};
+
+// Normalized (a0 = 1) second-order section, y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2
+template <typename C>
+struct BiquadCoefficients {
+    C b0, b1, b2, a1, a2;
+};
+
+// Low-pass from the audio EQ cookbook (q = 0.7071 for Butterworth)
+inline BiquadCoefficients<float> lowPassBiquad(float sampleRate, float cutoff, float q = 0.70710678f) {
+    const float w0 = 2.0f * 3.14159265f * cutoff / sampleRate;
+    const float alpha = std::sin(w0) / (2.0f * q);
+    const float cosw0 = std::cos(w0);
+    const float a0 = 1.0f + alpha;
+    return {(1.0f - cosw0) / 2.0f / a0, (1.0f - cosw0) / a0, (1.0f - cosw0) / 2.0f / a0, -2.0f * cosw0 / a0,
+            (1.0f - alpha) / a0};
+}
+
+// Q14 coefficients for Biquad<int16_t>, each must lie in [-2, 2)
+constexpr BiquadCoefficients<std::int16_t> toQ14(const BiquadCoefficients<float>& c) {
+    auto q14 = [](float value) { return toQ15(value / 2.0f); };
+    return {q14(c.b0), q14(c.b1), q14(c.b2), q14(c.a1), q14(c.a2)};
+}
+
+template <typename T>
+class Biquad;
+
+// Transposed direct form II, two state values
+template <>
+class Biquad<float> {
+public:
+    explicit Biquad(const BiquadCoefficients<float>& c) : c(c) {
+    }
+
+    float process(float x) {
+        const float y = c.b0 * x + s1;
+        s1 = c.b1 * x - c.a1 * y + s2;
+        s2 = c.b2 * x - c.a2 * y;
+        return y;
+    }
+
+    void reset() {
+        s1 = s2 = 0.0f;
+    }
+
+private:
+    BiquadCoefficients<float> c;
+    float s1{0.0f};
+    float s2{0.0f};
+};
+
+// Direct form I, the robust form in fixed point: the state is the saturated input and output samples themselves
+template <>
+class Biquad<std::int16_t> {
+public:
+    explicit Biquad(const BiquadCoefficients<std::int16_t>& c) : c(c) {
+    }
+
+    std::int16_t process(std::int16_t x) {
+        const std::int64_t sum = std::int64_t{c.b0} * x + std::int64_t{c.b1} * x1 + std::int64_t{c.b2} * x2 -
+                                 std::int64_t{c.a1} * y1 - std::int64_t{c.a2} * y2;
+        const auto y = static_cast<std::int16_t>(
+            std::clamp<std::int64_t>((sum + (1 << 13)) >> 14, INT16_MIN, INT16_MAX));
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        return y;
+    }
+
+    void reset() {
+        x1 = x2 = y1 = y2 = 0;
+    }
+
+private:
+    BiquadCoefficients<std::int16_t> c; // Q14
+    std::int16_t x1{0}, x2{0}, y1{0}, y2{0};
+};
+
+// Root mean square of the last N samples, O(1) per sample from a running sum of squares
+template <typename T, std::size_t N>
+class Rms {
+    static_assert(N > 0, "Rms needs a window");
+
+public:
+    T process(T sample) {
+        const Wide square = static_cast<Wide>(sample) * static_cast<Wide>(sample);
+        sumOfSquares += square - squares[head];
+        squares[head] = square;
+        if (++head == N) {
+            head = 0;
+            if constexpr (std::is_floating_point_v<T>) {
+                sumOfSquares = Wide{};
+                for (Wide value : squares) {
+                    sumOfSquares += value;
+                }
+            }
+        }
+        return SampleTraits<T>::rootMeanSquare(sumOfSquares, N);
+    }
+
+    void reset() {
+        squares.fill(Wide{});
+        sumOfSquares = Wide{};
+        head = 0;
+    }
+
+private:
+    using Wide = typename SampleTraits<T>::Wide;
+
+    std::array<Wide, N> squares{};
+    Wide sumOfSquares{};
+    std::size_t head{0};
+};
+
+// Passes samples through and keeps the range seen since the last reset, read it with Pipeline::stage<I>()
+template <typename T>
+class MinMax {
+public:
+    T process(T sample) {
+        lowest = std::min(lowest, sample);
+        highest = std::max(highest, sample);
+        return sample;
+    }
+
+    void reset() {
+        lowest = std::numeric_limits<T>::max();
+        highest = std::numeric_limits<T>::lowest();
+    }
+
+    T min() const {
+        return lowest;
+    }
+
+    T max() const {
+        return highest;
+    }
+
+private:
+    T lowest{std::numeric_limits<T>::max()};
+    T highest{std::numeric_limits<T>::lowest()};
+};
+
+// true from the first sample at or above high until one at or below low, the gap keeps noise from toggling it
+template <typename T>
+class Threshold {
+public:
+    Threshold(T high, T low) : high(high), low(low) {
+    }
+
+    bool process(T sample) {
+        if (!active && sample >= high) {
+            active = true;
+            ++rises;
+        } else if (active && sample <= low) {
+            active = false;
+        }
+        return active;
+    }
+
+    void reset() {
+        active = false;
+        rises = 0;
+    }
+
+    // Times the threshold was crossed upwards since the last reset
+    std::uint32_t crossings() const {
+        return rises;
+    }
+
+private:
+    T high;
+    T low;
+    bool active{false};
+    std::uint32_t rises{0};
+};
+
+} // namespace dsp
@@ -6,10 +6,13 @@
 #include <mutex>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <driver/gpio.h> // ESP-IDF GPIO driver
 #include <esp_log.h> // ESP-IDF Log driver
-#include <EventLogger.hpp> // ESP-IDF Log driver
+#include <EventBus.hpp>
+#include <WifiManager.hpp>
+#include <MqttManager.hpp>
 
 constexpr const char* LED_TAG = "LedManager";
 
@@ -60,10 +63,11 @@ public:
 
 private:
     LedManager() {
-        // Register a callback with EventLogger
-        EventLogger::getInstance().registerCallback(
-            [this](const std::string& id, const std::string& state) {
-                processLog(id, state);
+        // Subscribe to the components shown on the LEDs, delivered on the event bus dispatcher task
+        subscription = EventBus::getInstance().subscribe(
+            EventFilter::any().components(componentId_t::WifiManager, componentId_t::MqttManager, componentId_t::Error),
+            [this](const Event& event) {
+                processEvent(event);
             }
         );
 
@@ -72,6 +76,7 @@ private:
     }
 
     ~LedManager() {
+        EventBus::getInstance().unsubscribe(subscription);
         running = false;
         if (blinkingThread.joinable()) {
             blinkingThread.join();
@@ -90,6 +95,7 @@ private:
     std::thread blinkingThread;
     std::mutex mtx;
     std::atomic<bool> running{true};
+    EventBus::SubscriptionId subscription{EventBus::kInvalidSubscription};
 
     // LED modes (off, on, blink)
     std::unordered_map<LEDColor, LEDMode> ledModes = {
@@ -105,24 +111,18 @@ private:
         {LEDColor::BLUE, 1000}
     };
 
-    // Process a log entry and update LED modes
-    void processLog(const std::string& id, const std::string& state) {
-        std::lock_guard<std::mutex> lock(mtx);
-
-        // Define LED behavior based on id and state
-        if (id == "WifiManager") {
-            if (state == "CONNECTED") {
-                setLEDMode(LEDColor::GREEN, LEDMode::BLINK, 500); // Blink green LED every 500ms
-            } else if (state == "DISCONNECTED") {
-                setLEDMode(LEDColor::GREEN, LEDMode::OFF);
-            }
-        } else if (id == "MqttManager") {
-            if (state == "CONNECTED") {
-                setLEDMode(LEDColor::BLUE, LEDMode::BLINK, 1000); // Blink blue LED every 1000ms
-            } else if (state == "DISCONNECTED") {
-                setLEDMode(LEDColor::BLUE, LEDMode::OFF);
-            }
-        } else if (id == "Error") {
+    // Process a component event and update LED modes, setLEDMode takes mtx itself
+    void processEvent(const Event& event) {
+        // Define LED behavior based on component and state, plain integer compares
+        if (event.is(componentId_t::WifiManager, wifiState_t::CONNECTED)) {
+            setLEDMode(LEDColor::GREEN, LEDMode::BLINK, 500); // Blink green LED every 500ms
+        } else if (event.is(componentId_t::WifiManager, wifiState_t::DISCONNECTED)) {
+            setLEDMode(LEDColor::GREEN, LEDMode::OFF);
+        } else if (event.is(componentId_t::MqttManager, mqttState_t::CONNECTED)) {
+            setLEDMode(LEDColor::BLUE, LEDMode::BLINK, 1000); // Blink blue LED every 1000ms
+        } else if (event.is(componentId_t::MqttManager, mqttState_t::DISCONNECTED)) {
+            setLEDMode(LEDColor::BLUE, LEDMode::OFF);
+        } else if (event.component == componentId_t::Error || event.type == eventType_t::FAULT) {
             setLEDMode(LEDColor::RED, LEDMode::BLINK, 200); // Blink red LED rapidly (200ms) for errors
         }
     }
@@ -1,95 +1,490 @@
+/**
+ * @file EventLogger.hpp
+ * @brief state change and event log with deferred formatting. callers only capture a binary LogRecord (timestamp,
+ * format literal, raw args) into a lock-free ring owned by their task; a low-priority drain task formats the records,
+ * writes them to the console and keeps the latest ones for printLatestLogs().
+ *
+ * every task that logs claims one of EVENT_LOGGER_PRODUCER_RINGS SpscRingBuffers on its first call and gives it back
+ * when it exits. only threads (std::thread, pthread) give it back by themselves: a task made with xTaskCreate and
+ * ended with vTaskDelete never runs thread_local destructors, so it must call releaseTaskRing() before it ends (e.g. an
+ * OTA task), or it keeps its ring for good. tasks beyond that, or a task whose ring is full, fall back to one shared MpmcQueue. if that is full
+ * too, the record is dropped and counted rather than blocking the caller.
+ *
+ * records carry TimeService ticks and are printed in UTC once the TimeService has been synced, including records
+ * captured before the sync.
+ *
+ * with a LogStore attached, the drain task also appends every record to the persistent segments and flushes them
+ * once logging has been idle for a second.
+ *
+ * component logs go through three filters before anything is captured: the level (levels above
+ * EVENT_LOGGER_LEVEL_FLOOR are compiled out, the rest checked against a per-component runtime level), a token bucket
+ * per component, and for state changes a flap detector that logs the first few transitions of a window and turns the
+ * rest into one "N changes in T ms" summary. everything held back is counted per component, see stats().
+ *
+ * usage:
+ *   EVENT_LOG(WARN, WifiManager, "rssi %d dBm", rssi); // "WifiManager: rssi -82 dBm"
+ *
+ */
+
 #pragma once
-#include <functional>
-#include <vector>
-#include <string>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <CircularBuffer.hpp>
+#include <ComponentId.hpp>
+#include <MpmcQueue.hpp>
+#include <SpscRingBuffer.hpp>
+#include <TimeService.hpp>
+#include "LogFilter.hpp"
+#include "LogRecord.hpp"
+#include "LogStore.hpp"
+#ifdef PLATFORM_ESP32
 #include <esp_log.h>
+#include <esp_pthread.h>
+#endif
 
-#define USE_CIRCULAR_BUFFER
-// #define USE_VECTOR
-
-#ifdef USE_CIRCULAR_BUFFER
 #define CIRCULAR_BUFFER_MAX_SIZE 30
-#include <CircularBuffer.hpp>
-#elif defined(USE_VECTOR)
-// include nothing
+#ifndef EVENT_LOGGER_PRODUCER_RINGS
+#define EVENT_LOGGER_PRODUCER_RINGS 4
+#endif
+#ifndef EVENT_LOGGER_RING_SIZE
+#define EVENT_LOGGER_RING_SIZE 16
+#endif
+#ifndef EVENT_LOGGER_RATE_PER_SECOND
+#define EVENT_LOGGER_RATE_PER_SECOND 10 // Per component, 0 disables rate limiting
 #endif
+#ifndef EVENT_LOGGER_RATE_BURST
+#define EVENT_LOGGER_RATE_BURST 20
+#endif
+#ifndef EVENT_LOGGER_FLAP_THRESHOLD
+#define EVENT_LOGGER_FLAP_THRESHOLD 3 // State changes logged per window before collapsing, 0 disables
+#endif
+#ifndef EVENT_LOGGER_FLAP_WINDOW_MS
+#define EVENT_LOGGER_FLAP_WINDOW_MS 2000
+#endif
+
+// Log with a level and the component name as prefix, e.g. EVENT_LOG(ERROR, SDCard, "failed to mount")
+#define EVENT_LOG(level, component, format, ...)                                                      \
+    EventLogger::getInstance().log<logLevel_t::level>(componentId_t::component, "%s: " format,         \
+                                                      componentId_t::component __VA_OPT__(, ) __VA_ARGS__)
 
 class EventLogger {
 public:
-    using LogCallback = std::function<void(const std::string& id, const std::string& state)>;
+    using LineSink = void (*)(const char* line);
+
+    // What the filters held back for one component
+    struct ComponentStats {
+        std::uint32_t levelFiltered;  // Below the component's runtime level
+        std::uint32_t rateLimited;    // Over the token bucket
+        std::uint32_t flapSuppressed; // State changes folded into a flap summary
+    };
 
     static EventLogger& getInstance() {
         static EventLogger instance; // Get the singleton instance
         return instance;
     }
-       
+
+    // Component and state stay integers until the record is printed or stored. logged at INFO
+    template <enum_names::Named State>
+    void logStateChange(componentId_t id, State state) {
+        if constexpr (log_filter::compiledIn<logLevel_t::INFO>()) {
+            ComponentControl& control = controlOf(id);
+            if (!levelEnabled(control, logLevel_t::INFO)) {
+                return;
+            }
+            std::uint64_t now = TimeService::now();
+            std::optional<FlapDetector::Summary> closed;
+            const bool individually = onTransition(control, control.flap, now, closed);
+            const log_record::NameRef previous = unpackName(control.lastState.exchange(
+                packName({enum_names::tableId<State>(), static_cast<std::uint16_t>(state)}), std::memory_order_relaxed));
+            if (closed) {
+                logFlapSummary(id, *closed, previous);
+            }
+            if (individually && withinRate(control, now)) {
+                log("%s -> %s", id, state);
+            }
+        }
+    }
+
+    // One instance of a component, e.g. one sensor of many, logged as "<name> -> <state>". filtered by the component's
+    // level, but flap-detected on the instance's own detector (which also bounds its rate), so instances neither hide
+    // each other's changes nor share one window. suppressions still count in the component's stats()
+    template <enum_names::Named State>
+    void logStateChange(componentId_t id, const char* name, State state, State previous, FlapDetector& flap) {
+        if constexpr (log_filter::compiledIn<logLevel_t::INFO>()) {
+            ComponentControl& control = controlOf(id);
+            if (!levelEnabled(control, logLevel_t::INFO)) {
+                return;
+            }
+            std::optional<FlapDetector::Summary> closed;
+            const bool individually = onTransition(control, flap, TimeService::now(), closed);
+            if (closed) {
+                logFlapSummary(name, *closed, previous);
+            }
+            if (individually) {
+                log("%s -> %s", name, state);
+            }
+        }
+    }
+
+    // Summarize an instance's flap window once it is over, the drain task only sees the components' windows
+    template <enum_names::Named State>
+    void expireFlapWindow(const char* name, FlapDetector& flap, State last) {
+        if (std::optional<FlapDetector::Summary> closed = flap.expire(TimeService::now())) {
+            logFlapSummary(name, *closed, last);
+        }
+    }
+
     void logStateChange(const std::string& id, const std::string& state) {
-        {
-            std::lock_guard<std::mutex> lock(mtx);
-            static char buffer[64];
-            snprintf(buffer, sizeof(buffer), "[%s] %s -> %s", getCurrentTimestamp().c_str(), id.c_str(), state.c_str());
-            ESP_LOGI(TAG, "%s", buffer);
-#ifdef USE_CIRCULAR_BUFFER
-            logs.push(std::string(buffer));
-        } // make mutex go out of bounds
-
-        if (logs.is_max()) {
-            printLatestLogs();
-        }
-#elif defined(USE_VECTOR)
-            logs.push_back(std::string(buffer));
-#endif
+        log("%s -> %s", id, state);
+    }
 
-        // // Notify observers, still error
-        // for (const auto& callback : callbacks) {
-        //     for (int i=0; i<callbacks.size(); i++) {
-        //         auto& callback = callbacks[i];
-        //         callback(id, state);
-        //     }
-        // }
+    // Record a printf-style message without formatting it. format must be a string literal
+    template <typename... Args>
+    void log(const char* format, const Args&... args) {
+        LogRecord record;
+        log_record::capture(record, TimeService::now(), format, args...);
+        enqueue(record);
     }
 
-    void registerCallback(const LogCallback& callback) {
+    // Filtered by level, rate and flap state of component. Level above EVENT_LOGGER_LEVEL_FLOOR compiles to nothing
+    template <logLevel_t Level, typename... Args>
+    void log(componentId_t component, const char* format, const Args&... args) {
+        if constexpr (log_filter::compiledIn<Level>()) {
+            ComponentControl& control = controlOf(component);
+            if (levelEnabled(control, Level) && withinRate(control, TimeService::now())) {
+                log(format, args...);
+            }
+        }
+    }
+
+    // Runtime level of one component, INFO by default. can't enable levels above EVENT_LOGGER_LEVEL_FLOOR
+    void setLevel(componentId_t component, logLevel_t level) {
+        controlOf(component).level.store(level, std::memory_order_relaxed);
+    }
+
+    logLevel_t getLevel(componentId_t component) {
+        return controlOf(component).level.load(std::memory_order_relaxed);
+    }
+
+    // ratePerSecond = 0 lifts the limit for the component
+    void setRateLimit(componentId_t component, std::uint32_t ratePerSecond, std::uint32_t burst) {
+        controlOf(component).bucket.configure(ratePerSecond, burst);
+    }
+
+    // threshold = 0 logs every state change of the component
+    void setFlapSuppression(componentId_t component, std::uint32_t threshold, std::uint32_t windowMs) {
+        controlOf(component).flap.configure(threshold, windowMs);
+    }
+
+    ComponentStats stats(componentId_t component) {
+        ComponentControl& control = controlOf(component);
+        return {control.levelFiltered.load(std::memory_order_relaxed), control.rateLimited.load(std::memory_order_relaxed),
+                control.flapSuppressed.load(std::memory_order_relaxed)};
+    }
+
+    // Format and output everything captured so far on the calling task, e.g. before esp_restart()
+    void flush() {
+        expireFlapWindows();
+        drainPending();
+        flushStore();
+    }
+
+    // Persist every drained record to store as well, nullptr detaches. the store must outlive the attachment
+    void attachStore(LogStore* logStore) {
         std::lock_guard<std::mutex> lock(mtx);
-        callbacks.fill(callback);
+        if (store != nullptr) {
+            store->flush();
+        }
+        store = logStore;
+        storeDirty = false;
     }
 
     void printLatestLogs() {
         std::lock_guard<std::mutex> lock(mtx);
-        for (std::size_t i = 0; i < logs.size(); ++i) {
-            const std::optional<std::string>& log = logs.at(i);
-            if (log.has_value()) {
-                ESP_LOGI(TAG, "%s", log.value().c_str());
+        // Walk the buffered region in place, no copy of the entries
+        auto spans = std::as_const(logs).peek_spans();
+        for (const auto& span : {spans.first, spans.second}) {
+            for (const LogRecord& record : span) {
+                writeRecord(record);
             }
         }
     }
 
+    // Replace the console output, e.g. to capture the formatted lines in tests
+    void setLineSink(LineSink sink) {
+        std::lock_guard<std::mutex> lock(mtx);
+        lineSink = sink != nullptr ? sink : writeToConsole;
+    }
+
+    // Give the calling task's producer ring back, records in it are still drained. call it before a task made with
+    // xTaskCreate ends, threads do it on exit. logging again afterwards claims a ring again
+    void releaseTaskRing() {
+        taskClaim().release();
+    }
+
+    // true if the calling task logs into a ring of its own rather than the shared queue
+    bool hasTaskRing() {
+        return taskClaim().producer != nullptr;
+    }
+
+    // Records lost because the task's ring and the shared fallback queue were both full
+    std::uint32_t droppedRecords() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
 private:
-    EventLogger() = default; // Private constructor for Singleton
-    ~EventLogger() {}
+    using Ring = SpscRingBuffer<LogRecord, EVENT_LOGGER_RING_SIZE>;
+
+    struct ComponentControl {
+        std::atomic<logLevel_t> level{logLevel_t::INFO};
+        TokenBucket bucket{EVENT_LOGGER_RATE_PER_SECOND, EVENT_LOGGER_RATE_BURST};
+        std::atomic<std::uint32_t> levelFiltered{0};
+        std::atomic<std::uint32_t> rateLimited{0};
+        std::atomic<std::uint32_t> flapSuppressed{0}; // By the component's detector and its instances'
+        // Lock-free, so a state change never waits for the priority 1 drain task expiring the window
+        FlapDetector flap{EVENT_LOGGER_FLAP_THRESHOLD, EVENT_LOGGER_FLAP_WINDOW_MS};
+        std::atomic<std::uint32_t> lastState{packName({enum_names::kNoTable, 0})}; // For the flap summary
+    };
+
+    static constexpr std::uint32_t packName(log_record::NameRef name) {
+        return (std::uint32_t{name.table} << 16) | name.value;
+    }
+
+    static constexpr log_record::NameRef unpackName(std::uint32_t packed) {
+        return {static_cast<std::uint16_t>(packed >> 16), static_cast<std::uint16_t>(packed)};
+    }
+
+    struct ProducerRing {
+        std::atomic<bool> claimed{false};
+        Ring ring;
+    };
+
+    // Owns a producer ring for the lifetime of the logging task
+    struct RingClaim {
+        ProducerRing* producer{nullptr};
+        bool attempted{false};
+
+        ~RingClaim() {
+            release();
+        }
+
+        void release() {
+            if (producer != nullptr) {
+                producer->claimed.store(false, std::memory_order_release);
+            }
+            producer = nullptr;
+            attempted = false;
+        }
+    };
+
+    static RingClaim& taskClaim() {
+        static thread_local RingClaim claim;
+        return claim;
+    }
+
+    EventLogger() {
+#ifdef PLATFORM_ESP32
+        // Formatting and UART output run below every application task
+        esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+        cfg.thread_name = "logDrain";
+        cfg.prio = 1;
+        cfg.stack_size = 3072;
+        esp_pthread_set_cfg(&cfg);
+#endif
+        drainThread = std::thread(&EventLogger::drainTask, this);
+#ifdef PLATFORM_ESP32
+        cfg = esp_pthread_get_default_config();
+        esp_pthread_set_cfg(&cfg);
+#endif
+    }
+
+    ~EventLogger() {
+        running.store(false, std::memory_order_relaxed);
+        if (drainThread.joinable()) {
+            drainThread.join();
+        }
+        drainPending();
+    }
 
     EventLogger(const EventLogger&) = delete;
     EventLogger& operator=(const EventLogger&) = delete;
 
-    std::string getCurrentTimestamp() const {
-        // not yet implemented
-        // auto now = std::chrono::system_clock::now();
-        // auto in_time_t = std::chrono::system_clock::to_time_t(now);
-        // std::stringstream ss;
-        // ss << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d %X");
-        // return ss.str();
-        std::string timestamp = "<timestamp_not_implemented>";
-        return timestamp;
-    }
-
-#ifdef USE_CIRCULAR_BUFFER
-    CircularBuffer<std::string, CIRCULAR_BUFFER_MAX_SIZE> logs;
-#elif defined(USE_VECTOR)
-    std::vector<std::string> logs;               // In-memory log storage
+    ProducerRing* claimRing() {
+        for (ProducerRing& producer : producers) {
+            bool expected = false;
+            if (producer.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return &producer;
+            }
+        }
+        return nullptr;
+    }
+
+    ComponentControl& controlOf(componentId_t component) {
+        auto index = static_cast<std::size_t>(component);
+        return controls[index < controls.size() ? index : static_cast<std::size_t>(componentId_t::System)];
+    }
+
+    static bool levelEnabled(ComponentControl& control, logLevel_t level) {
+        if (level <= control.level.load(std::memory_order_relaxed)) {
+            return true;
+        }
+        control.levelFiltered.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    static bool withinRate(ComponentControl& control, std::uint64_t now) {
+        if (control.bucket.tryTake(now)) {
+            return true;
+        }
+        control.rateLimited.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    static bool onTransition(ComponentControl& control, FlapDetector& flap, std::uint64_t now,
+                             std::optional<FlapDetector::Summary>& closed) {
+        if (flap.onTransition(now, closed)) {
+            return true;
+        }
+        control.flapSuppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Summaries bypass the rate limit, there is at most one per flap window. name is a component or an instance name
+    template <typename Name, typename State>
+    void logFlapSummary(const Name& name, const FlapDetector::Summary& summary, const State& lastState) {
+        log("%s flapping: %u state changes in %u ms, last %s", name, summary.changes, summary.durationMs, lastState);
+    }
+
+    // Summarize flap windows that are over, so a component that stops flapping still gets its summary
+    void expireFlapWindows() {
+        std::uint64_t now = TimeService::now();
+        for (std::size_t index = 0; index < controls.size(); ++index) {
+            if (std::optional<FlapDetector::Summary> closed = controls[index].flap.expire(now)) {
+                logFlapSummary(static_cast<componentId_t>(index), *closed,
+                               unpackName(controls[index].lastState.load(std::memory_order_relaxed)));
+            }
+        }
+    }
+
+    void enqueue(const LogRecord& record) {
+        RingClaim& claim = taskClaim();
+        if (!claim.attempted) {
+            claim.attempted = true;
+            claim.producer = claimRing();
+        }
+        if (claim.producer != nullptr && claim.producer->ring.push(record)) {
+            return;
+        }
+        if (!shared.try_push(record)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void drainTask() {
+        auto lastActivity = std::chrono::steady_clock::now();
+        while (running.load(std::memory_order_relaxed)) {
+            if (drainPending() > 0) {
+                lastActivity = std::chrono::steady_clock::now();
+                continue;
+            }
+            if (std::chrono::steady_clock::now() - lastActivity >= kStoreFlushDelay) {
+                flushStore();
+            }
+            expireFlapWindows();
+            std::this_thread::sleep_for(kDrainPeriod);
+        }
+    }
+
+    void flushStore() {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (store != nullptr && storeDirty) {
+            store->flush();
+            storeDirty = false;
+        }
+    }
+
+    // Consumer side of every ring, serialized by mtx so flush() can run alongside the drain task
+    std::size_t drainPending() {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::size_t drained = 0;
+        for (ProducerRing& producer : producers) {
+            while (auto record = producer.ring.pop()) {
+                output(*record);
+                ++drained;
+            }
+        }
+        while (auto record = shared.try_pop()) {
+            output(*record);
+            ++drained;
+        }
+        return drained;
+    }
+
+    void output(const LogRecord& record) {
+        writeRecord(record);
+        logs.push(record);
+        if (store != nullptr) {
+            store->append(record);
+            storeDirty = true;
+        }
+    }
+
+    void writeRecord(const LogRecord& record) const {
+        char line[kLineLength];
+        std::size_t prefix = formatTimestamp(record.timestamp, line, sizeof(line));
+        log_record::format(record, line + prefix, sizeof(line) - prefix);
+        lineSink(line);
+    }
+
+    // UTC wall time once the TimeService is synced, seconds since boot before that
+    static std::size_t formatTimestamp(std::uint64_t ticks, char* out, std::size_t capacity) {
+        int written;
+        if (std::optional<std::int64_t> wall = TimeService::getInstance().toWallMicros(ticks)) {
+            std::time_t seconds = static_cast<std::time_t>(*wall / 1000000);
+            std::tm utc{};
+            gmtime_r(&seconds, &utc);
+            written = std::snprintf(out, capacity, "[%04d-%02d-%02d %02d:%02d:%02d.%06lld] ", utc.tm_year + 1900,
+                                    utc.tm_mon + 1, utc.tm_mday, utc.tm_hour, utc.tm_min, utc.tm_sec,
+                                    static_cast<long long>(*wall % 1000000));
+        } else {
+            written = std::snprintf(out, capacity, "[%llu.%06llu] ", static_cast<unsigned long long>(ticks / 1000000),
+                                    static_cast<unsigned long long>(ticks % 1000000));
+        }
+        return std::min(static_cast<std::size_t>(std::max(written, 0)), capacity - 1);
+    }
+
+    static void writeToConsole(const char* line) {
+#ifdef PLATFORM_ESP32
+        ESP_LOGI(TAG, "%s", line);
+#else
+        std::printf("I (%s) %s\n", TAG, line);
 #endif
-    std::array<LogCallback, 10> callbacks;          // Observer callbacks
-    mutable std::mutex mtx;                              // Mutex for thread safety
-    static constexpr size_t logInterval = 10;    // Store logs every 10 entries
+    }
+
+    std::array<ComponentControl, enum_names::count<componentId_t>()> controls;
+    std::array<ProducerRing, EVENT_LOGGER_PRODUCER_RINGS> producers;
+    MpmcQueue<LogRecord, EVENT_LOGGER_RING_SIZE> shared;  // Fallback for tasks without a ring of their own
+    std::atomic<std::uint32_t> dropped{0};
+    CircularBuffer<LogRecord, CIRCULAR_BUFFER_MAX_SIZE> logs; // Latest drained records, owned by the drain side
+    LineSink lineSink{writeToConsole};
+    LogStore* store{nullptr};
+    bool storeDirty{false};
+    mutable std::mutex mtx;                               // Guards the consumer side, never taken by callers
+    std::atomic<bool> running{true};
+    std::thread drainThread;
+    static constexpr std::size_t kLineLength = 128;
+    static constexpr std::chrono::milliseconds kDrainPeriod{20};
+    static constexpr std::chrono::seconds kStoreFlushDelay{1};
     static constexpr const char* TAG = "EventLogger";
-};
\ No newline at end of file
+};
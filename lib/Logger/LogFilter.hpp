@@ -0,0 +1,186 @@
+/**
+ * @file LogFilter.hpp
+ * @brief the pieces EventLogger uses to shed log load while a component misbehaves: log levels with a compile-time
+ * floor, a lock-free token bucket per component, and a lock-free flap detector that collapses bursts of state changes into one
+ * "N changes in T ms" summary.
+ *
+ * both TokenBucket and FlapDetector take the current time as an argument (TimeService ticks, microseconds), so their
+ * behavior is fully deterministic in tests.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <EnumNames.hpp>
+
+#define LOG_LEVELS(X) X(NONE) X(ERROR) X(WARN) X(INFO) X(DEBUG) X(VERBOSE)
+
+enum class logLevel_t : std::uint8_t {
+    LOG_LEVELS(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(logLevel_t, LOG_LEVELS)
+
+// Levels above the floor are compiled out, e.g. -DEVENT_LOGGER_LEVEL_FLOOR=DEBUG for a debug build
+#ifndef EVENT_LOGGER_LEVEL_FLOOR
+#define EVENT_LOGGER_LEVEL_FLOOR INFO
+#endif
+
+namespace log_filter {
+
+constexpr logLevel_t kLevelFloor = logLevel_t::EVENT_LOGGER_LEVEL_FLOOR;
+
+template <logLevel_t Level>
+constexpr bool compiledIn() {
+    return Level != logLevel_t::NONE && Level <= kLevelFloor;
+}
+
+} // namespace log_filter
+
+// Allows ratePerSecond on average and bursts of up to burst. a rate of 0 disables the limit
+class TokenBucket {
+public:
+    TokenBucket(std::uint32_t ratePerSecond = 0, std::uint32_t burst = 0) {
+        configure(ratePerSecond, burst);
+    }
+
+    void configure(std::uint32_t ratePerSecond, std::uint32_t burst) {
+        rate.store(ratePerSecond, std::memory_order_relaxed);
+        capacity.store(std::max(burst, std::uint32_t{1}) * kMilli, std::memory_order_relaxed);
+        state.store(pack(0, std::max(burst, std::uint32_t{1}) * kMilli), std::memory_order_relaxed);
+    }
+
+    bool tryTake(std::uint64_t nowMicros) {
+        std::uint32_t perSecond = rate.load(std::memory_order_relaxed);
+        if (perSecond == 0) {
+            return true;
+        }
+        auto nowMillis = static_cast<std::uint32_t>(nowMicros / 1000);
+        std::uint64_t current = state.load(std::memory_order_relaxed);
+        while (true) {
+            // Refill from the last take: perSecond tokens per second is perSecond milli-tokens per millisecond
+            std::uint32_t elapsed = nowMillis - static_cast<std::uint32_t>(current >> 32);
+            std::uint64_t refilled = static_cast<std::uint32_t>(current) + std::uint64_t{elapsed} * perSecond;
+            auto tokens = static_cast<std::uint32_t>(std::min<std::uint64_t>(refilled, capacity.load(std::memory_order_relaxed)));
+            if (tokens < kMilli) {
+                return false;
+            }
+            if (state.compare_exchange_weak(current, pack(nowMillis, tokens - kMilli), std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+private:
+    static constexpr std::uint32_t kMilli = 1000; // Tokens are counted in thousandths
+
+    static std::uint64_t pack(std::uint32_t millis, std::uint32_t milliTokens) {
+        return (std::uint64_t{millis} << 32) | milliTokens;
+    }
+
+    std::atomic<std::uint64_t> state{0}; // Last refill time in ms (high half) and milli-tokens left (low half)
+    std::atomic<std::uint32_t> rate{0};
+    std::atomic<std::uint32_t> capacity{0};
+};
+
+// Logs the first threshold transitions of a window individually and counts the rest. lock-free like TokenBucket: the
+// window (start, changes, last change) is one word updated by CAS, so any task may report a transition while the drain
+// task expires the window, and exactly one of them gets its summary
+class FlapDetector {
+public:
+    struct Summary {
+        std::uint32_t changes;    // Transitions in the window, logged ones included
+        std::uint32_t durationMs; // From the first to the last transition of the window
+    };
+
+    FlapDetector(std::uint32_t threshold = 3, std::uint32_t windowMs = 2000) {
+        configure(threshold, windowMs);
+    }
+
+    // A threshold of 0 disables suppression. drops the window in progress
+    void configure(std::uint32_t threshold, std::uint32_t windowMs) {
+        this->threshold.store(threshold, std::memory_order_relaxed);
+        windowMillis.store(windowMs, std::memory_order_relaxed);
+        window.store(0, std::memory_order_relaxed);
+    }
+
+    // true if this transition should be logged on its own. closed receives the summary of an expired window
+    bool onTransition(std::uint64_t nowMicros, std::optional<Summary>& closed) {
+        closed.reset();
+        const std::uint32_t limit = threshold.load(std::memory_order_relaxed);
+        if (limit == 0) {
+            return true;
+        }
+        const auto nowMillis = static_cast<std::uint32_t>(nowMicros / 1000);
+        std::uint64_t current = window.load(std::memory_order_relaxed);
+        std::uint64_t next;
+        do {
+            const std::uint32_t changes = changesOf(current);
+            if (changes == 0 || isOver(current, nowMillis)) {
+                next = pack(nowMillis, 1, 0);
+            } else {
+                next = pack(startOf(current), std::min<std::uint32_t>(changes + 1, kMaxField),
+                            std::min<std::uint32_t>(nowMillis - startOf(current), kMaxField));
+            }
+        } while (!window.compare_exchange_weak(current, next, std::memory_order_relaxed));
+        if (changesOf(current) != 0 && isOver(current, nowMillis)) {
+            closed = summarize(current, limit);
+        }
+        if (changesOf(next) <= limit) {
+            return true;
+        }
+        suppressedTotal.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Close the window once it is over, a summary only if something in it was suppressed
+    std::optional<Summary> expire(std::uint64_t nowMicros) {
+        const auto nowMillis = static_cast<std::uint32_t>(nowMicros / 1000);
+        std::uint64_t current = window.load(std::memory_order_relaxed);
+        while (changesOf(current) != 0 && isOver(current, nowMillis)) {
+            if (window.compare_exchange_weak(current, 0, std::memory_order_relaxed)) {
+                return summarize(current, threshold.load(std::memory_order_relaxed));
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::uint32_t suppressed() const {
+        return suppressedTotal.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::uint32_t kMaxField = 0xFFFF; // Changes and last change (ms into the window) saturate
+
+    // Window start in ms (high half), changes and ms from start to the last change (16 bits each), 0 if no window
+    static std::uint64_t pack(std::uint32_t startMillis, std::uint32_t changes, std::uint32_t lastMillis) {
+        return (std::uint64_t{startMillis} << 32) | (changes << 16) | lastMillis;
+    }
+
+    static std::uint32_t startOf(std::uint64_t packed) {
+        return static_cast<std::uint32_t>(packed >> 32);
+    }
+
+    static std::uint32_t changesOf(std::uint64_t packed) {
+        return static_cast<std::uint32_t>(packed >> 16) & kMaxField;
+    }
+
+    bool isOver(std::uint64_t packed, std::uint32_t nowMillis) const {
+        return nowMillis - startOf(packed) >= windowMillis.load(std::memory_order_relaxed);
+    }
+
+    static std::optional<Summary> summarize(std::uint64_t packed, std::uint32_t limit) {
+        if (changesOf(packed) <= limit) {
+            return std::nullopt;
+        }
+        return Summary{changesOf(packed), static_cast<std::uint32_t>(packed) & kMaxField};
+    }
+
+    std::atomic<std::uint64_t> window{0};
+    std::atomic<std::uint32_t> threshold{0};
+    std::atomic<std::uint32_t> windowMillis{0};
+    std::atomic<std::uint32_t> suppressedTotal{0};
+};
@@ -0,0 +1,208 @@
+/**
+ * @file LogRecord.hpp
+ * @brief binary log record for deferred formatting: the caller only captures a timestamp, the format string pointer and
+ * the raw argument values, the printf-style formatting happens later in EventLogger's drain task.
+ *
+ * format strings must be string literals (they are kept by pointer). string arguments are copied into a small inline
+ * text area and truncated if they do not fit, so a record never allocates. enums with a DEFINE_ENUM_NAMES table are
+ * captured as (table id, value) and only looked up by name when the record is formatted.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <EnumNames.hpp>
+
+enum class logArgType_t : std::uint8_t {
+    INT,
+    UINT,
+    DOUBLE,
+    TEXT,
+    NAME
+};
+
+struct LogRecord {
+    static constexpr std::size_t kMaxArgs = 4;
+    static constexpr std::size_t kTextBytes = 32;
+
+    union Arg {
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+        struct {
+            std::uint8_t offset;
+            std::uint8_t length;
+        } text;
+        struct {
+            std::uint16_t table;
+            std::uint16_t value;
+        } name;
+    };
+
+    std::uint64_t timestamp;  // Monotonic microseconds at capture
+    const char* format;       // String literal, only dereferenced when formatting
+    std::uint8_t argCount;
+    std::uint8_t textUsed;
+    std::array<logArgType_t, kMaxArgs> types;
+    std::array<Arg, kMaxArgs> args;
+    std::array<char, kTextBytes> text;
+
+    std::string_view textArg(std::size_t index) const {
+        return {text.data() + args[index].text.offset, args[index].text.length};
+    }
+
+    const char* nameArg(std::size_t index) const {
+        return enum_names::lookup(args[index].name.table, args[index].name.value);
+    }
+};
+
+namespace log_record {
+
+// An enum value captured earlier as (table id, value), e.g. kept across calls. logged like the enum itself
+struct NameRef {
+    std::uint16_t table;
+    std::uint16_t value;
+};
+
+inline void captureText(LogRecord& record, std::string_view value) {
+    auto length = static_cast<std::uint8_t>(std::min(value.size(), LogRecord::kTextBytes - record.textUsed));
+    std::memcpy(record.text.data() + record.textUsed, value.data(), length);
+    record.types[record.argCount] = logArgType_t::TEXT;
+    record.args[record.argCount].text = {record.textUsed, length};
+    record.textUsed += length;
+}
+
+template <typename T>
+void captureArg(LogRecord& record, const T& value) {
+    if (record.argCount == LogRecord::kMaxArgs) {
+        return; // Extra arguments are ignored, the format shows <?> for them
+    }
+    if constexpr (enum_names::Named<T>) {
+        record.types[record.argCount] = logArgType_t::NAME;
+        record.args[record.argCount].name = {enum_names::tableId<T>(), static_cast<std::uint16_t>(value)};
+    } else if constexpr (std::is_same_v<T, NameRef>) {
+        record.types[record.argCount] = logArgType_t::NAME;
+        record.args[record.argCount].name = {value.table, value.value};
+    } else if constexpr (std::is_enum_v<T>) {
+        captureArg(record, static_cast<std::underlying_type_t<T>>(value));
+        return;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        record.types[record.argCount] = logArgType_t::DOUBLE;
+        record.args[record.argCount].d = value;
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        record.types[record.argCount] = logArgType_t::INT;
+        record.args[record.argCount].i = value;
+    } else if constexpr (std::is_integral_v<T>) {
+        record.types[record.argCount] = logArgType_t::UINT;
+        record.args[record.argCount].u = value;
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        captureText(record, std::string_view(value));
+    } else {
+        static_assert(std::is_arithmetic_v<T>, "LogRecord captures integers, floating point, enums and strings");
+    }
+    ++record.argCount;
+}
+
+template <typename... Args>
+void capture(LogRecord& record, std::uint64_t timestamp, const char* format, const Args&... args) {
+    static_assert(sizeof...(Args) <= LogRecord::kMaxArgs, "too many arguments for a LogRecord");
+    record.timestamp = timestamp;
+    record.format = format;
+    record.argCount = 0;
+    record.textUsed = 0;
+    (captureArg(record, args), ...);
+}
+
+// Format one record printf-style into out (always NUL terminated), returns the formatted length.
+// the captured type decides how an argument is printed, length modifiers in the format are ignored
+inline std::size_t format(const LogRecord& record, char* out, std::size_t capacity) {
+    if (capacity == 0) {
+        return 0;
+    }
+    std::size_t used = 0;
+    std::size_t argIndex = 0;
+    auto advance = [&](int written) {
+        if (written > 0) {
+            used = std::min(capacity - 1, used + static_cast<std::size_t>(written));
+        }
+    };
+
+    for (const char* p = record.format; *p != '\0' && used + 1 < capacity; ++p) {
+        if (*p != '%') {
+            out[used++] = *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[used++] = '%';
+            ++p;
+            continue;
+        }
+
+        // Keep flags, width and precision, then append the length modifier matching the captured type
+        char spec[16] = "%";
+        std::size_t specLength = 1;
+        for (++p; *p != '\0' && std::strchr("-+ #0123456789.", *p) && specLength < 10; ++p) {
+            spec[specLength++] = *p;
+        }
+        for (; *p != '\0' && std::strchr("hlLjzt", *p); ++p) {
+        }
+        const char conversion = *p;
+        if (conversion == '\0') {
+            break;
+        }
+        if (argIndex >= record.argCount) {
+            advance(std::snprintf(out + used, capacity - used, "<?>"));
+            continue;
+        }
+
+        const LogRecord::Arg& arg = record.args[argIndex];
+        switch (record.types[argIndex]) {
+            case logArgType_t::INT:
+            case logArgType_t::UINT: {
+                bool integerConversion = std::strchr("diouxXc", conversion) != nullptr;
+                bool isSigned = record.types[argIndex] == logArgType_t::INT;
+                std::strcpy(spec + specLength, "ll");
+                spec[specLength + 2] = integerConversion && conversion != 'c' ? conversion : (isSigned ? 'd' : 'u');
+                spec[specLength + 3] = '\0';
+                advance(isSigned ? std::snprintf(out + used, capacity - used, spec, static_cast<long long>(arg.i))
+                                 : std::snprintf(out + used, capacity - used, spec, static_cast<unsigned long long>(arg.u)));
+                break;
+            }
+            case logArgType_t::DOUBLE:
+                spec[specLength] = std::strchr("fFeEgGaA", conversion) ? conversion : 'g';
+                spec[specLength + 1] = '\0';
+                advance(std::snprintf(out + used, capacity - used, spec, arg.d));
+                break;
+            case logArgType_t::TEXT: {
+                // The text is not NUL terminated, its length goes in as the precision, capped by the caller's one
+                std::string_view value = record.textArg(argIndex);
+                std::size_t length = value.size();
+                if (const char* dot = static_cast<const char*>(std::memchr(spec, '.', specLength))) {
+                    length = std::min<std::size_t>(length, std::strtoul(dot + 1, nullptr, 10));
+                    specLength = static_cast<std::size_t>(dot - spec);
+                }
+                std::strcpy(spec + specLength, ".*s");
+                advance(std::snprintf(out + used, capacity - used, spec, static_cast<int>(length), value.data()));
+                break;
+            }
+            case logArgType_t::NAME:
+                std::strcpy(spec + specLength, "s");
+                advance(std::snprintf(out + used, capacity - used, spec, record.nameArg(argIndex)));
+                break;
+        }
+        ++argIndex;
+    }
+    out[used] = '\0';
+    return used;
+}
+
+} // namespace log_record
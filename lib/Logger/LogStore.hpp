@@ -0,0 +1,485 @@
+/**
+ * @file LogStore.hpp
+ * @brief persistent binary log: EventLogger's drain task appends every LogRecord to segment files on the SD card (or
+ * any mounted filesystem), so field units keep far more history than the 30 records held in RAM.
+ *
+ * segments rotate once they reach segmentBytes and only the newest maxSegments are kept, which bounds the footprint.
+ * writes go through a 512 byte block buffer and always write whole blocks, so a segment is a whole number of blocks and
+ * no write ever straddles a sector it does not fill. flush() writes the current block padded with zeros but keeps it
+ * in the buffer and seeks back to its start: the next flush, or the block filling up, rewrites it in place. sporadic
+ * records flushed one at a time therefore share a block instead of taking one each.
+ *
+ * segment layout (all integers little endian or LEB128 varints):
+ *   header   "MSLG", u16 version, u16 reserved, u32 sequence
+ *   0x00     padding, skipped
+ *   0x01     dictionary: varint id, varint length, format bytes. emitted before the first record using that format,
+ *            the dictionary restarts with every segment so each one decodes on its own
+ *   0x02     record: varint format id, zigzag varint timestamp delta to the previous record (the first record of a
+ *            segment is relative to 0, records drained from different tasks are not strictly ordered),
+ *            u8 arg count, then per arg u8 type + zigzag varint / varint / 8 byte double / varint length + text
+ *            (enum names are written as text)
+ *
+ * decode() turns a segment image back into LogRecords, it is shared with the host decoder in tools/logdecode.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "LogRecord.hpp"
+
+namespace log_store {
+
+constexpr std::uint32_t kMagic = 0x474C534D; // "MSLG"
+constexpr std::uint16_t kVersion = 1;
+constexpr std::size_t kHeaderBytes = 12;
+constexpr std::size_t kBlockBytes = 512;
+constexpr std::size_t kMaxFormatBytes = 160; // Longer formats are stored truncated
+
+enum tag_t : std::uint8_t {
+    PADDING = 0x00,
+    DICTIONARY = 0x01,
+    RECORD = 0x02
+};
+
+// Bounded append-only encoder, silently stops at the end of its buffer (callers size it for the worst case)
+class Writer {
+public:
+    explicit Writer(std::span<std::uint8_t> out) : out(out) {}
+
+    void byte(std::uint8_t value) {
+        if (used < out.size()) {
+            out[used++] = value;
+        }
+    }
+
+    void bytes(const void* data, std::size_t length) {
+        length = std::min(length, out.size() - used);
+        std::memcpy(out.data() + used, data, length);
+        used += length;
+    }
+
+    void varint(std::uint64_t value) {
+        while (value >= 0x80) {
+            byte(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        byte(static_cast<std::uint8_t>(value));
+    }
+
+    void fixed(std::uint64_t value, std::size_t width) {
+        for (std::size_t i = 0; i < width; ++i) {
+            byte(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    std::size_t size() const {
+        return used;
+    }
+
+private:
+    std::span<std::uint8_t> out;
+    std::size_t used{0};
+};
+
+class Reader {
+public:
+    explicit Reader(std::span<const std::uint8_t> in) : in(in) {}
+
+    bool byte(std::uint8_t& value) {
+        if (position >= in.size()) {
+            return false;
+        }
+        value = in[position++];
+        return true;
+    }
+
+    bool varint(std::uint64_t& value) {
+        value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            std::uint8_t next;
+            if (!byte(next)) {
+                return false;
+            }
+            value |= static_cast<std::uint64_t>(next & 0x7F) << shift;
+            if ((next & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool fixed(std::uint64_t& value, std::size_t width) {
+        value = 0;
+        for (std::size_t i = 0; i < width; ++i) {
+            std::uint8_t next;
+            if (!byte(next)) {
+                return false;
+            }
+            value |= static_cast<std::uint64_t>(next) << (8 * i);
+        }
+        return true;
+    }
+
+    std::span<const std::uint8_t> take(std::size_t length) {
+        if (length > in.size() - position) {
+            position = in.size();
+            return {};
+        }
+        auto taken = in.subspan(position, length);
+        position += length;
+        return taken;
+    }
+
+private:
+    std::span<const std::uint8_t> in;
+    std::size_t position{0};
+};
+
+inline std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+// Decode one segment image, calling onRecord(const LogRecord&) for every record. returns false if the image is not
+// a segment or ends in the middle of an entry (e.g. power loss), the records before that point are still reported
+template <typename OnRecord>
+bool decode(std::span<const std::uint8_t> segment, OnRecord onRecord, std::uint32_t* sequence = nullptr) {
+    Reader reader(segment);
+    std::uint64_t magic, version, ignored, segmentSequence;
+    if (!reader.fixed(magic, 4) || magic != kMagic || !reader.fixed(version, 2) || version != kVersion ||
+        !reader.fixed(ignored, 2) || !reader.fixed(segmentSequence, 4)) {
+        return false;
+    }
+    if (sequence != nullptr) {
+        *sequence = static_cast<std::uint32_t>(segmentSequence);
+    }
+
+    std::vector<std::string> formats;
+    std::uint64_t timestamp = 0;
+    std::uint8_t tag;
+    while (reader.byte(tag)) {
+        if (tag == PADDING) {
+            continue;
+        }
+        if (tag == DICTIONARY) {
+            std::uint64_t id, length;
+            if (!reader.varint(id) || !reader.varint(length) || id != formats.size()) {
+                return false;
+            }
+            auto text = reader.take(length);
+            if (text.size() != length) {
+                return false;
+            }
+            formats.emplace_back(reinterpret_cast<const char*>(text.data()), text.size());
+            continue;
+        }
+        if (tag != RECORD) {
+            return false;
+        }
+
+        LogRecord record{};
+        std::uint64_t id, delta;
+        std::uint8_t argCount;
+        if (!reader.varint(id) || id >= formats.size() || !reader.varint(delta) || !reader.byte(argCount) ||
+            argCount > LogRecord::kMaxArgs) {
+            return false;
+        }
+        timestamp += static_cast<std::uint64_t>(unzigzag(delta));
+        record.timestamp = timestamp;
+        record.format = formats[id].c_str();
+        for (; record.argCount < argCount; ++record.argCount) {
+            std::uint8_t type;
+            std::uint64_t value;
+            if (!reader.byte(type)) {
+                return false;
+            }
+            record.types[record.argCount] = static_cast<logArgType_t>(type);
+            LogRecord::Arg& arg = record.args[record.argCount];
+            switch (record.types[record.argCount]) {
+                case logArgType_t::INT:
+                    if (!reader.varint(value)) {
+                        return false;
+                    }
+                    arg.i = unzigzag(value);
+                    break;
+                case logArgType_t::UINT:
+                    if (!reader.varint(arg.u)) {
+                        return false;
+                    }
+                    break;
+                case logArgType_t::DOUBLE:
+                    if (!reader.fixed(value, 8)) {
+                        return false;
+                    }
+                    std::memcpy(&arg.d, &value, sizeof(double));
+                    break;
+                case logArgType_t::TEXT: {
+                    if (!reader.varint(value)) {
+                        return false;
+                    }
+                    auto text = reader.take(value);
+                    if (text.size() != value || record.textUsed + value > LogRecord::kTextBytes) {
+                        return false;
+                    }
+                    log_record::captureText(record, {reinterpret_cast<const char*>(text.data()), text.size()});
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        onRecord(record);
+    }
+    return true;
+}
+
+} // namespace log_store
+
+class LogStore {
+public:
+    struct Config {
+        std::string directory;              // e.g. "/sdcard/logs", must exist
+        std::size_t segmentBytes{64 * 1024}; // Rounded down to whole blocks
+        std::size_t maxSegments{8};          // Footprint is at most maxSegments * segmentBytes
+    };
+
+    // Continues after the newest segment found in the directory, the older ones count towards maxSegments
+    explicit LogStore(Config config) : config(std::move(config)) {
+        this->config.segmentBytes = std::max(this->config.segmentBytes / log_store::kBlockBytes, std::size_t{2}) *
+                                    log_store::kBlockBytes;
+        this->config.maxSegments = std::max(this->config.maxSegments, std::size_t{1});
+        for (std::uint32_t sequence : listSegments()) {
+            nextSequence = std::max(nextSequence, sequence + 1);
+        }
+    }
+
+    ~LogStore() {
+        closeSegment();
+    }
+
+    LogStore(const LogStore&) = delete;
+    LogStore& operator=(const LogStore&) = delete;
+
+    // Encode one record, the block buffer reaches the file once it is full. false if the segment could not be written
+    bool append(const LogRecord& record) {
+        std::array<std::uint8_t, kMaxEntryBytes> scratch;
+        log_store::Writer entry(scratch);
+        std::size_t formatId = formatIdFor(record.format);
+        if (formatId == formats.size()) {
+            std::size_t length = std::min(std::strlen(record.format), log_store::kMaxFormatBytes);
+            entry.byte(log_store::DICTIONARY);
+            entry.varint(formatId);
+            entry.varint(length);
+            entry.bytes(record.format, length);
+        }
+        entry.byte(log_store::RECORD);
+        entry.varint(formatId);
+        entry.varint(log_store::zigzag(static_cast<std::int64_t>(record.timestamp - lastTimestamp)));
+        entry.byte(record.argCount);
+        std::size_t textBudget = LogRecord::kTextBytes - record.textUsed; // Decoded names must fit the inline text too
+        for (std::size_t i = 0; i < record.argCount; ++i) {
+            const LogRecord::Arg& arg = record.args[i];
+            // Names are stored resolved, a segment must not depend on this firmware's table ids
+            logArgType_t stored = record.types[i] == logArgType_t::NAME ? logArgType_t::TEXT : record.types[i];
+            entry.byte(static_cast<std::uint8_t>(stored));
+            switch (record.types[i]) {
+                case logArgType_t::INT:
+                    entry.varint(log_store::zigzag(arg.i));
+                    break;
+                case logArgType_t::UINT:
+                    entry.varint(arg.u);
+                    break;
+                case logArgType_t::DOUBLE: {
+                    std::uint64_t bits;
+                    std::memcpy(&bits, &arg.d, sizeof(bits));
+                    entry.fixed(bits, 8);
+                    break;
+                }
+                case logArgType_t::TEXT: {
+                    std::string_view text = record.textArg(i);
+                    entry.varint(text.size());
+                    entry.bytes(text.data(), text.size());
+                    break;
+                }
+                case logArgType_t::NAME: {
+                    std::size_t length = std::min(std::strlen(record.nameArg(i)), textBudget);
+                    textBudget -= length;
+                    entry.varint(length);
+                    entry.bytes(record.nameArg(i), length);
+                    break;
+                }
+            }
+        }
+
+        // A new segment restarts the dictionary and the timestamp base, so encode the entry again
+        if (file == nullptr || segmentUsed + entry.size() > config.segmentBytes) {
+            if (!rotate()) {
+                ++lost;
+                return false;
+            }
+            return append(record);
+        }
+        if (formatId == formats.size()) {
+            formats.push_back(record.format);
+        }
+        lastTimestamp = record.timestamp;
+        if (!write(scratch.data(), entry.size())) {
+            ++lost;
+            return false;
+        }
+        return true;
+    }
+
+    // Hand the current block to the filesystem padded, e.g. periodically or before esp_restart(). it stays the
+    // block being filled, a later flush writes it again at the same offset
+    bool flush() {
+        if (file == nullptr) {
+            return !failed;
+        }
+        if (blockUsed > 0) {
+            std::memset(block.data() + blockUsed, log_store::PADDING, block.size() - blockUsed);
+            if (!writeBlock() || std::fseek(file, -static_cast<long>(block.size()), SEEK_CUR) != 0) {
+                return false;
+            }
+        }
+        return std::fflush(file) == 0;
+    }
+
+    // Segment sequence numbers present in the directory, oldest first
+    std::vector<std::uint32_t> listSegments() const {
+        std::vector<std::uint32_t> sequences;
+        DIR* dir = opendir(config.directory.c_str());
+        if (dir == nullptr) {
+            return sequences;
+        }
+        while (dirent* entry = readdir(dir)) {
+            unsigned sequence;
+            char suffix[8];
+            if (std::sscanf(entry->d_name, "LG%6u.%3s", &sequence, suffix) == 2 && std::strcmp(suffix, "BIN") == 0) {
+                sequences.push_back(sequence);
+            }
+        }
+        closedir(dir);
+        std::sort(sequences.begin(), sequences.end());
+        return sequences;
+    }
+
+    std::string segmentPath(std::uint32_t sequence) const {
+        char name[16];
+        std::snprintf(name, sizeof(name), "LG%06u.BIN", static_cast<unsigned>(sequence % 1000000));
+        return config.directory + "/" + name;
+    }
+
+    // Records that could not be stored because a segment failed to open or write
+    std::uint32_t lostRecords() const {
+        return lost;
+    }
+
+private:
+    static constexpr std::size_t kMaxEntryBytes =
+        1 + 10 + 10 + log_store::kMaxFormatBytes + 1 + 10 + 10 + 1 + LogRecord::kMaxArgs * 11 + LogRecord::kTextBytes;
+
+    std::size_t formatIdFor(const char* format) const {
+        for (std::size_t id = 0; id < formats.size(); ++id) {
+            if (formats[id] == format) {
+                return id;
+            }
+        }
+        return formats.size();
+    }
+
+    bool rotate() {
+        closeSegment();
+
+        // Keep maxSegments including the one about to be opened
+        std::vector<std::uint32_t> existing = listSegments();
+        for (std::size_t i = 0; i + config.maxSegments <= existing.size(); ++i) {
+            std::remove(segmentPath(existing[i]).c_str());
+        }
+
+        file = std::fopen(segmentPath(nextSequence).c_str(), "wb");
+        if (file == nullptr) {
+            failed = true;
+            return false;
+        }
+        std::setvbuf(file, nullptr, _IONBF, 0); // Already block buffered here
+
+        std::array<std::uint8_t, log_store::kHeaderBytes> header;
+        log_store::Writer writer(header);
+        writer.fixed(log_store::kMagic, 4);
+        writer.fixed(log_store::kVersion, 2);
+        writer.fixed(0, 2);
+        writer.fixed(nextSequence, 4);
+        ++nextSequence;
+
+        formats.clear();
+        lastTimestamp = 0;
+        segmentUsed = 0;
+        failed = false;
+        return write(header.data(), header.size());
+    }
+
+    void closeSegment() {
+        if (file != nullptr) {
+            flush();
+            std::fclose(file);
+            file = nullptr;
+        }
+        blockUsed = 0;
+    }
+
+    bool write(const std::uint8_t* data, std::size_t length) {
+        segmentUsed += length;
+        while (length > 0) {
+            std::size_t chunk = std::min(length, block.size() - blockUsed);
+            std::memcpy(block.data() + blockUsed, data, chunk);
+            blockUsed += chunk;
+            data += chunk;
+            length -= chunk;
+            if (blockUsed == block.size()) {
+                if (!writeBlock()) {
+                    return false;
+                }
+                blockUsed = 0;
+            }
+        }
+        return true;
+    }
+
+    bool writeBlock() {
+        bool written = std::fwrite(block.data(), 1, block.size(), file) == block.size();
+        if (!written) {
+            // Give up on this segment, the next append starts a fresh one
+            std::fclose(file);
+            file = nullptr;
+            blockUsed = 0;
+            failed = true;
+        }
+        return written;
+    }
+
+    Config config;
+    std::FILE* file{nullptr};
+    std::array<std::uint8_t, log_store::kBlockBytes> block{};
+    std::size_t blockUsed{0};
+    std::size_t segmentUsed{0};
+    std::uint32_t nextSequence{0};
+    std::vector<const char*> formats; // Dictionary of the current segment, index is the format id
+    std::uint64_t lastTimestamp{0};
+    std::uint32_t lost{0};
+    bool failed{false};
+};
@@ -4,6 +4,7 @@
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <esp_ota_ops.h>
 #include <esp_http_client.h>
 #include <esp_https_ota.h>
@@ -14,15 +15,20 @@
 #define BUTTON_GPIO GPIO_NUM_0
 constexpr const char* OTA_TAG = "OTA_UPDATE";
 
-enum class OtaState {
-    Idle,           // Device is idle, no OTA in progress
-    Checking,       // Checking for OTA updates
-    Downloading,    // Downloading the OTA firmware
-    Applying,       // Applying the OTA firmware
-    Success,        // OTA update successful
-    Failed          // OTA update failed
+#define OTA_STATES(X) \
+    X(Idle)           /* Device is idle, no OTA in progress */ \
+    X(Checking)       /* Checking for OTA updates */ \
+    X(Downloading)    /* Downloading the OTA firmware */ \
+    X(Applying)       /* Applying the OTA firmware */ \
+    X(Success)        /* OTA update successful */ \
+    X(Failed)         /* OTA update failed */
+
+enum class OtaState : std::uint16_t {
+    OTA_STATES(ENUM_NAMES_VALUE)
 };
 
+DEFINE_ENUM_NAMES(OtaState, OTA_STATES)
+
 class OtaManager : public StatefulObject<OtaState> {
 public:
     // Get the singleton instance
@@ -0,0 +1,448 @@
+/**
+ * @file ActiveObject.hpp
+ * @brief active objects: components that own an event queue and a hierarchical state machine, run by a small pool of
+ * dispatcher tasks instead of a thread each. stack memory then scales with ACTIVE_OBJECT_DISPATCHERS, not with the
+ * number of components, and nothing outside the object (e.g. an esp_event handler) touches its state directly, it
+ * only post()s events.
+ *
+ * every event runs to completion: an object is handed to one dispatcher at a time, which processes up to
+ * ACTIVE_OBJECT_BATCH of its events before giving the others a turn. the most derived class calls stop() in its
+ * destructor, which waits for a turn in progress while the handlers it runs still exist. an ActiveDispatcher built with 0 tasks runs
+ * nothing by itself, runUntilIdle() then processes everything on the calling task, which makes native tests
+ * deterministic and lets them replay a recorded event sequence.
+ *
+ * states form a tree declared in a constexpr StateHierarchy (parent of each state, initial child of composite states).
+ * an event goes to the current leaf state first and bubbles up to its parents until one handles it. a transition
+ * exits up to the least common ancestor, enters down to the target and then into its initial children.
+ *
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <semaphore>
+#include <thread>
+#include <vector>
+#include <AtomicState.hpp>
+#include <ComponentId.hpp>
+#include <EnumNames.hpp>
+#include <EventBus.hpp>
+#include <EventLogger.hpp>
+#include <MpmcQueue.hpp>
+#include <StateStats.hpp>
+#ifdef PLATFORM_ESP32
+#include <esp_pthread.h>
+#endif
+
+#ifndef ACTIVE_OBJECT_DISPATCHERS
+#define ACTIVE_OBJECT_DISPATCHERS 2
+#endif
+#ifndef ACTIVE_OBJECT_DISPATCHER_STACK
+#define ACTIVE_OBJECT_DISPATCHER_STACK 4096
+#endif
+#ifndef ACTIVE_OBJECT_QUEUE_SIZE
+#define ACTIVE_OBJECT_QUEUE_SIZE 16
+#endif
+#ifndef ACTIVE_OBJECT_MAX_OBJECTS
+#define ACTIVE_OBJECT_MAX_OBJECTS 16 // Per dispatcher, a power of two
+#endif
+#ifndef ACTIVE_OBJECT_BATCH
+#define ACTIVE_OBJECT_BATCH 8
+#endif
+
+struct ActiveEvent {
+    std::uint16_t signal; // Defined by each active object, e.g. an enum of its own
+    std::uint32_t param;  // Event specific payload, 0 if unused
+
+    static constexpr std::uint16_t kStart = 0xFFFF; // Reserved, enters the initial state
+};
+
+class ActiveObjectBase;
+
+class ActiveDispatcher {
+public:
+    static ActiveDispatcher& getInstance() {
+        static ActiveDispatcher instance(ACTIVE_OBJECT_DISPATCHERS); // Get the singleton instance
+        return instance;
+    }
+
+    // tasks = 0 leaves all processing to runUntilIdle()
+    explicit ActiveDispatcher(std::size_t tasks) {
+#ifdef PLATFORM_ESP32
+        // Same priority as the connectivity tasks whose events the objects handle
+        esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+        cfg.thread_name = "activeObj";
+        cfg.prio = 5;
+        cfg.stack_size = ACTIVE_OBJECT_DISPATCHER_STACK;
+        esp_pthread_set_cfg(&cfg);
+#endif
+        workers.reserve(tasks);
+        for (std::size_t i = 0; i < tasks; ++i) {
+            workers.emplace_back(&ActiveDispatcher::dispatchTask, this);
+        }
+#ifdef PLATFORM_ESP32
+        cfg = esp_pthread_get_default_config();
+        esp_pthread_set_cfg(&cfg);
+#endif
+    }
+
+    ~ActiveDispatcher() {
+        running.store(false, std::memory_order_relaxed);
+        readyCount.release(static_cast<std::ptrdiff_t>(workers.size()));
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ActiveDispatcher(const ActiveDispatcher&) = delete;
+    ActiveDispatcher& operator=(const ActiveDispatcher&) = delete;
+
+    // Process events on the calling task until no object has any left, returns the number processed
+    std::size_t runUntilIdle();
+
+private:
+    friend class ActiveObjectBase;
+
+    void schedule(ActiveObjectBase& object) {
+        // At most ACTIVE_OBJECT_MAX_OBJECTS objects share the dispatcher and each is queued at most once, so a slot
+        // can only be held by a dispatcher still popping it: sleep on it, a yield would not let a lower task finish
+        ready.push_wait(&object);
+        readyCount.release();
+    }
+
+    // Called once a turn has let go of its object, wakes stop()
+    void turnReleased() {
+        released.fetch_add(1, std::memory_order_release);
+        released.notify_all();
+    }
+
+    void dispatchTask() {
+        while (true) {
+            readyCount.acquire();
+            if (!running.load(std::memory_order_relaxed)) {
+                return;
+            }
+            runReady();
+        }
+    }
+
+    std::size_t runReady();
+
+    bool hasTasks() const {
+        return !workers.empty();
+    }
+
+    MpmcQueue<ActiveObjectBase*, ACTIVE_OBJECT_MAX_OBJECTS, true> ready;
+    std::counting_semaphore<> readyCount{0};
+    // Turns released so far. stop() sleeps on it rather than on the object, which may be gone right after the release
+    std::atomic<std::uint32_t> released{0};
+    std::atomic<bool> running{true};
+    std::vector<std::thread> workers;
+};
+
+class ActiveObjectBase {
+public:
+    explicit ActiveObjectBase(ActiveDispatcher& dispatcher) : dispatcher(dispatcher) {
+    }
+
+    // Too late to wait for a dispatch in progress, the derived part is gone by now. only stops an object left idle
+    virtual ~ActiveObjectBase() {
+        stop();
+    }
+
+    ActiveObjectBase(const ActiveObjectBase&) = delete;
+    ActiveObjectBase& operator=(const ActiveObjectBase&) = delete;
+
+    // Callable from any task, never blocks: false if the queue is full or the object stopped, the event is then
+    // dropped and counted
+    bool post(const ActiveEvent& event) {
+        if (stopped.load(std::memory_order_relaxed) || !queue.try_push(event)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if ((holds.fetch_or(kScheduled) & kScheduled) == 0) {
+            dispatcher.schedule(*this);
+        }
+        return true;
+    }
+
+    // Take no more events and wait until no dispatcher holds the object, events still queued are dropped. call it
+    // from the most derived destructor, never from the object's own handlers. an object must not be destroyed while
+    // others still post to it. on a dispatcher without tasks the pending turns run on the calling task
+    void stop() {
+        stopped.store(true, std::memory_order_relaxed);
+        while (true) {
+            // Read before holds, a turn released in between changes it and the wait returns at once
+            const std::uint32_t seen = dispatcher.released.load(std::memory_order_acquire);
+            if (holds.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+            if (!dispatcher.hasTasks()) {
+                dispatcher.runUntilIdle();
+            }
+            dispatcher.released.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    std::uint32_t droppedEvents() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+protected:
+    // Runs on a dispatcher task, one event at a time
+    virtual void dispatch(const ActiveEvent& event) = 0;
+
+private:
+    friend class ActiveDispatcher;
+
+    // One turn on a dispatcher: up to ACTIVE_OBJECT_BATCH events, then back in line if more are queued
+    std::size_t runBatch() {
+        holds.fetch_add(kTurn);
+        std::size_t processed = 0;
+        while (processed < ACTIVE_OBJECT_BATCH && !stopped.load(std::memory_order_relaxed)) {
+            std::optional<ActiveEvent> event = queue.try_pop();
+            if (!event) {
+                break;
+            }
+            dispatch(*event);
+            ++processed;
+        }
+        holds.fetch_and(~kScheduled);
+        // An event posted while kScheduled was still set did not schedule the object, pick it up here
+        if (!stopped.load(std::memory_order_relaxed) && !queue.is_empty() &&
+            (holds.fetch_or(kScheduled) & kScheduled) == 0) {
+            dispatcher.schedule(*this);
+        }
+        // Last access to the object, stop() returns once every turn is released
+        ActiveDispatcher& owner = dispatcher;
+        holds.fetch_sub(kTurn, std::memory_order_release);
+        owner.turnReleased();
+        return processed;
+    }
+
+    static constexpr std::uint32_t kScheduled = 1; // In the ready queue, or running and not yet released
+    // Per dispatcher inside runBatch(), a rescheduled object may start its next turn before the last one returned
+    static constexpr std::uint32_t kTurn = 2;
+
+    ActiveDispatcher& dispatcher;
+    MpmcQueue<ActiveEvent, ACTIVE_OBJECT_QUEUE_SIZE> queue;
+    std::atomic<std::uint32_t> holds{0}; // kScheduled plus kTurn per turn in progress, 0 once the object is idle
+    std::atomic<bool> stopped{false};
+    std::atomic<std::uint32_t> dropped{0};
+};
+
+inline std::size_t ActiveDispatcher::runReady() {
+    // Every permit has an object queued, but a task that claimed an earlier slot may still be writing it
+    return ready.pop_wait()->runBatch();
+}
+
+inline std::size_t ActiveDispatcher::runUntilIdle() {
+    std::size_t processed = 0;
+    while (readyCount.try_acquire()) {
+        processed += runReady();
+    }
+    return processed;
+}
+
+// Parent of every state and initial child of composite states, checked at compile time
+template <enum_names::Named stateType_t>
+class StateHierarchy {
+public:
+    static constexpr std::size_t kStates = enum_names::count<stateType_t>();
+    static constexpr std::size_t kNone = kStates; // Parent of top-level states, initial child of leaf states
+
+    struct Parent {
+        stateType_t state;
+        stateType_t parent;
+    };
+
+    struct Initial {
+        stateType_t composite;
+        stateType_t child;
+    };
+
+    constexpr StateHierarchy(std::initializer_list<Parent> parents = {}, std::initializer_list<Initial> initials = {}) {
+        for (std::size_t i = 0; i < kStates; ++i) {
+            parentOf[i] = kNone;
+            initialOf[i] = kNone;
+        }
+        for (const Parent& entry : parents) {
+            parentOf[index(entry.state)] = index(entry.parent);
+        }
+        for (const Initial& entry : initials) {
+            initialOf[index(entry.composite)] = index(entry.child);
+        }
+    }
+
+    constexpr std::size_t parent(std::size_t state) const {
+        return state < kStates ? parentOf[state] : kNone;
+    }
+
+    constexpr std::size_t initialChild(std::size_t state) const {
+        return initialOf[state];
+    }
+
+    // true if ancestor is state itself or one of its parents
+    constexpr bool contains(std::size_t ancestor, std::size_t state) const {
+        for (; state != kNone; state = parent(state)) {
+            if (state == ancestor) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static constexpr std::size_t index(stateType_t state) {
+        return static_cast<std::size_t>(state);
+    }
+
+private:
+    std::array<std::size_t, kStates> parentOf{};
+    std::array<std::size_t, kStates> initialOf{};
+};
+
+template <enum_names::Named stateType_t>
+class ActiveObject : public ActiveObjectBase {
+public:
+    using Hierarchy = StateHierarchy<stateType_t>;
+
+    // Call start() once constructed. hierarchy must outlive the object, usually it is constexpr
+    ActiveObject(componentId_t component, const Hierarchy& hierarchy, stateType_t initialState,
+                 ActiveDispatcher& dispatcher = ActiveDispatcher::getInstance())
+        : ActiveObjectBase(dispatcher), component(component), hierarchy(hierarchy), initialState(initialState),
+          currentState(initialState), stats(initialState) {
+    }
+
+    // Enter the initial state (and its initial children) on the dispatcher
+    void start() {
+        post({ActiveEvent::kStart, 0});
+    }
+
+    // Current leaf state, readable and waitable from any task
+    stateType_t getState() const {
+        return currentState.load();
+    }
+
+    // true if state is the current leaf state or one of its parents
+    bool isIn(stateType_t state) const {
+        return hierarchy.contains(Hierarchy::index(state), Hierarchy::index(getState()));
+    }
+
+    bool waitFor(stateType_t expected,
+                 typename AtomicState<stateType_t>::Timeout timeout = AtomicState<stateType_t>::kForever) const {
+        return currentState.waitFor(expected, timeout);
+    }
+
+    componentId_t getComponentId() const {
+        return component;
+    }
+
+    // Time in each leaf state, transition counts and residency histograms
+    const StateStats<stateType_t>& stateStats() const {
+        return stats;
+    }
+
+protected:
+    enum class reaction_t : std::uint8_t {
+        HANDLED,
+        UNHANDLED,
+        TRANSITION
+    };
+
+    struct Reaction {
+        reaction_t type;
+        stateType_t target;
+    };
+
+    static Reaction handled() {
+        return {reaction_t::HANDLED, stateType_t{}};
+    }
+
+    static Reaction unhandled() {
+        return {reaction_t::UNHANDLED, stateType_t{}};
+    }
+
+    static Reaction transitionTo(stateType_t target) {
+        return {reaction_t::TRANSITION, target};
+    }
+
+    // Handle event in state (the leaf state first, then its parents), usually a switch on both
+    virtual Reaction handle(stateType_t state, const ActiveEvent& event) = 0;
+
+    virtual void onEntry(stateType_t) {
+    }
+
+    virtual void onExit(stateType_t) {
+    }
+
+    void dispatch(const ActiveEvent& event) override {
+        if (event.signal == ActiveEvent::kStart) {
+            enter(Hierarchy::kNone, Hierarchy::index(initialState));
+            return;
+        }
+        for (std::size_t state = Hierarchy::index(leaf); state != Hierarchy::kNone; state = hierarchy.parent(state)) {
+            Reaction reaction = handle(static_cast<stateType_t>(state), event);
+            if (reaction.type == reaction_t::HANDLED) {
+                return;
+            }
+            if (reaction.type == reaction_t::TRANSITION) {
+                transition(Hierarchy::index(reaction.target));
+                return;
+            }
+        }
+    }
+
+private:
+    void transition(std::size_t target) {
+        // A transition to the current state or one of its parents leaves and re-enters the target
+        std::size_t ancestor = hierarchy.parent(target);
+        while (ancestor != Hierarchy::kNone && !hierarchy.contains(ancestor, Hierarchy::index(leaf))) {
+            ancestor = hierarchy.parent(ancestor);
+        }
+        if (!hierarchy.contains(target, Hierarchy::index(leaf))) {
+            // Deepest state that contains both, or kNone
+            ancestor = Hierarchy::index(leaf);
+            while (ancestor != Hierarchy::kNone && !hierarchy.contains(ancestor, target)) {
+                ancestor = hierarchy.parent(ancestor);
+            }
+        }
+        for (std::size_t state = Hierarchy::index(leaf); state != ancestor; state = hierarchy.parent(state)) {
+            onExit(static_cast<stateType_t>(state));
+        }
+        enter(ancestor, target);
+    }
+
+    // Enter from below ancestor down to target, then into initial children
+    void enter(std::size_t ancestor, std::size_t target) {
+        std::array<std::size_t, Hierarchy::kStates> path{};
+        std::size_t depth = 0;
+        for (std::size_t state = target; state != ancestor; state = hierarchy.parent(state)) {
+            path[depth++] = state;
+        }
+        while (depth > 0) {
+            onEntry(static_cast<stateType_t>(path[--depth]));
+        }
+        while (hierarchy.initialChild(target) != Hierarchy::kNone) {
+            target = hierarchy.initialChild(target);
+            onEntry(static_cast<stateType_t>(target));
+        }
+        leaf = static_cast<stateType_t>(target);
+        stateType_t previous = currentState.exchange(leaf);
+        if (previous != leaf) {
+            stats.record(previous, leaf);
+            EventLogger::getInstance().logStateChange(component, leaf);
+            EventBus::getInstance().publish(Event::stateChanged(component, leaf));
+        }
+    }
+
+    componentId_t component;
+    const Hierarchy& hierarchy;
+    stateType_t initialState;
+    stateType_t leaf{};                    // Only touched on the dispatcher
+    AtomicState<stateType_t> currentState; // Published copy of leaf for other tasks
+    StateStats<stateType_t> stats;
+};
@@ -0,0 +1,98 @@
+/**
+ * @file AtomicState.hpp
+ * @brief a state value that tasks can block on instead of polling it or sharing a mutex with the owner.
+ *
+ * reads and changes are plain atomic operations. waitFor()/waitUntilChanged() without a timeout sleep on the atomic
+ * itself (C++20 wait/notify); with a timeout they sleep on a condition variable that a change only locks when a timed
+ * waiter is actually registered, so the common path of the changing task never takes a lock.
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+template <typename T>
+class AtomicState {
+public:
+    using Timeout = std::chrono::milliseconds;
+    static constexpr Timeout kForever = Timeout::max();
+
+    explicit AtomicState(T initialState) : value(initialState) {
+    }
+
+    AtomicState(const AtomicState&) = delete;
+    AtomicState& operator=(const AtomicState&) = delete;
+
+    T load() const {
+        return value.load(std::memory_order_acquire);
+    }
+
+    // Returns the previous state, every waiter is woken if it changed
+    T exchange(T newState) {
+        T previous = value.exchange(newState); // seq_cst, ordered against the timedWaiters check in wake()
+        if (previous != newState) {
+            wake();
+        }
+        return previous;
+    }
+
+    // Change to newState only if the state still is expected, otherwise expected is set to the current state. every
+    // waiter is woken if it changed
+    bool compareExchange(T& expected, T newState) {
+        if (!value.compare_exchange_strong(expected, newState)) {
+            return false;
+        }
+        if (expected != newState) {
+            wake();
+        }
+        return true;
+    }
+
+    // Sleep until the state is expected, false if timeout passed first
+    bool waitFor(T expected, Timeout timeout = kForever) const {
+        if (timeout == kForever) {
+            for (T current = load(); current != expected; current = load()) {
+                value.wait(current, std::memory_order_acquire);
+            }
+            return true;
+        }
+        return waitTimed(timeout, [&] { return load() == expected; });
+    }
+
+    // Sleep until the state is no longer from, returns the state then (from itself on timeout)
+    T waitUntilChanged(T from, Timeout timeout = kForever) const {
+        if (timeout == kForever) {
+            value.wait(from, std::memory_order_acquire);
+        } else {
+            waitTimed(timeout, [&] { return load() != from; });
+        }
+        return load();
+    }
+
+private:
+    void wake() {
+        value.notify_all();
+        if (timedWaiters.load() > 0) {
+            std::lock_guard<std::mutex> lock(mtx);
+            cv.notify_all();
+        }
+    }
+
+    template <typename Predicate>
+    bool waitTimed(Timeout timeout, Predicate done) const {
+        std::unique_lock<std::mutex> lock(mtx);
+        timedWaiters.fetch_add(1);
+        bool reached = cv.wait_for(lock, timeout, done);
+        timedWaiters.fetch_sub(1);
+        return reached;
+    }
+
+    std::atomic<T> value;
+    mutable std::atomic<std::uint32_t> timedWaiters{0};
+    mutable std::mutex mtx;             // Only taken by timed waiters and by changes while one is registered
+    mutable std::condition_variable cv;
+};
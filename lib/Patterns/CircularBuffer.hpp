@@ -1,101 +1,267 @@
 #pragma once
-#include <array>
+#include <algorithm>
 #include <optional>
 #include <cstddef>
+#include <cstdint>
+#include <memory> // For std::destroy, std::uninitialized_copy
+#include <new>    // For std::launder
+#include <span>
+#include <type_traits>
 #include <utility> // For std::move
-#ifdef PLATFORM_ESP32
-#include <esp_log.h>
-#endif
+#include <CircularBufferPolicies.hpp>
 
-template <typename T, std::size_t BufferSize>
+template <typename T, std::size_t BufferSize, typename OverflowPolicy = overflow::OverwriteOldest,
+          typename StatsPolicy = stats::None>
 class CircularBuffer {
+    static_assert(BufferSize > 0, "CircularBuffer needs at least one slot");
+    using policy = overflow::traits<OverflowPolicy>;
+
 public:
-    CircularBuffer() : head_(0), tail_(0), size_(0) {}
+    // The buffered region seen as (up to) two contiguous blocks, oldest items first
+    template <typename U>
+    struct Spans {
+        std::span<U> first;
+        std::span<U> second;
 
-    // Push an item into the buffer (supports both copyable and movable types)
-    bool push(const T& item) {
-#ifdef PLATFORM_ESP32
-        ESP_LOGD("CircularBuffer", "attempt to push: %d", size_);
-#endif // PLATFORM_ESP32        
-        std::size_t next_head = (head_ + 1) % (BufferSize + 1);
-
-        if (is_max()) {
-            // Buffer is full, move tail forward to overwrite the oldest item
-            tail_ = (tail_ + 1) % (BufferSize + 1);
-            --size_; // Decrease size since we are overwriting an item
+        std::size_t size() const {
+            return first.size() + second.size();
         }
+    };
 
-        buffer_[head_] = item;
-        head_ = next_head;
-        ++size_;
-#ifdef PLATFORM_ESP32
-        ESP_LOGD("CircularBuffer", "total count: %d", size_);
-#endif // PLATFORM_ESP32
-        return true;
+    CircularBuffer() : tail_(0), size_(0) {}
+
+    ~CircularBuffer() {
+        clear();
+    }
+
+    // Slots hold live objects only between push and pop, a member-wise copy would be wrong
+    CircularBuffer(const CircularBuffer&) = delete;
+    CircularBuffer& operator=(const CircularBuffer&) = delete;
+
+    // Push an item into the buffer (supports both copyable and movable types), false if the overflow policy refused it
+    bool push(const T& item) {
+        return emplace(item);
     }
 
     bool push(T&& item) {
-#ifdef PLATFORM_ESP32
-        ESP_LOGD("CircularBuffer", "attempt to push: %d", size_);
-#endif // PLATFORM_ESP32
-        std::size_t next_head = (head_ + 1) % (BufferSize + 1);
-        
-        if (is_max()) {
-            // Buffer is full, move tail forward to overwrite the oldest item
-            tail_ = (tail_ + 1) % (BufferSize + 1);
-            --size_; // Decrease size since we are overwriting an item
+        return emplace(std::move(item));
+    }
+
+    // Construct an item in place at the write position
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        auto guard = sync_.lock();
+        if (is_max_unlocked() && !makeRoom(guard, 1)) {
+            ++overflows_;
+            return false;
         }
-        
-        buffer_[head_] = std::move(item);
-        head_ = next_head;
+
+        std::construct_at(slot(wrap(tail_ + size_)), std::forward<Args>(args)...);
         ++size_;
-#ifdef PLATFORM_ESP32
-        ESP_LOGD("CircularBuffer", "total count: %d", size_);
-#endif // PLATFORM_ESP32
+        stats_.onPush(1, size_);
         return true;
     }
 
+    // Push a whole block with at most two copies per stretch of free space, returns how many items were accepted
+    std::size_t push_n(std::span<const T> items) {
+        auto guard = sync_.lock();
+        if constexpr (policy::evicts) {
+            if (items.size() > BufferSize) {
+                // Only the newest BufferSize items would survive anyway
+                std::size_t skipped = items.size() - BufferSize;
+                if constexpr (policy::spills) {
+                    makeRoom(guard, BufferSize); // Everything buffered is older than the block, spill it first
+                    for (const T& item : items.first(skipped)) {
+                        OverflowPolicy::spill(T(item));
+                    }
+                }
+                overflows_ += skipped;
+                stats_.onOverwrite(skipped);
+                items = items.last(BufferSize);
+            }
+        }
+
+        std::size_t accepted = 0;
+        while (accepted < items.size()) {
+            std::size_t wanted = items.size() - accepted;
+            if constexpr (policy::evicts) {
+                if (size_ + wanted > BufferSize) {
+                    makeRoom(guard, wanted);
+                }
+            } else if (is_max_unlocked() && !makeRoom(guard, 1)) {
+                break;
+            }
+            std::size_t count = std::min(wanted, BufferSize - size_);
+            std::size_t head = wrap(tail_ + size_);
+            std::size_t first = std::min(count, BufferSize - head);
+            std::uninitialized_copy_n(items.begin() + accepted, first, slot(head));
+            std::uninitialized_copy_n(items.begin() + accepted + first, count - first, slot(0));
+            size_ += count;
+            accepted += count;
+            stats_.onPush(count, size_);
+        }
+        overflows_ += items.size() - accepted;
+        return accepted;
+    }
+
     // Pop an item from the buffer
     std::optional<T> pop() {
-#ifdef PLATFORM_ESP32
-        ESP_LOGD("CircularBuffer", "attempt to ppop: %d", size_);
-#endif // PLATFORM_ESP32
-        if (is_empty()) {
+        auto guard = sync_.lock();
+        if (size_ == 0) {
             return std::nullopt; // Buffer is empty
         }
-        
-        std::optional<T> item = std::move(buffer_[tail_]);
-        tail_ = (tail_ + 1) % (BufferSize + 1);
-        --size_;
-#ifdef PLATFORM_ESP32
-        ESP_LOGD("CircularBuffer", "total count: %d", size_);
-#endif // PLATFORM_ESP32
+
+        std::optional<T> item = std::move(*slot(tail_));
+        stats_.onPop(releaseUnlocked(1));
         return item;
     }
 
+    // Move up to out.size() of the oldest items into out, returns how many were popped
+    std::size_t pop_n(std::span<T> out) {
+        auto guard = sync_.lock();
+        Spans<T> spans = spansUnlocked();
+        std::size_t first = std::min(out.size(), spans.first.size());
+        std::size_t second = std::min(out.size() - first, spans.second.size());
+        std::move(spans.first.begin(), spans.first.begin() + first, out.begin());
+        std::move(spans.second.begin(), spans.second.begin() + second, out.begin() + first);
+        stats_.onPop(releaseUnlocked(first + second));
+        return first + second;
+    }
+
+    // Look at the buffered items in place, e.g. to serialize or write them out, then commit() what was consumed.
+    // with a blocking policy only the consumer may do this, producers never touch live slots so the spans stay valid
+    Spans<T> peek_spans() {
+        auto guard = sync_.lock();
+        return spansUnlocked();
+    }
+
+    Spans<const T> peek_spans() const {
+        Spans<T> spans = const_cast<CircularBuffer*>(this)->peek_spans();
+        return {spans.first, spans.second};
+    }
+
+    // Release (and destroy) the count oldest items after a peek_spans(), returns how many were released
+    std::size_t commit(std::size_t count) {
+        auto guard = sync_.lock();
+        std::size_t released = releaseUnlocked(count);
+        stats_.onPop(released);
+        return released;
+    }
+
+    void clear() {
+        auto guard = sync_.lock();
+        releaseUnlocked(size_);
+    }
+
     // Check if the buffer is empty
     bool is_empty() const {
-        return head_ == tail_;
+        auto guard = sync_.lock();
+        return size_ == 0;
     }
 
     // Check if the buffer is full
     bool is_max() const {
-        return (head_ + 1) % (BufferSize + 1) == tail_;
+        auto guard = sync_.lock();
+        return is_max_unlocked();
     }
 
     size_t size() const {
+        auto guard = sync_.lock();
         return size_;
     }
 
-    // Access the buffer without modifying it (for debugging purposes)
-    const std::optional<T>& at(std::size_t index) const {
-        std::size_t actual_index = (tail_ + index) % (BufferSize + 1);
-        return buffer_[actual_index];
+    // Items that never made it into the buffer or were evicted without being spilled
+    std::uint32_t dropped() const {
+        auto guard = sync_.lock();
+        return policy::spills ? 0 : overflows_;
+    }
+
+    // Items handed to the spill function of a SpillOldest policy
+    std::uint32_t spilled() const {
+        auto guard = sync_.lock();
+        return policy::spills ? overflows_ : 0;
+    }
+
+    // Counters snapshot, only available when the buffer is instrumented with stats::Atomic
+    stats::Snapshot stats() const requires StatsPolicy::enabled {
+        return stats_.snapshot();
+    }
+
+    // Access the buffer without modifying it (for debugging purposes), index 0 is the oldest item. a copy taken under
+    // the lock, so a concurrent pop cannot pull the item away; empty if index is past the buffered items
+    std::optional<T> at(std::size_t index) const {
+        auto guard = sync_.lock();
+        if (index >= size_) {
+            return std::nullopt;
+        }
+        return *const_cast<CircularBuffer*>(this)->slot(wrap(tail_ + index));
     }
 
 private:
-    std::array<std::optional<T>, BufferSize + 1> buffer_; // Buffer to hold items of type T
-    std::size_t head_; // Index of the next write position
-    std::size_t tail_; // Index of the next read position
-    std::size_t size_; // Current number of items in the buffer
-};
\ No newline at end of file
+    using sync_t = overflow::sync_t<OverflowPolicy>;
+    using guard_t = typename sync_t::Guard;
+
+    // Smallest index type that can count to BufferSize, keeps small buffers small in DRAM
+    using index_t = std::conditional_t<BufferSize <= UINT8_MAX, std::uint8_t,
+                    std::conditional_t<BufferSize <= UINT16_MAX, std::uint16_t, std::size_t>>;
+
+    static constexpr std::size_t wrap(std::size_t index) {
+        return index >= BufferSize ? index - BufferSize : index; // Indices never exceed 2 * BufferSize
+    }
+
+    T* slot(std::size_t index) {
+        return std::launder(reinterpret_cast<T*>(storage_ + index * sizeof(T)));
+    }
+
+    bool is_max_unlocked() const {
+        return size_ == BufferSize;
+    }
+
+    // Free at least count slots according to the overflow policy, false if the policy refuses
+    bool makeRoom(guard_t& guard, std::size_t count) {
+        if constexpr (policy::evicts) {
+            std::size_t evicted = size_ + count - BufferSize;
+            if constexpr (policy::spills) {
+                for (std::size_t i = 0; i < evicted; ++i) {
+                    OverflowPolicy::spill(std::move(*slot(wrap(tail_ + i))));
+                }
+            }
+            overflows_ += evicted;
+            stats_.onOverwrite(releaseUnlocked(evicted));
+            return true;
+        } else if constexpr (policy::blocks) {
+            // Any room is progress, push_n fills what it can and waits again
+            (void)count;
+            return sync_.waitForRoom(guard, OverflowPolicy::timeout, [this] { return size_ < BufferSize; });
+        } else {
+            (void)guard;
+            (void)count;
+            return false;
+        }
+    }
+
+    Spans<T> spansUnlocked() {
+        std::size_t first = std::min<std::size_t>(size_, BufferSize - tail_);
+        return {std::span<T>(slot(tail_), first), std::span<T>(slot(0), size_ - first)};
+    }
+
+    std::size_t releaseUnlocked(std::size_t count) {
+        count = std::min<std::size_t>(count, size_);
+        std::size_t first = std::min<std::size_t>(count, BufferSize - tail_);
+        std::destroy_n(slot(tail_), first);
+        std::destroy_n(slot(0), count - first);
+        tail_ = wrap(tail_ + count);
+        size_ -= count;
+        if (count > 0) {
+            sync_.notifyRoom();
+        }
+        return count;
+    }
+
+    alignas(T) std::byte storage_[BufferSize * sizeof(T)]; // Uninitialized slots, only [tail, tail + size) are alive
+    index_t tail_; // Index of the next read position, the write position is tail + size
+    index_t size_; // Current number of items in the buffer
+    std::uint32_t overflows_{0}; // Items dropped or spilled by the overflow policy
+    [[no_unique_address]] sync_t sync_; // Empty unless the policy blocks
+    [[no_unique_address]] StatsPolicy stats_; // Empty unless instrumented
+};
@@ -0,0 +1,180 @@
+/**
+ * @file CircularBufferPolicies.hpp
+ * @brief compile-time policies for CircularBuffer, picked per buffer so each queue pays only for what it uses.
+ * the overflow policy decides what happens when the buffer is full, the stats policy whether it is instrumented.
+ *
+ * overflow policies decide what a push does when the buffer is full:
+ * - OverwriteOldest: evict the oldest item (the historic behaviour, fine for debug logs)
+ * - RejectNewest: keep what is buffered, the push fails
+ * - BlockWithTimeout<ms>: wait for a consumer to make room, the push fails on timeout. this is the only policy that
+ *   makes the buffer thread-safe, every operation then runs under a mutex
+ * - SpillOldest<fn>: hand the oldest item to fn (e.g. RedundancyDataStorage) before its slot is reused, nothing is lost
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <utility> // For std::move
+
+namespace overflow {
+
+struct OverwriteOldest {};
+
+struct RejectNewest {};
+
+template <std::uint32_t TimeoutMs>
+struct BlockWithTimeout {
+    static constexpr std::chrono::milliseconds timeout{TimeoutMs};
+};
+
+// SpillFn is any constexpr callable taking T&&, typically a free or static function
+template <auto SpillFn>
+struct SpillOldest {
+    template <typename T>
+    static void spill(T&& item) {
+        SpillFn(std::move(item));
+    }
+};
+
+template <typename Policy>
+struct traits {
+    static constexpr bool evicts = false;   // Oldest item leaves the buffer to make room
+    static constexpr bool blocks = false;   // Push waits for room
+    static constexpr bool spills = false;   // Evicted item is handed over instead of dropped
+};
+
+template <>
+struct traits<OverwriteOldest> {
+    static constexpr bool evicts = true;
+    static constexpr bool blocks = false;
+    static constexpr bool spills = false;
+};
+
+template <std::uint32_t TimeoutMs>
+struct traits<BlockWithTimeout<TimeoutMs>> {
+    static constexpr bool evicts = false;
+    static constexpr bool blocks = true;
+    static constexpr bool spills = false;
+};
+
+template <auto SpillFn>
+struct traits<SpillOldest<SpillFn>> {
+    static constexpr bool evicts = true;
+    static constexpr bool blocks = false;
+    static constexpr bool spills = true;
+};
+
+namespace detail {
+
+// Used by the non-blocking policies, compiles down to nothing
+struct NoSync {
+    struct Guard {
+        ~Guard() {} // User-provided so call sites can hold a guard without unused-variable warnings
+    };
+
+    Guard lock() const {
+        return {};
+    }
+
+    template <typename Predicate>
+    bool waitForRoom(Guard&, std::chrono::milliseconds, Predicate) const {
+        return false;
+    }
+
+    void notifyRoom() const {}
+};
+
+struct BlockingSync {
+    using Guard = std::unique_lock<std::mutex>;
+
+    Guard lock() const {
+        return Guard(mtx);
+    }
+
+    template <typename Predicate>
+    bool waitForRoom(Guard& guard, std::chrono::milliseconds timeout, Predicate hasRoom) const {
+        return notFull.wait_for(guard, timeout, hasRoom);
+    }
+
+    void notifyRoom() const {
+        notFull.notify_all();
+    }
+
+    mutable std::mutex mtx;
+    mutable std::condition_variable notFull;
+};
+
+} // namespace detail
+
+template <typename Policy>
+using sync_t = std::conditional_t<traits<Policy>::blocks, detail::BlockingSync, detail::NoSync>;
+
+} // namespace overflow
+
+/**
+ * stats policies decide whether a buffer keeps counters that can be read from another task (e.g. for the fleet
+ * dashboard) while the buffer is in use:
+ * - None: no counters, every hook is an empty inline function
+ * - Atomic: pushes, pops, overwrites and high-water mark in 32-bit atomics, read through stats()
+ *
+ * the hooks are always called by whoever currently owns the buffer (the single user of a non-blocking buffer, or the
+ * mutex holder of a blocking one), so a relaxed load/store is enough and no locked read-modify-write is needed.
+ */
+namespace stats {
+
+struct Snapshot {
+    std::uint32_t pushes;        // Items accepted into the buffer
+    std::uint32_t pops;          // Items that left through pop, pop_n or commit
+    std::uint32_t overwrites;    // Items evicted to make room (overwritten or spilled)
+    std::uint32_t highWaterMark; // Largest size ever reached
+};
+
+struct None {
+    static constexpr bool enabled = false;
+
+    void onPush(std::size_t, std::size_t) {}
+    void onPop(std::size_t) {}
+    void onOverwrite(std::size_t) {}
+};
+
+struct Atomic {
+    static constexpr bool enabled = true;
+
+    void onPush(std::size_t count, std::size_t sizeAfter) {
+        bump(pushes, count);
+        if (sizeAfter > highWaterMark.load(std::memory_order_relaxed)) {
+            highWaterMark.store(static_cast<std::uint32_t>(sizeAfter), std::memory_order_relaxed);
+        }
+    }
+
+    void onPop(std::size_t count) {
+        bump(pops, count);
+    }
+
+    void onOverwrite(std::size_t count) {
+        bump(overwrites, count);
+    }
+
+    Snapshot snapshot() const {
+        return {pushes.load(std::memory_order_relaxed), pops.load(std::memory_order_relaxed),
+                overwrites.load(std::memory_order_relaxed), highWaterMark.load(std::memory_order_relaxed)};
+    }
+
+    std::atomic<std::uint32_t> pushes{0};
+    std::atomic<std::uint32_t> pops{0};
+    std::atomic<std::uint32_t> overwrites{0};
+    std::atomic<std::uint32_t> highWaterMark{0};
+
+private:
+    static void bump(std::atomic<std::uint32_t>& counter, std::size_t count) {
+        counter.store(counter.load(std::memory_order_relaxed) + static_cast<std::uint32_t>(count), std::memory_order_relaxed);
+    }
+};
+
+} // namespace stats
@@ -0,0 +1,26 @@
+/**
+ * @file ComponentId.hpp
+ * @brief ids of the components that report state changes, so events carry a small integer instead of an id string.
+ * add new components at the end of the list, LogStore segments and subscribers refer to them by value.
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <EnumNames.hpp>
+
+#define COMPONENT_IDS(X) \
+    X(WifiManager)       \
+    X(MqttManager)       \
+    X(OtaManager)        \
+    X(SDCard)            \
+    X(System)            \
+    X(Error)             \
+    X(SensorManager)     \
+    X(Sensor)
+
+enum class componentId_t : std::uint16_t {
+    COMPONENT_IDS(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(componentId_t, COMPONENT_IDS)
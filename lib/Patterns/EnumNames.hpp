@@ -0,0 +1,99 @@
+/**
+ * @file EnumNames.hpp
+ * @brief constexpr name tables for enums declared through an X-macro list, so state values can travel as integers and
+ * are only turned into text when something is printed.
+ *
+ * usage:
+ *   #define WIFI_STATES(X) X(NOT_INITIALIZED) X(DISCONNECTED) X(CONNECTING) X(CONNECTED)
+ *   enum class wifiState_t : std::uint16_t { WIFI_STATES(ENUM_NAMES_VALUE) };
+ *   DEFINE_ENUM_NAMES(wifiState_t, WIFI_STATES)
+ *   enum_names::nameOf(wifiState_t::CONNECTED) // "CONNECTED", at compile time
+ *
+ * tables are also registered (once per enum type, on first use) under a small integer id, which lets a log record
+ * carry (table id, value) instead of a pointer or a string and still be resolved later on another task.
+ *
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#define ENUM_NAMES_VALUE(name) name,
+#define ENUM_NAMES_STRING(name) #name,
+
+// Must be used at global scope, after the enum declared from the same list
+#define DEFINE_ENUM_NAMES(Enum, LIST)                                                                  \
+    template <>                                                                                        \
+    struct enum_names::Table<Enum> {                                                                   \
+        static constexpr const char* names[] = {LIST(ENUM_NAMES_STRING)};                              \
+    };
+
+namespace enum_names {
+
+constexpr const char* kUnknown = "UNKNOWN";
+constexpr std::uint16_t kNoTable = 0xFFFF;
+constexpr std::size_t kMaxTables = 32;
+
+// Specialized by DEFINE_ENUM_NAMES
+template <typename Enum>
+struct Table;
+
+template <typename Enum>
+concept Named = std::is_enum_v<Enum> && requires { Table<Enum>::names; };
+
+template <Named Enum>
+constexpr std::size_t count() {
+    return std::size(Table<Enum>::names);
+}
+
+template <Named Enum>
+constexpr const char* nameOf(Enum value) {
+    auto index = static_cast<std::size_t>(value);
+    return index < count<Enum>() ? Table<Enum>::names[index] : kUnknown;
+}
+
+namespace detail {
+
+struct Registry {
+    std::array<std::span<const char* const>, kMaxTables> tables{};
+    std::atomic<std::uint16_t> used{0};
+};
+
+inline Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+inline std::uint16_t registerTable(std::span<const char* const> names) {
+    Registry& registry = detail::registry();
+    std::uint16_t id = registry.used.fetch_add(1, std::memory_order_relaxed);
+    if (id >= kMaxTables) {
+        return kNoTable;
+    }
+    registry.tables[id] = names;
+    return id;
+}
+
+} // namespace detail
+
+// Registry id of an enum's table. the first call registers it, later calls are a guarded static read
+template <Named Enum>
+std::uint16_t tableId() {
+    static const std::uint16_t id = detail::registerTable(Table<Enum>::names);
+    return id;
+}
+
+// Resolve a (table id, value) pair captured earlier, possibly on another task
+inline const char* lookup(std::uint16_t table, std::uint16_t value) {
+    if (table >= kMaxTables) {
+        return kUnknown;
+    }
+    std::span<const char* const> names = detail::registry().tables[table];
+    return value < names.size() ? names[value] : kUnknown;
+}
+
+} // namespace enum_names
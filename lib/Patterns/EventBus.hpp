@@ -0,0 +1,233 @@
+/**
+ * @file EventBus.hpp
+ * @brief publish/subscribe bus for component events (state changes, faults), delivered on a dispatcher task so a
+ * slow subscriber such as LedManager never runs on, or blocks, the publishing task (e.g. WifiManager::eventHandler).
+ *
+ * publish() only pushes a small Event into a bounded MpmcQueue and wakes the dispatcher if it sleeps; a full queue
+ * drops the event and counts it instead of blocking. subscribers register a handler with a filter on component and
+ * event type, matched with two bit tests per event.
+ *
+ * handlers run on the dispatcher task one event at a time, in publish order. subscribe()/unsubscribe() may be called
+ * from any task except from inside a handler; once unsubscribe() returns, the handler is not running and won't run.
+ *
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <ComponentId.hpp>
+#include <EnumNames.hpp>
+#include <MpmcQueue.hpp>
+#ifdef PLATFORM_ESP32
+#include <esp_pthread.h>
+#endif
+
+#ifndef EVENT_BUS_QUEUE_SIZE
+#define EVENT_BUS_QUEUE_SIZE 64
+#endif
+#ifndef EVENT_BUS_MAX_SUBSCRIBERS
+#define EVENT_BUS_MAX_SUBSCRIBERS 16
+#endif
+
+#define EVENT_TYPES(X) \
+    X(STATE_CHANGED)   \
+    X(FAULT)
+
+enum class eventType_t : std::uint16_t {
+    EVENT_TYPES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(eventType_t, EVENT_TYPES)
+
+struct Event {
+    componentId_t component;
+    eventType_t type;
+    std::uint16_t value;  // New state for STATE_CHANGED, error code for FAULT
+    std::uint32_t detail; // Event specific payload, 0 if unused
+
+    template <enum_names::Named State>
+    static Event stateChanged(componentId_t component, State state, std::uint32_t detail = 0) {
+        return {component, eventType_t::STATE_CHANGED, static_cast<std::uint16_t>(state), detail};
+    }
+
+    static Event fault(componentId_t component, std::uint16_t code, std::uint32_t detail = 0) {
+        return {component, eventType_t::FAULT, code, detail};
+    }
+
+    template <enum_names::Named State>
+    bool is(componentId_t expectedComponent, State state) const {
+        return component == expectedComponent && type == eventType_t::STATE_CHANGED &&
+               value == static_cast<std::uint16_t>(state);
+    }
+};
+
+// Which events a subscriber receives, everything by default
+class EventFilter {
+public:
+    static EventFilter any() {
+        return {};
+    }
+
+    // Narrow to the given components (accumulates over calls)
+    template <typename... Components>
+    EventFilter& components(Components... ids) {
+        componentMask = (restrictedComponents ? componentMask : 0) | (std::uint32_t{0} | ... | bit(ids));
+        restrictedComponents = true;
+        return *this;
+    }
+
+    template <typename... Types>
+    EventFilter& types(Types... ids) {
+        typeMask = (restrictedTypes ? typeMask : 0) | (std::uint32_t{0} | ... | bit(ids));
+        restrictedTypes = true;
+        return *this;
+    }
+
+    bool matches(const Event& event) const {
+        return (componentMask & bit(event.component)) != 0 && (typeMask & bit(event.type)) != 0;
+    }
+
+private:
+    static_assert(enum_names::count<componentId_t>() <= 32 && enum_names::count<eventType_t>() <= 32,
+                  "EventFilter masks hold 32 components and 32 event types");
+
+    template <typename Enum>
+    static std::uint32_t bit(Enum id) {
+        return static_cast<std::size_t>(id) < 32 ? std::uint32_t{1} << static_cast<std::size_t>(id) : 0;
+    }
+
+    std::uint32_t componentMask{0xFFFFFFFF};
+    std::uint32_t typeMask{0xFFFFFFFF};
+    bool restrictedComponents{false};
+    bool restrictedTypes{false};
+};
+
+class EventBus {
+public:
+    using Handler = std::function<void(const Event&)>;
+    using SubscriptionId = std::uint16_t;
+    static constexpr SubscriptionId kInvalidSubscription = 0xFFFF;
+
+    static EventBus& getInstance() {
+        static EventBus instance; // Get the singleton instance
+        return instance;
+    }
+
+    // Separate buses (e.g. in tests) run their own dispatcher. startDispatcher = false leaves delivery to
+    // dispatchPending(), which makes delivery deterministic
+    explicit EventBus(bool startDispatcher = true) {
+        if (!startDispatcher) {
+            return;
+        }
+#ifdef PLATFORM_ESP32
+        // Above the logger's drain task, below the connectivity tasks that publish
+        esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+        cfg.thread_name = "eventBus";
+        cfg.prio = 3;
+        cfg.stack_size = 4096;
+        esp_pthread_set_cfg(&cfg);
+#endif
+        dispatcher = std::thread(&EventBus::dispatchTask, this);
+#ifdef PLATFORM_ESP32
+        cfg = esp_pthread_get_default_config();
+        esp_pthread_set_cfg(&cfg);
+#endif
+    }
+
+    ~EventBus() {
+        running.store(false, std::memory_order_relaxed);
+        wake();
+        if (dispatcher.joinable()) {
+            dispatcher.join();
+        }
+    }
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    // kInvalidSubscription if all EVENT_BUS_MAX_SUBSCRIBERS slots are taken
+    SubscriptionId subscribe(const EventFilter& filter, Handler handler) {
+        std::lock_guard<std::mutex> lock(subscribersMtx);
+        for (SubscriptionId id = 0; id < subscribers.size(); ++id) {
+            if (!subscribers[id].handler) {
+                subscribers[id] = {filter, std::move(handler)};
+                return id;
+            }
+        }
+        return kInvalidSubscription;
+    }
+
+    void unsubscribe(SubscriptionId id) {
+        std::lock_guard<std::mutex> lock(subscribersMtx);
+        if (id < subscribers.size()) {
+            subscribers[id].handler = nullptr;
+        }
+    }
+
+    // Never blocks: false if the queue is full, the event is then dropped and counted
+    bool publish(const Event& event) {
+        if (!queue.try_push(event)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        wake();
+        return true;
+    }
+
+    // Deliver everything queued so far on the calling task, returns the number of events delivered
+    std::size_t dispatchPending() {
+        std::size_t delivered = 0;
+        while (auto event = queue.try_pop()) {
+            deliver(*event);
+            ++delivered;
+        }
+        return delivered;
+    }
+
+    std::uint32_t droppedEvents() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Subscriber {
+        EventFilter filter;
+        Handler handler;
+    };
+
+    void wake() {
+        // Only the dispatcher waits, and no notify is needed while a wake-up is already pending
+        if (pending.exchange(1, std::memory_order_release) == 0) {
+            pending.notify_one();
+        }
+    }
+
+    void dispatchTask() {
+        while (running.load(std::memory_order_relaxed)) {
+            pending.wait(0, std::memory_order_acquire);
+            pending.exchange(0, std::memory_order_acquire); // Pairs with the publisher's exchange, so its push is seen
+            dispatchPending();
+        }
+        dispatchPending();
+    }
+
+    void deliver(const Event& event) {
+        std::lock_guard<std::mutex> lock(subscribersMtx);
+        for (const Subscriber& subscriber : subscribers) {
+            if (subscriber.handler && subscriber.filter.matches(event)) {
+                subscriber.handler(event);
+            }
+        }
+    }
+
+    MpmcQueue<Event, EVENT_BUS_QUEUE_SIZE> queue;
+    std::array<Subscriber, EVENT_BUS_MAX_SUBSCRIBERS> subscribers;
+    std::mutex subscribersMtx;                 // Held while delivering, so unsubscribe waits for a running handler
+    std::atomic<std::uint32_t> pending{0};     // Set by publishers, the dispatcher sleeps on it
+    std::atomic<std::uint32_t> dropped{0};
+    std::atomic<bool> running{true};
+    std::thread dispatcher;
+};
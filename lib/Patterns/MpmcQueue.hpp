@@ -0,0 +1,220 @@
+/**
+ * @file MpmcQueue.hpp
+ * @brief bounded lock-free multi-producer/multi-consumer queue, so that several sensor acquisition tasks can feed
+ * one or more drain tasks (e.g. SensorDataPublisher) without serializing on a single mutex.
+ *
+ * every slot carries a sequence number telling whose turn it is: a producer may write slot i when its sequence equals
+ * the enqueue position, a consumer may read it when it equals the dequeue position + 1. producers only contend on
+ * one CAS of the enqueue position, consumers on one CAS of the dequeue position, and the two never share a line.
+ *
+ * a Waitable queue also notifies every sequence change, so push_wait()/pop_wait() can sleep on the slot (C++20
+ * atomic wait) instead of spinning on a task that claimed it and was preempted. on FreeRTOS a yield loop would never
+ * let a lower priority task finish its claim. the notify costs a check for waiters on each push and pop, so it is
+ * opt-in.
+ *
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <utility> // For std::move, std::forward
+
+template <typename T, std::size_t Capacity, bool Waitable = false>
+class MpmcQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MpmcQueue capacity must be a power of two");
+
+public:
+    MpmcQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // Non-blocking push, returns false if the queue is full
+    bool try_push(const T& item) {
+        return try_emplace(item);
+    }
+
+    bool try_push(T&& item) {
+        return try_emplace(std::move(item));
+    }
+
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        Cell* cell;
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & kMask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Slot still holds an item from the previous lap, queue is full
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = T(std::forward<Args>(args)...);
+        publish(*cell, pos + 1);
+        return true;
+    }
+
+    // Sleep until the slot is free instead of failing, for a producer that knows the queue cannot stay full (e.g.
+    // fewer items than Capacity, one of them still being popped)
+    void push_wait(T item) requires Waitable {
+        Cell* cell;
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & kMask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else {
+                if (diff < 0) {
+                    cell->sequence.wait(sequence, std::memory_order_acquire); // A consumer still reads the slot
+                }
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(item);
+        publish(*cell, pos + 1);
+    }
+
+    // Non-blocking pop, returns std::nullopt if the queue is empty
+    std::optional<T> try_pop() {
+        Cell* cell;
+        std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & kMask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return std::nullopt; // Slot not yet published, queue is empty
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::optional<T> item = std::move(cell->data);
+        publish(*cell, pos + Capacity);
+        return item;
+    }
+
+    // Sleep until an item is there instead of returning empty, for a consumer that knows one is on its way (e.g. it
+    // holds a permit the producer released after claiming a slot)
+    T pop_wait() requires Waitable {
+        Cell* cell;
+        std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & kMask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else {
+                if (diff < 0) {
+                    cell->sequence.wait(sequence, std::memory_order_acquire); // A producer still writes the slot
+                }
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        T item = std::move(cell->data);
+        publish(*cell, pos + Capacity);
+        return item;
+    }
+
+    // Retry until the item is queued or the timeout expires
+    template <typename Rep, typename Period>
+    bool push_for(T item, std::chrono::duration<Rep, Period> timeout) {
+        return retryUntil(std::chrono::steady_clock::now() + timeout, [&] { return try_push(std::move(item)); });
+    }
+
+    template <typename Rep, typename Period>
+    std::optional<T> pop_for(std::chrono::duration<Rep, Period> timeout) {
+        std::optional<T> item;
+        retryUntil(std::chrono::steady_clock::now() + timeout, [&] {
+            item = try_pop();
+            return item.has_value();
+        });
+        return item;
+    }
+
+    // Approximate, other threads may change it right after it is read
+    std::size_t size() const {
+        const std::size_t enqueued = enqueuePos_.load(std::memory_order_acquire);
+        const std::size_t dequeued = dequeuePos_.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    bool is_empty() const {
+        return size() == 0;
+    }
+
+    static constexpr std::size_t capacity() {
+        return Capacity;
+    }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+    static constexpr std::size_t kCacheLineSize = 64;
+    static constexpr int kSpinAttempts = 64;
+    static constexpr int kYieldAttempts = 16;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T data{};
+    };
+
+    void publish(Cell& cell, std::size_t sequence) {
+        cell.sequence.store(sequence, std::memory_order_release);
+        if constexpr (Waitable) {
+            cell.sequence.notify_all();
+        }
+    }
+
+    // Spin briefly, then yield, then sleep a tick: lower priority tasks would starve under a pure yield loop
+    template <typename Attempt>
+    static bool retryUntil(std::chrono::steady_clock::time_point deadline, Attempt attempt) {
+        for (int tries = 0;; ++tries) {
+            if (attempt()) {
+                return true;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            if (tries < kSpinAttempts) {
+                continue;
+            } else if (tries < kSpinAttempts + kYieldAttempts) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> enqueuePos_{0}; // Next position producers claim
+    alignas(kCacheLineSize) std::atomic<std::size_t> dequeuePos_{0}; // Next position consumers claim
+    alignas(kCacheLineSize) std::array<Cell, Capacity> cells_;
+};
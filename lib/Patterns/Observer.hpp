@@ -1,26 +1,82 @@
+/**
+ * @file Observer.hpp
+ * @brief classic observer interface on top of Signal: observers sit in a fixed set of slots, so notifyObservers()
+ * neither allocates nor copies a shared_ptr per observer. an observer removed from inside notify() stays alive until
+ * the notification is over.
+ *
+ */
+
 #pragma once
-#include <vector>
+#include <array>
 #include <memory>
+#include <Signal.hpp>
+
+#ifndef OBSERVABLE_MAX_OBSERVERS
+#define OBSERVABLE_MAX_OBSERVERS 8
+#endif
 
 class Observable;
 
 class Observer {
 public:
-    virtual void notify(std::weak_ptr<Observable> observable) = 0;
+    virtual ~Observer() = default;
+    virtual void notify(const std::weak_ptr<Observable>& observable) = 0;
 };
 
 class Observable : public std::enable_shared_from_this<Observable> {
 public:
-    void addObserver(std::shared_ptr<Observer> observer) {
-        observerList.push_back(observer);
+    // false if all OBSERVABLE_MAX_OBSERVERS slots are taken
+    bool addObserver(const std::shared_ptr<Observer>& observer) {
+        for (Slot& slot : observers) {
+            // A slot removed during this notification still holds its observer until it ends
+            if (!slot.connection.connected() && (notifying == 0 || slot.observer == nullptr)) {
+                slot.observer = observer;
+                slot.connection = changed.connect<&Observer::notify>(*observer);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Also safe from inside notify()
+    void removeObserver(const std::shared_ptr<Observer>& observer) {
+        for (Slot& slot : observers) {
+            if (slot.observer == observer) {
+                slot.connection.disconnect();
+                releasePending = true;
+            }
+        }
+        if (notifying == 0) {
+            releaseRemoved();
+        }
     }
 
+    // Safe during construction too: observers then get an expired weak_ptr instead of shared_from_this() throwing
     void notifyObservers() {
-        auto self = shared_from_this();
-        for (auto observer : observerList) {
-            observer->notify(self);
+        ++notifying;
+        changed.emit(weak_from_this());
+        if (--notifying == 0 && releasePending) {
+            releaseRemoved();
         }
     }
+
 private:
-    std::vector<std::shared_ptr<Observer>> observerList;
+    struct Slot {
+        std::shared_ptr<Observer> observer;
+        Connection connection;
+    };
+
+    void releaseRemoved() {
+        for (Slot& slot : observers) {
+            if (!slot.connection.connected()) {
+                slot.observer.reset();
+            }
+        }
+        releasePending = false;
+    }
+
+    Signal<const std::weak_ptr<Observable>&> changed;
+    std::array<Slot, OBSERVABLE_MAX_OBSERVERS> observers;
+    int notifying{0};
+    bool releasePending{false};
 };
@@ -0,0 +1,270 @@
+/**
+ * @file PersistentRingBuffer.hpp
+ * @brief ring buffer whose items survive esp_restart(), for samples that must not vanish when WifiManager restarts the
+ * chip after too many failed reconnects.
+ *
+ * the ring lives in caller-provided memory that is not cleared on reset: RTC slow memory on the ESP32
+ * (RTC_NOINIT_ATTR), or an mmap'd file on the host so restart recovery can be tested on Linux. two copies of a small
+ * header (indices, sequence number, CRC32) are written alternately; on boot the valid copy with the highest sequence
+ * wins, so a reset in the middle of a header write falls back to the previous state. recovery checks two CRCs over
+ * 32 bytes and never touches the item slots, which keeps it in the microsecond range.
+ *
+ * an item becomes visible only once the header pointing past it is written, so a reset between the two steps loses
+ * that one item but never exposes a half-written one. the header does not cover the slot contents: RTC memory keeps
+ * them across resets but not across power loss, which starts the ring from scratch (the header CRC fails).
+ *
+ * usage on the ESP32:
+ *   using SampleRing = PersistentRingBuffer<Sample, 128, MemoryRegionStorage>;
+ *   RTC_NOINIT_ATTR static std::byte sampleRingMemory[SampleRing::kStorageBytes];
+ *   MemoryRegionStorage storage(sampleRingMemory);
+ *   SampleRing ring(storage);
+ *
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#ifdef PLATFORM_NATIVE
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace persistent_ring {
+
+// CRC-32 (IEEE, reflected), nibble table so it needs no RAM and only 64 bytes of flash
+inline std::uint32_t crc32(const void* data, std::size_t length) {
+    static constexpr std::uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    auto bytes = static_cast<const std::uint8_t*>(data);
+    std::uint32_t crc = 0xFFFFFFFF;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+} // namespace persistent_ring
+
+// Non-owning view over memory that survives a reset, e.g. an RTC_NOINIT_ATTR array
+class MemoryRegionStorage {
+public:
+    explicit MemoryRegionStorage(std::span<std::byte> region) : region(region) {}
+
+    std::byte* data() {
+        return region.data();
+    }
+
+    std::size_t size() const {
+        return region.size();
+    }
+
+private:
+    std::span<std::byte> region;
+};
+
+#ifdef PLATFORM_NATIVE
+// Host stand-in for RTC memory: a shared mapping of a file, which outlives the process like RTC memory outlives a reset
+class MappedFileStorage {
+public:
+    MappedFileStorage(const std::string& path, std::size_t size) : length(size) {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0 || ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            return;
+        }
+        void* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped != MAP_FAILED) {
+            region = static_cast<std::byte*>(mapped);
+        }
+    }
+
+    ~MappedFileStorage() {
+        if (region) {
+            ::munmap(region, length);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    MappedFileStorage(const MappedFileStorage&) = delete;
+    MappedFileStorage& operator=(const MappedFileStorage&) = delete;
+
+    bool isOpen() const {
+        return region != nullptr;
+    }
+
+    std::byte* data() {
+        return region;
+    }
+
+    std::size_t size() const {
+        return region ? length : 0;
+    }
+
+private:
+    int fd{-1};
+    std::byte* region{nullptr};
+    std::size_t length;
+};
+#endif // PLATFORM_NATIVE
+
+template <typename T, std::size_t Capacity, typename Storage>
+class PersistentRingBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "PersistentRingBuffer items are stored as raw bytes");
+    static_assert(Capacity > 0, "PersistentRingBuffer needs at least one slot");
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint32_t layout;   // sizeof(T) and Capacity, a firmware with a different ring must not reuse the data
+        std::uint32_t sequence; // Incremented on every write, the higher valid copy is the current one
+        std::uint32_t tail;     // Index of the oldest item
+        std::uint32_t size;     // Number of items
+        std::uint32_t dropped;  // Items overwritten because the ring was full
+        std::uint32_t reserved;
+        std::uint32_t crc;      // CRC32 of all fields above
+    };
+
+    static constexpr std::uint32_t kMagic = 0x52494E47; // "RING"
+    static constexpr std::uint32_t kLayout = static_cast<std::uint32_t>(sizeof(T) << 20) ^ static_cast<std::uint32_t>(Capacity);
+    static constexpr std::size_t kSlotsOffset = (2 * sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+public:
+    static constexpr std::size_t kStorageBytes = kSlotsOffset + Capacity * sizeof(T);
+
+    // Recovers the previous content if the storage holds a valid ring of the same layout, starts empty otherwise
+    explicit PersistentRingBuffer(Storage& storage) : storage(storage), usable(storage.size() >= kStorageBytes) {
+        recoveredFromStorage = usable && recover();
+        if (usable && !recoveredFromStorage) {
+            header = Header{kMagic, kLayout, 0, 0, 0, 0, 0, 0};
+            writeHeader();
+        }
+    }
+
+    PersistentRingBuffer(const PersistentRingBuffer&) = delete;
+    PersistentRingBuffer& operator=(const PersistentRingBuffer&) = delete;
+
+    // Push an item, overwriting the oldest one when full like CircularBuffer does. false if the storage is too small
+    bool push(const T& item) {
+        if (!usable) {
+            return false;
+        }
+        if (header.size == Capacity) {
+            // Retire the oldest slot before reusing it, so a reset mid-copy never exposes a torn item
+            header.tail = (header.tail + 1) % Capacity;
+            --header.size;
+            ++header.dropped;
+            writeHeader();
+        }
+
+        std::memcpy(slot((header.tail + header.size) % Capacity), &item, sizeof(T));
+        ++header.size;
+        writeHeader();
+        return true;
+    }
+
+    std::optional<T> pop() {
+        std::optional<T> item = front();
+        if (item.has_value()) {
+            header.tail = (header.tail + 1) % Capacity;
+            --header.size;
+            writeHeader();
+        }
+        return item;
+    }
+
+    std::optional<T> front() const {
+        if (header.size == 0) {
+            return std::nullopt;
+        }
+        std::array<std::byte, sizeof(T)> raw;
+        std::memcpy(raw.data(), const_cast<PersistentRingBuffer*>(this)->slot(header.tail), sizeof(T));
+        return std::bit_cast<T>(raw);
+    }
+
+    void clear() {
+        if (!usable) {
+            return;
+        }
+        header.tail = 0;
+        header.size = 0;
+        writeHeader();
+    }
+
+    bool is_empty() const {
+        return header.size == 0;
+    }
+
+    bool is_max() const {
+        return header.size == Capacity;
+    }
+
+    std::size_t size() const {
+        return header.size;
+    }
+
+    std::uint32_t dropped() const {
+        return header.dropped;
+    }
+
+    // True if the content was recovered from a previous boot (or process)
+    bool recovered() const {
+        return recoveredFromStorage;
+    }
+
+private:
+    std::byte* headerCopy(std::uint32_t sequence) {
+        return storage.data() + (sequence & 1) * sizeof(Header);
+    }
+
+    std::byte* slot(std::size_t index) {
+        return storage.data() + kSlotsOffset + index * sizeof(T);
+    }
+
+    static bool isValid(const Header& candidate) {
+        return candidate.magic == kMagic && candidate.layout == kLayout &&
+               candidate.crc == persistent_ring::crc32(&candidate, offsetof(Header, crc)) &&
+               candidate.tail < Capacity && candidate.size <= Capacity;
+    }
+
+    bool recover() {
+        Header copies[2];
+        std::memcpy(&copies[0], storage.data(), sizeof(Header));
+        std::memcpy(&copies[1], storage.data() + sizeof(Header), sizeof(Header));
+        bool valid0 = isValid(copies[0]);
+        bool valid1 = isValid(copies[1]);
+        if (!valid0 && !valid1) {
+            return false;
+        }
+
+        // Sequence comparison tolerates wrap-around
+        bool pickSecond = valid1 && (!valid0 || static_cast<std::int32_t>(copies[1].sequence - copies[0].sequence) > 0);
+        header = copies[pickSecond ? 1 : 0];
+        return true;
+    }
+
+    void writeHeader() {
+        ++header.sequence;
+        header.crc = persistent_ring::crc32(&header, offsetof(Header, crc));
+        // Slot writes must land before the header that makes them visible
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(headerCopy(header.sequence), &header, sizeof(Header));
+    }
+
+    Storage& storage;
+    bool usable; // Storage is large enough for the header copies and all slots
+    Header header{};
+    bool recoveredFromStorage{false};
+};
@@ -0,0 +1,228 @@
+/**
+ * @file Signal.hpp
+ * @brief signal/slot notification without heap allocation: every connection is a node of an intrusive list that
+ * lives inside the Connection handle returned by connect(), so emit() only walks the list and calls each slot
+ * through one function pointer.
+ *
+ * a Connection disconnects when it is destroyed, and can be moved (e.g. into a member of the observer). a slot may
+ * disconnect itself or any other connection while the signal is emitting; slots connected during an emit() are
+ * first called on the next one. a slot connected through a weak_ptr is skipped and dropped once its object expired.
+ *
+ * usage:
+ *   Signal<int> levelChanged;
+ *   Connection connection = levelChanged.connect<&Display::showLevel>(display);
+ *   levelChanged.emit(42); // display.showLevel(42)
+ *
+ * signals and connections are not thread-safe, connect, disconnect and emit from one task (or under one lock).
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+class Connection;
+
+namespace signal_detail {
+
+// Position of an emit() in progress, moved forward when the connection it points to goes away
+struct Iteration {
+    Connection* next;
+    Iteration* previous;
+};
+
+// The type-independent part of a Signal: the list and the emits in progress
+struct SignalBase {
+    Connection* head{nullptr};
+    Connection* tail{nullptr};
+    Iteration* iterations{nullptr};
+    std::uint32_t connects{0};
+
+    void link(Connection& connection);
+    void unlink(Connection& connection);
+    void replace(Connection& from, Connection& to);
+};
+
+} // namespace signal_detail
+
+class Connection {
+public:
+    Connection() = default;
+
+    Connection(Connection&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    Connection& operator=(Connection&& other) noexcept {
+        if (this != &other) {
+            disconnect();
+            if (other.owner != nullptr) {
+                other.owner->replace(other, *this);
+            }
+            thunk = other.thunk;
+            function = other.function;
+            object = other.object;
+            tracked = std::move(other.tracked);
+            sequence = other.sequence;
+        }
+        return *this;
+    }
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    ~Connection() {
+        disconnect();
+    }
+
+    void disconnect() {
+        if (owner != nullptr) {
+            owner->unlink(*this);
+        }
+    }
+
+    bool connected() const {
+        return owner != nullptr;
+    }
+
+private:
+    friend struct signal_detail::SignalBase;
+    template <typename... Args>
+    friend class Signal;
+
+    // Returned as a prvalue by Signal::connect(), so the node is linked where the caller's handle lives
+    Connection(signal_detail::SignalBase& signal, void (*thunk)(), void (*function)(), void* object,
+               std::weak_ptr<const void> tracked)
+        : thunk(thunk), function(function), object(object), tracked(std::move(tracked)) {
+        signal.link(*this);
+    }
+
+    signal_detail::SignalBase* owner{nullptr};
+    Connection* previous{nullptr};
+    Connection* next{nullptr};
+    void (*thunk)(){nullptr};    // Signal<Args...>::Thunk, cast back by the signal that owns the connection
+    void (*function)(){nullptr}; // Free function slots
+    void* object{nullptr};       // Member function slots
+    std::weak_ptr<const void> tracked;
+    std::uint32_t sequence{0};   // Order of connect(), to skip slots connected during an emit()
+};
+
+namespace signal_detail {
+
+inline void SignalBase::link(Connection& connection) {
+    connection.owner = this;
+    connection.sequence = connects++;
+    connection.previous = tail;
+    connection.next = nullptr;
+    (tail != nullptr ? tail->next : head) = &connection;
+    tail = &connection;
+}
+
+inline void SignalBase::unlink(Connection& connection) {
+    for (Iteration* iteration = iterations; iteration != nullptr; iteration = iteration->previous) {
+        if (iteration->next == &connection) {
+            iteration->next = connection.next;
+        }
+    }
+    (connection.previous != nullptr ? connection.previous->next : head) = connection.next;
+    (connection.next != nullptr ? connection.next->previous : tail) = connection.previous;
+    connection.owner = nullptr;
+    connection.previous = nullptr;
+    connection.next = nullptr;
+}
+
+// The list node moves along with the Connection handle
+inline void SignalBase::replace(Connection& from, Connection& to) {
+    for (Iteration* iteration = iterations; iteration != nullptr; iteration = iteration->previous) {
+        if (iteration->next == &from) {
+            iteration->next = &to;
+        }
+    }
+    to.owner = this;
+    to.previous = from.previous;
+    to.next = from.next;
+    (to.previous != nullptr ? to.previous->next : head) = &to;
+    (to.next != nullptr ? to.next->previous : tail) = &to;
+    from.owner = nullptr;
+    from.previous = nullptr;
+    from.next = nullptr;
+}
+
+} // namespace signal_detail
+
+template <typename... Args>
+class Signal {
+public:
+    Signal() = default;
+
+    // Connections outliving the signal are left disconnected
+    ~Signal() {
+        while (list.head != nullptr) {
+            list.unlink(*list.head);
+        }
+    }
+
+    Signal(const Signal&) = delete;
+    Signal& operator=(const Signal&) = delete;
+
+    [[nodiscard]] Connection connect(void (*function)(Args...)) {
+        return Connection(list, reinterpret_cast<void (*)()>(&callFunction), reinterpret_cast<void (*)()>(function),
+                          nullptr, {});
+    }
+
+    // object must outlive the connection
+    template <auto Method, typename T>
+    [[nodiscard]] Connection connect(T& object) {
+        return Connection(list, reinterpret_cast<void (*)()>(&callMethod<Method, T>), nullptr,
+                          const_cast<void*>(static_cast<const void*>(&object)), {});
+    }
+
+    // Weak subscription: the slot is skipped and disconnected once object expired
+    template <auto Method, typename T>
+    [[nodiscard]] Connection connect(const std::weak_ptr<T>& object) {
+        return Connection(list, reinterpret_cast<void (*)()>(&callTracked<Method, T>), nullptr, nullptr, object);
+    }
+
+    void emit(Args... args) {
+        signal_detail::Iteration iteration{list.head, list.iterations};
+        list.iterations = &iteration;
+        const std::uint32_t connectedBefore = list.connects;
+        while (Connection* connection = iteration.next) {
+            iteration.next = connection->next;
+            if (static_cast<std::int32_t>(connection->sequence - connectedBefore) < 0) { // Connected before this emit
+                reinterpret_cast<Thunk>(connection->thunk)(*connection, args...);
+            }
+        }
+        list.iterations = iteration.previous;
+    }
+
+    bool empty() const {
+        return list.head == nullptr;
+    }
+
+private:
+    using Thunk = void (*)(Connection&, Args...);
+
+    static void callFunction(Connection& connection, Args... args) {
+        reinterpret_cast<void (*)(Args...)>(connection.function)(args...);
+    }
+
+    template <auto Method, typename T>
+    static void callMethod(Connection& connection, Args... args) {
+        (static_cast<T*>(connection.object)->*Method)(args...);
+    }
+
+    template <auto Method, typename T>
+    static void callTracked(Connection& connection, Args... args) {
+        std::shared_ptr<const void> locked = connection.tracked.lock();
+        if (!locked) {
+            connection.disconnect();
+            return;
+        }
+        (const_cast<T*>(static_cast<const T*>(locked.get()))->*Method)(args...);
+    }
+
+    signal_detail::SignalBase list;
+};
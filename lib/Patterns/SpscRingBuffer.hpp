@@ -0,0 +1,117 @@
+/**
+ * @file SpscRingBuffer.hpp
+ * @brief lock-free single-producer/single-consumer ring, meant for handing sensor samples from an acquisition
+ * task (or an ISR) to a single consumer such as the publisher, without wrapping a CircularBuffer in a mutex.
+ *
+ * exactly one thread may push and exactly one thread may pop. head and tail live on separate cache lines, and each
+ * side keeps a private copy of the other side's index so the shared line is only touched when the ring looks full
+ * (producer) or empty (consumer). push never blocks nor allocates, so it is safe to call from an ISR as long as
+ * copying T is (place the calling code in IRAM on ESP32 if it has to run while the flash cache is disabled).
+ *
+ * slots are raw storage: emplace constructs the item in its slot and pop destroys it, so T needs neither a default
+ * constructor nor assignment, and nothing stays alive in a popped slot.
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory> // For std::construct_at, std::destroy_at
+#include <new>    // For std::launder
+#include <optional>
+#include <utility> // For std::move, std::forward
+
+template <typename T, std::size_t Capacity>
+class SpscRingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRingBuffer capacity must be a power of two");
+
+public:
+    SpscRingBuffer() = default;
+
+    ~SpscRingBuffer() {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        for (std::size_t tail = tail_.load(std::memory_order_relaxed); tail != head; ++tail) {
+            std::destroy_at(slot(tail));
+        }
+    }
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    // Producer side: returns false if the ring is full, the item is then left untouched
+    bool push(const T& item) {
+        return emplace(item);
+    }
+
+    bool push(T&& item) {
+        return emplace(std::move(item));
+    }
+
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cachedTail_ == Capacity) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head - cachedTail_ == Capacity) {
+                return false; // Buffer is full
+            }
+        }
+
+        std::construct_at(slot(head), std::forward<Args>(args)...);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: returns std::nullopt if the ring is empty
+    std::optional<T> pop() {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cachedHead_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail == cachedHead_) {
+                return std::nullopt; // Buffer is empty
+            }
+        }
+
+        T* stored = slot(tail);
+        std::optional<T> item = std::move(*stored);
+        std::destroy_at(stored);
+        tail_.store(tail + 1, std::memory_order_release);
+        return item;
+    }
+
+    // Snapshot queries, exact only when called from the producer or the consumer thread
+    bool is_empty() const {
+        return size() == 0;
+    }
+
+    bool is_max() const {
+        return size() == Capacity;
+    }
+
+    std::size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t capacity() {
+        return Capacity;
+    }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+    static constexpr std::size_t kCacheLineSize = 64; // covers both the ESP32 (32 bytes) and typical hosts
+
+    T* slot(std::size_t index) {
+        return std::launder(reinterpret_cast<T*>(buffer_ + (index & kMask) * sizeof(T)));
+    }
+
+    // Producer-owned line: indices are free running, wrap-around is handled by unsigned arithmetic
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_{0}; // Index of the next write position
+    std::size_t cachedTail_{0};                                // Producer's last seen tail
+
+    // Consumer-owned line
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0}; // Index of the next read position
+    std::size_t cachedHead_{0};                                // Consumer's last seen head
+
+    // Uninitialized slots, only [tail, head) are alive
+    alignas(kCacheLineSize > alignof(T) ? kCacheLineSize : alignof(T)) std::byte buffer_[Capacity * sizeof(T)];
+};
@@ -3,82 +3,190 @@
  * @brief this pattern is meant to drive the state of an object or system. this acts as main pattern that will
  * dictate the whole system, committing towards a design that is driven by state, hence trackable by nature, and
  * (hopefully) predictable if any errors occure.
- * 
+ *
+ * the valid transitions live in a TransitionTable built at compile time: a dense N x N array indexed by the enum
+ * values, each allowed cell holding an optional transition action, next to an entry and an exit action per state.
+ * changeToState() is two array lookups and at most three calls through function pointers, nothing is allocated.
+ *
+ * usage:
+ *   constexpr StateMachine<doorState_t, Door>::Table kDoorTable{
+ *       {{doorState_t::CLOSED, doorState_t::OPEN, &Door::onOpened}, {doorState_t::OPEN, doorState_t::CLOSED}},
+ *       {{doorState_t::OPEN, &Door::startAlarmTimer, &Door::stopAlarmTimer}}};
+ *
+ * changeToState() may be called from several tasks, e.g. WifiManager changes state on the esp_event loop and on
+ * whichever task calls reconnect(). a change first claims its transition with a compare-exchange on the state, and
+ * re-checks the table against the state it lost to, so of two racing changes from one state only one runs its
+ * actions. the actions run after the claim, on the claiming task: waiters already see the new state, and actions of
+ * back-to-back transitions claimed by different tasks may overlap. getState() may be read, and
+ * waitFor()/waitUntilChanged() blocked on, from any task.
+ *
  */
 
 #pragma once
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <AtomicState.hpp>
+#include <ComponentId.hpp>
+#include <EnumNames.hpp>
+#include <EventBus.hpp>
+#include <EventLogger.hpp>
+#include <StateStats.hpp>
 
-#include <functional>
-#include <unordered_map>
-#include <vector>
-#include <memory>
-#include "freertos/FreeRTOS.h"
-#include "freertos/event_groups.h"
-
-template<typename stateType_t>
-class StateMachine {
+template <enum_names::Named stateType_t, typename Context>
+class TransitionTable {
 public:
-    virtual ~StateMachine() = default;
+    using Action = void (*)(Context& context, stateType_t from, stateType_t to);
+
+    struct Transition {
+        stateType_t from;
+        stateType_t to;
+        Action action = nullptr; // Runs between the exit and the entry action
+    };
+
+    struct StateActions {
+        stateType_t state;
+        Action onEntry = nullptr;
+        Action onExit = nullptr;
+    };
+
+    constexpr TransitionTable(std::initializer_list<Transition> transitions,
+                              std::initializer_list<StateActions> stateActions = {}) {
+        for (const Transition& transition : transitions) {
+            cells[index(transition.from)][index(transition.to)] = {true, transition.action};
+        }
+        for (const StateActions& actions : stateActions) {
+            entryActions[index(actions.state)] = actions.onEntry;
+            exitActions[index(actions.state)] = actions.onExit;
+        }
+    }
 
-    using StateChangeCallback = std::function<void(stateType_t, stateType_t)>;
+    constexpr bool allows(stateType_t from, stateType_t to) const {
+        return index(from) < kStates && index(to) < kStates && cells[index(from)][index(to)].allowed;
+    }
+
+    // The three lookups below expect states the table allows()
+    constexpr Action transitionAction(stateType_t from, stateType_t to) const {
+        return cells[index(from)][index(to)].action;
+    }
 
-    // Register a valid state transition with a specific callback
-    void registerStateTransition(stateType_t from, stateType_t to, StateChangeCallback callback) {
-        stateTransitions[from].push_back(to);
-        stateChangeCallbacks[{from, to}] = callback;
+    constexpr Action entryAction(stateType_t state) const {
+        return entryActions[index(state)];
     }
 
-    // Register an observer to be notified of all state changes
-    void registerObserver(std::shared_ptr<Observer<stateType_t>> observer) {
-        observers.push_back(observer);
+    constexpr Action exitAction(stateType_t state) const {
+        return exitActions[index(state)];
     }
 
-    // Change to a new state (if the transition is valid)
+private:
+    static constexpr std::size_t kStates = enum_names::count<stateType_t>();
+
+    struct Cell {
+        bool allowed = false;
+        Action action = nullptr;
+    };
+
+    static constexpr std::size_t index(stateType_t state) {
+        return static_cast<std::size_t>(state);
+    }
+
+    std::array<std::array<Cell, kStates>, kStates> cells{};
+    std::array<Action, kStates> entryActions{};
+    std::array<Action, kStates> exitActions{};
+};
+
+template <enum_names::Named stateType_t, typename Context>
+class StateMachine {
+public:
+    using Table = TransitionTable<stateType_t, Context>;
+
+    // table must outlive the machine, usually it is a constexpr or static object
+    StateMachine(const Table& table, Context& context, stateType_t initialState)
+        : table(table), context(context), currentState(initialState), stats(initialState) {
+    }
+
+    virtual ~StateMachine() = default;
+
+    // Change to a new state if the table allows it: runs the exit action of the old state, the transition action and
+    // the entry action of the new one. a self transition only happens if it is in the table
     bool changeToState(stateType_t newState) {
-        if (isValidTransition(currentState, newState)) {
-            stateType_t oldState = currentState;
-            currentState = newState;
-            notifyStateChange(oldState, newState);
-            return true;
-        }
-        return false; // Invalid transition
+        stateType_t oldState = currentState.load();
+        do {
+            if (!table.allows(oldState, newState)) {
+                return false; // Invalid transition, or no longer valid from the state another task changed to
+            }
+        } while (!currentState.compareExchange(oldState, newState)); // Wakes tasks blocked in waitFor()
+        stats.record(oldState, newState);
+        run(table.exitAction(oldState), oldState, newState);
+        run(table.transitionAction(oldState, newState), oldState, newState);
+        run(table.entryAction(newState), oldState, newState);
+        onStateChanged(oldState, newState);
+        return true;
     }
 
     // Get the current state
     stateType_t getState() const {
-        return currentState;
+        return currentState.load();
+    }
+
+    // Block the calling task until the machine is in expected, false on timeout
+    bool waitFor(stateType_t expected,
+                 typename AtomicState<stateType_t>::Timeout timeout = AtomicState<stateType_t>::kForever) const {
+        return currentState.waitFor(expected, timeout);
+    }
+
+    // Block until the machine leaves from, returns the state it is in then (from on timeout)
+    stateType_t waitUntilChanged(stateType_t from,
+                                 typename AtomicState<stateType_t>::Timeout timeout = AtomicState<stateType_t>::kForever) const {
+        return currentState.waitUntilChanged(from, timeout);
+    }
+
+    // Time in state, transition counts and residency histograms, self transitions included
+    const StateStats<stateType_t>& stateStats() const {
+        return stats;
     }
 
 protected:
-    // Check if a transition is valid
-    bool isValidTransition(stateType_t from, stateType_t to) const {
-        auto it = stateTransitions.find(from);
-        if (it != stateTransitions.end()) {
-            for (const auto& validState : it->second) {
-                if (validState == to) {
-                    return true;
-                }
-            }
-        }
-        return false;
+    // Called after every accepted transition, once all actions ran
+    virtual void onStateChanged(stateType_t, stateType_t) {
     }
 
-    // Notify the registered callback for this specific state change
-    void notifyStateChange(stateType_t oldState, stateType_t newState) {
-        // Notify the state machine implementer's callback
-        auto callbackIt = stateChangeCallbacks.find({oldState, newState});
-        if (callbackIt != stateChangeCallbacks.end()) {
-            callbackIt->second(oldState, newState);
+private:
+    void run(typename Table::Action action, stateType_t from, stateType_t to) {
+        if (action != nullptr) {
+            action(context, from, to);
         }
+    }
 
-        // Notify all registered observers
-        for (auto& observer : observers) {
-            observer->notify(oldState, newState);
-        }
+    const Table& table;
+    Context& context;
+    AtomicState<stateType_t> currentState;
+    StateStats<stateType_t> stats;
+};
+
+// Logs every accepted transition and publishes it on the EventBus, like StatefulObjectLogged
+template <enum_names::Named stateType_t, typename Context>
+class StateMachineLogged : public StateMachine<stateType_t, Context> {
+public:
+    StateMachineLogged(componentId_t component, const typename StateMachine<stateType_t, Context>::Table& table,
+                       Context& context, stateType_t initialState)
+        : StateMachine<stateType_t, Context>(table, context, initialState), component(component) {
+    }
+
+    componentId_t getComponentId() const {
+        return component;
+    }
+
+    const char* getStateName() const {
+        return enum_names::nameOf(this->getState());
+    }
+
+protected:
+    void onStateChanged(stateType_t, stateType_t newState) override {
+        EventLogger::getInstance().logStateChange(component, newState);
+        EventBus::getInstance().publish(Event::stateChanged(component, newState));
     }
 
-    stateType_t currentState;
-    std::unordered_map<stateType_t, std::vector<stateType_t>> stateTransitions;
-    std::unordered_map<std::pair<stateType_t, stateType_t>, StateChangeCallback> stateChangeCallbacks;
-    std::vector<std::shared_ptr<Observer<stateType_t>>> observers;
-};
\ No newline at end of file
+private:
+    componentId_t component;
+};
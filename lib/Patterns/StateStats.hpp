@@ -0,0 +1,287 @@
+/**
+ * @file StateStats.hpp
+ * @brief residency statistics of a state machine: per state the number of entries, the cumulative time spent in it and
+ * a log2 histogram of how long each stay lasted, plus a count per (from, to) transition. e.g. how long a unit sits in
+ * wifiState_t::CONNECTING before it gets through, which is what reconnect backoff is tuned against.
+ *
+ * record() is O(1): one clock read and four relaxed atomic operations, no allocation, so it runs inside
+ * setState()/changeToState() on whichever task changes the state. the 32-bit counters are lock-free everywhere; the
+ * 64-bit times (enteredAt, totalMicros) are not on the 32-bit Xtensa ESP32, where each of their two operations takes
+ * libatomic's critical section (a spinlock with interrupts masked for a few instructions). under concurrent changes
+ * of the same object a stay may be attributed a few microseconds off. histogram bucket 0 counts stays under 1 ms,
+ * bucket b stays of [2^(b-1), 2^b) ms, the last bucket everything longer.
+ *
+ * writeJson() exports everything as one compact record (states never entered and empty trailing buckets are left
+ * out), e.g. {"CONNECTING":{"n":3,"ms":5120,"h":[0,0,0,0,0,0,0,0,0,0,0,2,1],"to":{"CONNECTED":3}}}
+ *
+ * LatencyStats uses the same buckets for an interval that spans two state machines, which neither one's residency
+ * shows, e.g. from WifiManager entering CONNECTED to MqttManager entering CONNECTED. start() and cancel() are called
+ * from one task and stop() from one other, e.g. the EventBus dispatcher and the MQTT dispatcher.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <EnumNames.hpp>
+#include <TimeService.hpp>
+
+#ifndef STATE_STATS_BUCKETS
+#define STATE_STATS_BUCKETS 24 // Last bucket from 2^22 ms, about 70 minutes
+#endif
+
+namespace state_stats {
+
+// Counts and histograms; 64-bit times are kept atomic too but go through libatomic on 32-bit targets
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "state stats counters must be lock-free");
+
+constexpr std::size_t bucketOf(std::uint64_t millis) {
+    return std::min<std::size_t>(std::bit_width(millis), STATE_STATS_BUCKETS - 1);
+}
+
+// snprintf into a fixed buffer, counting what did not fit
+struct Writer {
+    char* out;
+    std::size_t size;
+    std::size_t length{0};
+
+    template <typename... Args>
+    void put(const char* format, Args... args) {
+        const std::size_t room = length < size ? size - length : 0;
+        const int written = std::snprintf(room > 0 ? out + length : nullptr, room, format, args...);
+        length += written > 0 ? static_cast<std::size_t>(written) : 0;
+    }
+};
+
+} // namespace state_stats
+
+template <enum_names::Named T, typename Clock = time_service::DefaultClock>
+class StateStats {
+public:
+    static constexpr std::size_t kStates = enum_names::count<T>();
+    static constexpr std::size_t kBuckets = STATE_STATS_BUCKETS;
+
+    explicit StateStats(T initialState) : initialState(initialState), enteredAt(Clock::monotonicMicros()) {
+    }
+
+    StateStats(const StateStats&) = delete;
+    StateStats& operator=(const StateStats&) = delete;
+
+    // Closes the stay in from and starts one in to, call once per change (self transitions included)
+    void record(T from, T to) {
+        std::uint64_t now = Clock::monotonicMicros();
+        std::uint64_t stayMicros = now - enteredAt.exchange(now, std::memory_order_relaxed);
+        if (index(from) < kStates && index(to) < kStates) {
+            PerState& left = states[index(from)];
+            left.totalMicros.fetch_add(stayMicros, std::memory_order_relaxed);
+            left.histogram[bucketOf(stayMicros / 1000)].fetch_add(1, std::memory_order_relaxed);
+            transitionCounts[index(from)][index(to)].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Times state was entered, the initial state counts once. summed from the transition counts on read
+    std::uint32_t entries(T state) const {
+        if (index(state) >= kStates) {
+            return 0;
+        }
+        std::uint32_t total = state == initialState ? 1 : 0;
+        for (std::size_t from = 0; from < kStates; ++from) {
+            total += transitionCounts[from][index(state)].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // Cumulative time in state, including the ongoing stay if current is state
+    std::uint64_t timeInStateMicros(T state, T current) const {
+        if (index(state) >= kStates) {
+            return 0;
+        }
+        std::uint64_t total = states[index(state)].totalMicros.load(std::memory_order_relaxed);
+        if (state == current) {
+            total += Clock::monotonicMicros() - enteredAt.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // Completed stays in state that fell into bucket
+    std::uint32_t histogram(T state, std::size_t bucket) const {
+        if (index(state) >= kStates || bucket >= kBuckets) {
+            return 0;
+        }
+        return states[index(state)].histogram[bucket].load(std::memory_order_relaxed);
+    }
+
+    std::uint32_t transitions(T from, T to) const {
+        if (index(from) >= kStates || index(to) >= kStates) {
+            return 0;
+        }
+        return transitionCounts[index(from)][index(to)].load(std::memory_order_relaxed);
+    }
+
+    static constexpr std::size_t bucketOf(std::uint64_t stayMillis) {
+        return state_stats::bucketOf(stayMillis);
+    }
+
+    // Shortest stay in ms counted by bucket
+    static constexpr std::uint64_t bucketFloorMillis(std::size_t bucket) {
+        return bucket == 0 ? 0 : std::uint64_t{1} << (bucket - 1);
+    }
+
+    // Returns the length the full record needs, like snprintf: the output is cut (and terminated) if size is smaller
+    std::size_t writeJson(char* out, std::size_t size, T current) const {
+        state_stats::Writer writer{out, size};
+        writer.put("{");
+        bool firstState = true;
+        for (std::size_t s = 0; s < kStates; ++s) {
+            const T state = static_cast<T>(s);
+            const std::uint32_t entered = entries(state);
+            if (entered == 0) {
+                continue;
+            }
+            writer.put("%s\"%s\":{\"n\":%lu,\"ms\":%llu,\"h\":[", firstState ? "" : ",", enum_names::nameOf(state),
+                       static_cast<unsigned long>(entered),
+                       static_cast<unsigned long long>(timeInStateMicros(state, current) / 1000));
+            firstState = false;
+            std::size_t used = kBuckets;
+            while (used > 0 && histogram(state, used - 1) == 0) {
+                --used;
+            }
+            for (std::size_t b = 0; b < used; ++b) {
+                writer.put("%s%lu", b == 0 ? "" : ",", static_cast<unsigned long>(histogram(state, b)));
+            }
+            writer.put("],\"to\":{");
+            bool firstTarget = true;
+            for (std::size_t t = 0; t < kStates; ++t) {
+                const std::uint32_t count = transitions(state, static_cast<T>(t));
+                if (count != 0) {
+                    writer.put("%s\"%s\":%lu", firstTarget ? "" : ",", enum_names::nameOf(static_cast<T>(t)),
+                               static_cast<unsigned long>(count));
+                    firstTarget = false;
+                }
+            }
+            writer.put("}}");
+        }
+        writer.put("}");
+        return writer.length;
+    }
+
+private:
+    struct PerState {
+        std::atomic<std::uint64_t> totalMicros{0};
+        std::array<std::atomic<std::uint32_t>, kBuckets> histogram{};
+    };
+
+    static constexpr std::size_t index(T state) {
+        return static_cast<std::size_t>(state);
+    }
+
+    const T initialState;
+    std::atomic<std::uint64_t> enteredAt; // 64-bit like totalMicros, a 32-bit tick would wrap within a long stay
+    std::array<PerState, kStates> states{};
+    std::array<std::array<std::atomic<std::uint32_t>, kStates>, kStates> transitionCounts{};
+};
+
+template <typename Clock = time_service::DefaultClock>
+class LatencyStats {
+public:
+    static constexpr std::size_t kBuckets = STATE_STATS_BUCKETS;
+
+    LatencyStats() = default;
+    LatencyStats(const LatencyStats&) = delete;
+    LatencyStats& operator=(const LatencyStats&) = delete;
+
+    // Starts an interval, or restarts the one running
+    void start() {
+        startedAt.store(Clock::monotonicMicros(), std::memory_order_relaxed);
+    }
+
+    // Drops the interval running, e.g. the link went down before the other side got through
+    void cancel() {
+        startedAt.store(kIdle, std::memory_order_relaxed);
+    }
+
+    // Records the interval running, false if none was
+    bool stop() {
+        const std::uint64_t started = startedAt.exchange(kIdle, std::memory_order_relaxed);
+        if (started == kIdle) {
+            return false;
+        }
+        const std::uint64_t micros = Clock::monotonicMicros() - started;
+        count.fetch_add(1, std::memory_order_relaxed);
+        totalMicros.fetch_add(micros, std::memory_order_relaxed);
+        if (micros > maxMicros.load(std::memory_order_relaxed)) {
+            maxMicros.store(micros, std::memory_order_relaxed); // Only the stopping task writes it
+        }
+        histogram[state_stats::bucketOf(micros / 1000)].fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::uint32_t intervals() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t totalIntervalMicros() const {
+        return totalMicros.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t maxIntervalMicros() const {
+        return maxMicros.load(std::memory_order_relaxed);
+    }
+
+    std::uint32_t bucket(std::size_t index) const {
+        return index < kBuckets ? histogram[index].load(std::memory_order_relaxed) : 0;
+    }
+
+    // e.g. {"n":2,"ms":3400,"max":2900,"h":[0,0,0,0,0,0,0,0,0,0,1,0,1]}, sized like StateStats::writeJson()
+    std::size_t writeJson(char* out, std::size_t size) const {
+        std::size_t used = kBuckets;
+        while (used > 0 && bucket(used - 1) == 0) {
+            --used;
+        }
+        state_stats::Writer writer{out, size};
+        writer.put("{\"n\":%lu,\"ms\":%llu,\"max\":%llu,\"h\":[", static_cast<unsigned long>(intervals()),
+                   static_cast<unsigned long long>(totalIntervalMicros() / 1000),
+                   static_cast<unsigned long long>(maxIntervalMicros() / 1000));
+        for (std::size_t b = 0; b < used; ++b) {
+            writer.put("%s%lu", b == 0 ? "" : ",", static_cast<unsigned long>(bucket(b)));
+        }
+        writer.put("]}");
+        return writer.length;
+    }
+
+private:
+    static constexpr std::uint64_t kIdle = ~std::uint64_t{0};
+
+    // 64-bit: not lock-free on the ESP32 (see above), fine at one interval per connect
+    std::atomic<std::uint64_t> startedAt{kIdle};
+    std::atomic<std::uint32_t> count{0};
+    std::atomic<std::uint64_t> totalMicros{0};
+    std::atomic<std::uint64_t> maxMicros{0};
+    std::array<std::atomic<std::uint32_t>, kBuckets> histogram{};
+};
+
+// Stands in for StateStats where the state type has no DEFINE_ENUM_NAMES table
+struct NoStateStats {
+    template <typename T>
+    explicit NoStateStats(T) {
+    }
+
+    template <typename T>
+    void record(T, T) {
+    }
+};
+
+template <typename T>
+struct StateStatsFor {
+    using type = NoStateStats;
+};
+
+template <enum_names::Named T>
+struct StateStatsFor<T> {
+    using type = StateStats<T>;
+};
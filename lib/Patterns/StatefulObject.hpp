@@ -1,18 +1,26 @@
 #pragma once
+#include <cstdint>
+#include <optional>
+#include <AtomicState.hpp>
 #include <Observer.hpp>
+#include <ComponentId.hpp>
+#include <EnumNames.hpp>
+#include <EventBus.hpp>
 #include <EventLogger.hpp>
+#include <StateStats.hpp>
 
 template <typename T>
 class StatefulObject: public Observable {
 public:
     StatefulObject(const std::string id, T initialState)
-        : id(id), state(initialState) {}
+        : id(id), state(initialState), stats(initialState) {}
 
     // Update the state and log the change
     virtual void setState(const T& newState) {
-        if (state != newState) {
-            state = newState;
-            // notifyObservers();
+        T previous = state.exchange(newState);
+        if (previous != newState) {
+            stats.record(previous, newState);
+            this->notifyObservers();
         }
     }
 
@@ -22,28 +30,86 @@ public:
 
     // Get the current state
     T getState() const {
-        return state;
+        return state.load();
+    }
+
+    // Block the calling task until the state is expected, false on timeout. no polling, no lock shared with setState
+    bool waitFor(T expected, typename AtomicState<T>::Timeout timeout = AtomicState<T>::kForever) const {
+        return state.waitFor(expected, timeout);
+    }
+
+    // Block until the state differs from from, returns the new state (from on timeout)
+    T waitUntilChanged(T from, typename AtomicState<T>::Timeout timeout = AtomicState<T>::kForever) const {
+        return state.waitUntilChanged(from, timeout);
+    }
+
+    // Time in state, transition counts and residency histograms, for states with a DEFINE_ENUM_NAMES table
+    const typename StateStatsFor<T>::type& stateStats() const requires enum_names::Named<T> {
+        return stats;
     }
 
 protected:
-    std::string id;  // Unique identifier for the object
-    T state;         // Current state
+    std::string id;        // Unique identifier for the object
+    AtomicState<T> state;  // Current state
+    [[no_unique_address]] typename StateStatsFor<T>::type stats;
 };
 
 template <typename T>
 class StatefulObjectLogged : public StatefulObject<T> {
+    static_assert(enum_names::Named<T>, "StatefulObjectLogged states need a DEFINE_ENUM_NAMES table");
+
 public:
-    StatefulObjectLogged(const std::string id, T initialState): StatefulObject<T>(id, initialState) {
+    StatefulObjectLogged(componentId_t component, T initialState)
+        : StatefulObject<T>(enum_names::nameOf(component), initialState), component(component) {
     }
 
     void setState(const T& newState) override {
         auto& logger = EventLogger::getInstance();
-        if (this->state != newState) {
-            this->state = newState;
-            // this->notifyObservers();
-            logger.logStateChange(this->id, this->getStateAsString());
+        T previous = this->state.exchange(newState);
+        if (previous != newState) {
+            this->stats.record(previous, newState);
+            this->notifyObservers();
+            if (flap) {
+                logger.logStateChange(component, this->id.c_str(), newState, previous, *flap);
+            } else {
+                logger.logStateChange(component, newState);
+            }
+            EventBus::getInstance().publish(Event::stateChanged(component, newState, detail));
+        }
+    }
+
+    componentId_t getComponentId() const {
+        return component;
+    }
+
+    // Set by setInstance(), 0 otherwise. the detail of every STATE_CHANGED event published
+    std::uint32_t getDetail() const {
+        return detail;
+    }
+
+    // Summarize an instance's flap window that is over, so an instance that stops flapping still gets its summary.
+    // call it now and then from the task changing the state; component windows are expired by the logger
+    void expireFlapWindow() {
+        if (flap) {
+            EventLogger::getInstance().expireFlapWindow(this->id.c_str(), *flap, this->state.load());
         }
     }
 
-    virtual std::string getStateAsString() const = 0;
-};
\ No newline at end of file
+    const char* getStateName() const {
+        return enum_names::nameOf(this->state.load());
+    }
+
+protected:
+    // Make this one of several instances of component (e.g. one sensor of many), before its first change: the id
+    // becomes "<component> <instance>", changes are logged under it with a flap window of its own instead of the
+    // component's, and events carry detail so subscribers can tell the instances apart
+    void setInstance(const std::string& instance, std::uint32_t detail) {
+        this->id = std::string(enum_names::nameOf(component)) + " " + instance;
+        this->detail = detail;
+        flap.emplace(EVENT_LOGGER_FLAP_THRESHOLD, EVENT_LOGGER_FLAP_WINDOW_MS);
+    }
+
+    componentId_t component;
+    std::uint32_t detail{0};
+    std::optional<FlapDetector> flap; // Set for instances only
+};
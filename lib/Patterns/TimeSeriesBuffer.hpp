@@ -0,0 +1,103 @@
+/**
+ * @file TimeSeriesBuffer.hpp
+ * @brief CircularBuffer of timestamped samples that answers time-window queries ("everything since T") with a binary
+ * search instead of a scan, for the replay path after an outage.
+ *
+ * timestamps must be non-decreasing (monotonic ticks, not wall clock), which keeps the buffered region sorted across
+ * both of its contiguous spans. queries return those spans narrowed to the window, so the caller can serialize the
+ * result in place and then drop_before() what was sent.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <CircularBuffer.hpp>
+
+template <typename T, std::size_t BufferSize, typename Timestamp = std::uint64_t>
+class TimeSeriesBuffer {
+public:
+    struct Entry {
+        Timestamp timestamp;
+        T sample;
+    };
+
+    using Buffer = CircularBuffer<Entry, BufferSize>;
+    using View = typename Buffer::template Spans<const Entry>;
+
+    // Append a sample, the oldest one is overwritten when full. false if timestamp goes backwards
+    bool push(Timestamp timestamp, const T& sample) {
+        if (!entries.is_empty() && timestamp < latest) {
+            return false;
+        }
+        latest = timestamp;
+        return entries.emplace(Entry{timestamp, sample});
+    }
+
+    // Entries with timestamp >= from
+    View since(Timestamp from) const {
+        return slice(entries.peek_spans(), lowerBound(from), entries.size());
+    }
+
+    // Entries with from <= timestamp <= to
+    View between(Timestamp from, Timestamp to) const {
+        if (to < from) {
+            return {};
+        }
+        return slice(entries.peek_spans(), lowerBound(from), upperBound(to));
+    }
+
+    // Release every entry older than timestamp, e.g. once it was replayed successfully. returns how many were dropped
+    std::size_t drop_before(Timestamp timestamp) {
+        return entries.commit(lowerBound(timestamp));
+    }
+
+    View all() const {
+        return entries.peek_spans();
+    }
+
+    std::size_t size() const {
+        return entries.size();
+    }
+
+    bool is_empty() const {
+        return entries.is_empty();
+    }
+
+private:
+    // Index (oldest first) of the first entry for which the predicate is false, searched span by span
+    template <typename Predicate>
+    std::size_t partitionPoint(Predicate before) const {
+        View spans = entries.peek_spans();
+        if (spans.second.empty() || !before(spans.first.back())) {
+            return std::partition_point(spans.first.begin(), spans.first.end(), before) - spans.first.begin();
+        }
+        return spans.first.size() +
+               (std::partition_point(spans.second.begin(), spans.second.end(), before) - spans.second.begin());
+    }
+
+    std::size_t lowerBound(Timestamp timestamp) const {
+        return partitionPoint([timestamp](const Entry& entry) { return entry.timestamp < timestamp; });
+    }
+
+    std::size_t upperBound(Timestamp timestamp) const {
+        return partitionPoint([timestamp](const Entry& entry) { return entry.timestamp <= timestamp; });
+    }
+
+    // Narrow the two spans to the logical index range [begin, end)
+    static View slice(View spans, std::size_t begin, std::size_t end) {
+        std::size_t split = spans.first.size();
+        auto clamp = [](std::size_t value, std::size_t low, std::size_t high) { return std::min(std::max(value, low), high); };
+        std::size_t firstBegin = clamp(begin, 0, split);
+        std::size_t firstEnd = clamp(end, firstBegin, split);
+        std::size_t secondBegin = clamp(begin, split, spans.size()) - split;
+        std::size_t secondEnd = clamp(end, split, spans.size()) - split;
+        return {spans.first.subspan(firstBegin, firstEnd - firstBegin),
+                spans.second.subspan(secondBegin, secondEnd - secondBegin)};
+    }
+
+    Buffer entries;
+    Timestamp latest{};
+};
@@ -0,0 +1,168 @@
+/**
+ * @file BlockAcquisition.hpp
+ * @brief ping-pong (double-buffered) block hand-off for continuous streams such as ADC continuous mode or I2S, where
+ * calling sensorRead() per sample cannot keep up. the driver (a DMA completion ISR or a driver task) fills one block
+ * while the processing task works on the other, then the two swap. the consumer sleeps until a block completes: a
+ * task notification on the ESP32, a condition variable on the host.
+ *
+ * every block carries the time the driver completed it and a sequence number. if the consumer still holds the other
+ * block when the driver completes one, there is nowhere to go: the completed block is dropped, the driver refills the
+ * same buffer and stats().overruns counts it. the consumer sees the drop as a gap in the sequence numbers.
+ *
+ *   driver ISR:  dma_set_target(acquisition.fillBuffer()) ... on block done: acquisition.complete();
+ *   processing:  while (auto block = acquisition.acquire(100ms)) { run(block->samples); acquisition.release(); }
+ *
+ * one producer and one consumer. complete() does not block nor allocate, and on the ESP32 it may be called from an ISR.
+ *
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <TimeService.hpp>
+#ifdef PLATFORM_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+template <typename T>
+struct AcquiredBlock {
+    std::span<const T> samples;
+    std::uint64_t timestampMicros; // When the driver completed the block, just after its last sample
+    std::uint32_t sequence;        // Counts every completed block, dropped ones included
+};
+
+struct AcquisitionStats {
+    std::uint32_t completed; // Blocks the driver finished
+    std::uint32_t delivered; // Blocks handed to the consumer
+    std::uint32_t overruns;  // Blocks dropped because the consumer still held the other buffer
+};
+
+template <typename T, std::size_t BlockSamples, typename Clock = time_service::DefaultClock>
+class BasicBlockAcquisition {
+    static_assert(BlockSamples > 0, "a block holds at least one sample");
+
+public:
+    static constexpr std::size_t kBlockSamples = BlockSamples;
+
+    BasicBlockAcquisition() = default;
+
+    BasicBlockAcquisition(const BasicBlockAcquisition&) = delete;
+    BasicBlockAcquisition& operator=(const BasicBlockAcquisition&) = delete;
+
+    // Producer side: the buffer to fill next, it stays the same until complete() hands it over
+    std::span<T, BlockSamples> fillBuffer() {
+        return blocks[published.load(std::memory_order_relaxed) % 2].samples;
+    }
+
+    // Producer side: the fill buffer is full. false if it was dropped because the consumer still holds the other one
+    bool complete() {
+        const std::uint32_t ready = published.load(std::memory_order_relaxed);
+        const std::uint32_t sequence = completed.load(std::memory_order_relaxed);
+        completed.store(sequence + 1, std::memory_order_relaxed);
+        if (ready != released.load(std::memory_order_acquire)) {
+            overruns.store(overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        Block& block = blocks[ready % 2];
+        block.timestampMicros = Clock::monotonicMicros();
+        block.sequence = sequence;
+        published.store(ready + 1); // seq_cst, pairs with the consumer storing its handle before it checks
+        notifyConsumer();
+        return true;
+    }
+
+    // Consumer side: the oldest completed block, waiting up to timeout for one. std::nullopt on timeout. the block
+    // stays valid, and the driver keeps off it, until release()
+    std::optional<AcquiredBlock<T>> acquire(std::chrono::microseconds timeout) {
+        const std::uint32_t taken = released.load(std::memory_order_relaxed);
+        if (!waitForBlock(taken, timeout)) {
+            return std::nullopt;
+        }
+        const Block& block = blocks[taken % 2];
+        return AcquiredBlock<T>{block.samples, block.timestampMicros, block.sequence};
+    }
+
+    // Consumer side: done with the block from acquire(), its buffer goes back to the driver
+    void release() {
+        released.store(released.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    AcquisitionStats stats() const {
+        return {completed.load(std::memory_order_relaxed), released.load(std::memory_order_relaxed),
+                overruns.load(std::memory_order_relaxed)};
+    }
+
+private:
+    struct Block {
+        alignas(16) std::array<T, BlockSamples> samples{}; // DMA on the ESP32 wants word-aligned targets
+        std::uint64_t timestampMicros{0};
+        std::uint32_t sequence{0};
+    };
+
+    // published - released is 0 (driver fills block published % 2, nothing waiting) or 1 (block released % 2 is with
+    // the consumer, the driver fills the other one)
+    bool waitForBlock(std::uint32_t taken, std::chrono::microseconds timeout) {
+        auto available = [&] { return published.load() != taken; };
+#ifdef PLATFORM_ESP32
+        consumer.store(xTaskGetCurrentTaskHandle());
+        const std::uint64_t deadline = Clock::monotonicMicros() + static_cast<std::uint64_t>(timeout.count());
+        while (!available()) {
+            const std::uint64_t now = Clock::monotonicMicros();
+            if (now >= deadline) {
+                return false;
+            }
+            // Round up so a short timeout still waits a tick, a stale notification only costs one more pass
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS((deadline - now + 999) / 1000) + 1);
+        }
+        return true;
+#else
+        std::unique_lock<std::mutex> lock(mtx);
+        return cv.wait_for(lock, timeout, available);
+#endif
+    }
+
+    void notifyConsumer() {
+#ifdef PLATFORM_ESP32
+        TaskHandle_t handle = consumer.load();
+        if (handle == nullptr) {
+            return; // Nobody waited yet, acquire() checks the sequence before sleeping
+        }
+        if (xPortInIsrContext()) {
+            BaseType_t woken = pdFALSE;
+            vTaskNotifyGiveFromISR(handle, &woken);
+            portYIELD_FROM_ISR(woken);
+        } else {
+            xTaskNotifyGive(handle);
+        }
+#else
+        {
+            // Empty critical section: a consumer between its check and its wait cannot miss the notify
+            std::lock_guard<std::mutex> lock(mtx);
+        }
+        cv.notify_one();
+#endif
+    }
+
+    std::array<Block, 2> blocks{};
+    std::atomic<std::uint32_t> published{0}; // Blocks handed over, written by the producer
+    std::atomic<std::uint32_t> released{0};  // Blocks given back, written by the consumer
+    std::atomic<std::uint32_t> completed{0};
+    std::atomic<std::uint32_t> overruns{0};
+#ifdef PLATFORM_ESP32
+    std::atomic<TaskHandle_t> consumer{nullptr};
+#else
+    std::mutex mtx;
+    std::condition_variable cv;
+#endif
+};
+
+template <typename T, std::size_t BlockSamples>
+using BlockAcquisition = BasicBlockAcquisition<T, BlockSamples, time_service::DefaultClock>;
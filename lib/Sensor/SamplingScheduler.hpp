@@ -0,0 +1,497 @@
+/**
+ * @file SamplingScheduler.hpp
+ * @brief one sampler task for every sensor instead of a task (and a stack) per sensor. sensors sit in an
+ * earliest-deadline-first heap keyed by their next sample time; the sampler pops every sensor that is due, calls its
+ * sensorRead() and pushes it back one period later, so a pass costs O(log n) per read, not a scan of all sensors.
+ *
+ * on the ESP32 the sampler sleeps on a task notification that an esp_timer one-shot gives at the next deadline, which
+ * wakes it with microsecond resolution rather than at the next FreeRTOS tick. on the host it sleeps on a condition
+ * variable. with start() not called, runDue() processes what is due on the calling task, so tests drive the scheduler
+ * with FakeClock and get the same sequence every time.
+ *
+ * deadlines advance by whole periods from the first one, so a late read does not shift the phase of later samples.
+ * per sensor the scheduler counts samples, jitter (how late a read started) and overruns (periods skipped because a
+ * read finished after its next deadline).
+ *
+ * isolation: a sensor added with a read budget (e.g. on an I2C bus that can hang) is not read on the sampler task.
+ * the sampler hands its read to one of SAMPLING_SCHEDULER_READERS reader tasks and moves on, so a read that never
+ * returns stalls that reader only, never the sampler nor the other sensors. a read still running when its budget runs
+ * out is a timeout; while it runs, the sensor's periods are skipped. timeouts and skipped periods are misses, and
+ * SENSOR_DEGRADED_MISSES of them in a row turn the sensor's SensorHealth DEGRADED until a read finishes on time.
+ * jitter of these sensors is taken when a reader starts the read, so time spent queued for a reader counts as jitter.
+ * a read past its budget may hold a reader for good: once SAMPLING_SCHEDULER_READERS of them have not returned, no
+ * read is handed over (it would only queue behind them) and the periods of every sensor with a budget are skipped as
+ * misses until one returns. give each bus that can hang its own reader. in step mode the handed-over reads wait for
+ * runReads().
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <semaphore>
+#include <thread>
+#include <vector>
+#include <EventLogger.hpp>
+#include <MpmcQueue.hpp>
+#include <TimeService.hpp>
+#include "Sensor.hpp"
+#ifdef PLATFORM_ESP32
+#include <esp_pthread.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+#ifndef SAMPLING_SCHEDULER_MAX_SENSORS
+#define SAMPLING_SCHEDULER_MAX_SENSORS 16
+#endif
+#ifndef SAMPLING_SCHEDULER_STACK
+#define SAMPLING_SCHEDULER_STACK 4096
+#endif
+#ifndef SAMPLING_SCHEDULER_CORE
+#define SAMPLING_SCHEDULER_CORE -1 // Any core, set 0 or 1 to pin the sampler
+#endif
+#ifndef SAMPLING_SCHEDULER_READERS
+#define SAMPLING_SCHEDULER_READERS 2 // Reader tasks for sensors with a read budget, started only if there are any
+#endif
+#ifndef SENSOR_DEGRADED_MISSES
+#define SENSOR_DEGRADED_MISSES 3
+#endif
+
+struct SamplingStats {
+    std::uint32_t samples;
+    std::uint32_t overruns;          // Sample periods skipped because a read finished after the next deadline, or
+                                     // with a read budget, was still running at it
+    std::uint32_t maxJitterMicros;   // Latest start of a read after its deadline, on the reader with a read budget
+    std::uint64_t totalJitterMicros;
+    std::uint32_t timeouts;          // Reads that took longer than the read budget
+    std::uint32_t consecutiveMisses; // Timeouts and skipped periods since the last read that finished on time
+
+    std::uint32_t meanJitterMicros() const {
+        return samples == 0 ? 0 : static_cast<std::uint32_t>(totalJitterMicros / samples);
+    }
+};
+
+template <typename Clock, std::size_t Capacity>
+class BasicSamplingScheduler {
+    static_assert(Capacity > 0 && Capacity <= 0xFFFF, "slots are stored as 16-bit indices");
+
+public:
+    static constexpr std::size_t kNoSlot = Capacity;
+    static constexpr std::uint64_t kNever = std::numeric_limits<std::uint64_t>::max();
+
+    static BasicSamplingScheduler& getInstance() {
+        static BasicSamplingScheduler instance; // Get the singleton instance
+        return instance;
+    }
+
+    BasicSamplingScheduler() = default;
+
+    ~BasicSamplingScheduler() {
+        stop();
+    }
+
+    BasicSamplingScheduler(const BasicSamplingScheduler&) = delete;
+    BasicSamplingScheduler& operator=(const BasicSamplingScheduler&) = delete;
+
+    // Before start(): schedules sensor every period, first read right away. a readBudget above 0 reads it on a reader
+    // task (see above). returns its slot for stats(), kNoSlot if Capacity sensors are scheduled already or period is
+    // 0. sensor must outlive the scheduler
+    std::size_t add(Sensor& sensor, std::chrono::microseconds period,
+                    std::chrono::microseconds readBudget = std::chrono::microseconds(0)) {
+        if (used == Capacity || period.count() <= 0 || period.count() > std::numeric_limits<std::uint32_t>::max() ||
+            readBudget.count() < 0) {
+            return kNoSlot;
+        }
+        const std::size_t slot = used;
+        sensors[slot] = &sensor;
+        healths[slot].bind(sensor, static_cast<std::uint16_t>(slot));
+        budgets[slot] = static_cast<std::uint64_t>(readBudget.count());
+        isolated += readBudget.count() > 0 ? 1 : 0;
+        heap[used++] = {Clock::monotonicMicros(), static_cast<std::uint32_t>(period.count()),
+                        static_cast<std::uint16_t>(slot)};
+        std::push_heap(heap.begin(), heap.begin() + used, later);
+        return slot;
+    }
+
+    std::size_t size() const {
+        return used;
+    }
+
+    // Read every sensor whose deadline has passed, returns the number of reads (handed to a reader or done here)
+    std::size_t runDue() {
+        std::size_t reads = 0;
+        std::uint64_t now = Clock::monotonicMicros();
+        expireReads(now);
+        while (used > 0 && heap[0].deadline <= now) {
+            Entry entry = heap[0];
+
+            std::uint64_t finished = now;
+            std::uint32_t skipped = 0;
+            bool didRead = true;
+            if (budgets[entry.slot] == 0) {
+                sensors[entry.slot]->sensorRead();
+                finished = Clock::monotonicMicros();
+                record(counters[entry.slot], now - entry.deadline);
+            } else if (!handOver(entry.slot, entry.deadline, now)) {
+                skipped = 1; // The previous read is still running, or every reader is held by one past its budget
+                miss(entry.slot);
+                didRead = false;
+            }
+
+            std::uint64_t next = entry.deadline + entry.period;
+            if (next <= finished) {
+                const auto late = static_cast<std::uint32_t>((finished - next) / entry.period + 1);
+                next += static_cast<std::uint64_t>(late) * entry.period;
+                skipped += late;
+            }
+            addOverruns(counters[entry.slot], skipped);
+            entry.deadline = next;
+            replaceTop(entry); // One sift-down instead of a pop and a push
+
+            now = finished;
+            reads += didRead ? 1 : 0;
+        }
+        updateHealth();
+        return reads;
+    }
+
+    // Step mode: run the reads handed over to readers on the calling task, returns how many ran
+    std::size_t runReads() {
+        std::size_t reads = 0;
+        while (std::optional<std::uint16_t> slot = readQueue.try_pop()) {
+            read(*slot);
+            ++reads;
+        }
+        return reads;
+    }
+
+    // Monotonic time of the next read, kNever without sensors
+    std::uint64_t nextDeadline() const {
+        return used > 0 ? heap[0].deadline : kNever;
+    }
+
+    // Readable from any task while the sampler runs
+    SamplingStats stats(std::size_t slot) const {
+        if (slot >= used) {
+            return {};
+        }
+        const Counters& counter = counters[slot];
+        return {counter.samples.load(std::memory_order_relaxed), counter.overruns.load(std::memory_order_relaxed),
+                counter.maxJitterMicros.load(std::memory_order_relaxed),
+                counter.totalJitterMicros.load(std::memory_order_relaxed),
+                counter.timeouts.load(std::memory_order_relaxed),
+                counter.consecutiveMisses.load(std::memory_order_relaxed)};
+    }
+
+    // Observe or waitFor() DEGRADED, e.g. to publish it. updated by the sampler, at its next pass after a change
+    const SensorHealth& health(std::size_t slot) const {
+        return healths[std::min(slot, Capacity - 1)];
+    }
+
+    // Run the sampler task, and the reader tasks if a sensor has a read budget. needs a real clock. until then
+    // runDue() and runReads() are left to the caller
+    void start() {
+        if (sampler.joinable()) {
+            return;
+        }
+        running.store(true, std::memory_order_relaxed);
+#ifdef PLATFORM_ESP32
+        // Above the connectivity tasks, a sample taken late is lost while a late publish is only late
+        esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+        cfg.thread_name = "sampler";
+        cfg.prio = 6;
+        cfg.stack_size = SAMPLING_SCHEDULER_STACK;
+        cfg.pin_to_core = SAMPLING_SCHEDULER_CORE < 0 ? tskNO_AFFINITY : SAMPLING_SCHEDULER_CORE;
+        esp_pthread_set_cfg(&cfg);
+#endif
+        sampler = std::thread(&BasicSamplingScheduler::samplerTask, this);
+#ifdef PLATFORM_ESP32
+        // Below the sampler, a stuck read must not hold it up
+        cfg.thread_name = "reader";
+        cfg.prio = 5;
+        esp_pthread_set_cfg(&cfg);
+#endif
+        for (std::size_t i = 0; isolated > 0 && i < SAMPLING_SCHEDULER_READERS; ++i) {
+            readers.emplace_back(&BasicSamplingScheduler::readerTask, this);
+        }
+#ifdef PLATFORM_ESP32
+        cfg = esp_pthread_get_default_config();
+        esp_pthread_set_cfg(&cfg);
+#endif
+    }
+
+    // Waits for reads in progress, a read that never returns keeps stop() waiting too
+    void stop() {
+        if (!sampler.joinable()) {
+            return;
+        }
+        running.store(false, std::memory_order_relaxed);
+        wake();
+        sampler.join();
+        readsQueued.release(static_cast<std::ptrdiff_t>(readers.size()));
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        readers.clear();
+    }
+
+private:
+    struct Entry {
+        std::uint64_t deadline;
+        std::uint32_t period;
+        std::uint16_t slot;
+    };
+
+    // samples, jitter and overruns have one writer at a time, the sampler or for a sensor with a read budget the reader
+    // running its read (handed over after the previous one), so plain loads and stores are enough for them
+    struct Counters {
+        std::atomic<std::uint32_t> samples{0};
+        std::atomic<std::uint32_t> overruns{0};
+        std::atomic<std::uint32_t> maxJitterMicros{0};
+        std::atomic<std::uint64_t> totalJitterMicros{0};
+        std::atomic<std::uint32_t> timeouts{0};
+        std::atomic<std::uint32_t> consecutiveMisses{0}; // Also reset by readers
+    };
+
+    // A read handed over is READING until it returns; the first of the reader (on return) and the sampler (budget ran
+    // out) to move it on from READING decides whether it timed out, and counts it
+    enum class ReadState : std::uint8_t { IDLE, READING, TIMED_OUT };
+
+    struct Read {
+        std::atomic<ReadState> state{ReadState::IDLE};
+        std::atomic<std::uint64_t> deadline{0};
+        std::atomic<std::uint64_t> expiry{0};
+    };
+
+    // Heap order: earliest deadline on top, ties by slot so the order of reads is reproducible
+    static bool later(const Entry& a, const Entry& b) {
+        return a.deadline != b.deadline ? a.deadline > b.deadline : a.slot > b.slot;
+    }
+
+    void replaceTop(const Entry& entry) {
+        std::size_t hole = 0;
+        while (true) {
+            std::size_t child = 2 * hole + 1;
+            if (child >= used) {
+                break;
+            }
+            if (child + 1 < used && later(heap[child], heap[child + 1])) {
+                ++child;
+            }
+            if (!later(entry, heap[child])) {
+                break;
+            }
+            heap[hole] = heap[child];
+            hole = child;
+        }
+        heap[hole] = entry;
+    }
+
+    static void record(Counters& counter, std::uint64_t jitterMicros) {
+        const auto jitter = static_cast<std::uint32_t>(std::min<std::uint64_t>(jitterMicros, 0xFFFFFFFF));
+        counter.samples.store(counter.samples.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        counter.totalJitterMicros.store(counter.totalJitterMicros.load(std::memory_order_relaxed) + jitter,
+                                        std::memory_order_relaxed);
+        if (jitter > counter.maxJitterMicros.load(std::memory_order_relaxed)) {
+            counter.maxJitterMicros.store(jitter, std::memory_order_relaxed);
+        }
+    }
+
+    static void addOverruns(Counters& counter, std::uint32_t skipped) {
+        if (skipped > 0) {
+            counter.overruns.store(counter.overruns.load(std::memory_order_relaxed) + skipped,
+                                   std::memory_order_relaxed);
+        }
+    }
+
+    void miss(std::size_t slot) {
+        counters[slot].consecutiveMisses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // false if the previous read of slot has not returned yet, or no reader is left to run it
+    bool handOver(std::uint16_t slot, std::uint64_t deadline, std::uint64_t now) {
+        if (inFlight[slot].state.load(std::memory_order_acquire) != ReadState::IDLE ||
+            overdueReads.load(std::memory_order_relaxed) >= SAMPLING_SCHEDULER_READERS) {
+            return false;
+        }
+        // Only the sampler leaves IDLE, the queue hands the stores to the reader
+        inFlight[slot].deadline.store(deadline, std::memory_order_relaxed);
+        inFlight[slot].expiry.store(now + budgets[slot], std::memory_order_relaxed);
+        inFlight[slot].state.store(ReadState::READING, std::memory_order_relaxed);
+        // Never full, a slot is queued at most once
+        readQueue.try_push(slot);
+        readsQueued.release();
+        return true;
+    }
+
+    // Count reads whose budget ran out while they still run
+    void expireReads(std::uint64_t now) {
+        for (std::size_t slot = 0; isolated > 0 && slot < used; ++slot) {
+            Read& pending = inFlight[slot];
+            ReadState reading = ReadState::READING;
+            if (pending.state.load(std::memory_order_relaxed) == ReadState::READING &&
+                now >= pending.expiry.load(std::memory_order_relaxed) &&
+                pending.state.compare_exchange_strong(reading, ReadState::TIMED_OUT, std::memory_order_acq_rel)) {
+                counters[slot].timeouts.fetch_add(1, std::memory_order_relaxed);
+                miss(slot);
+                overdueReads.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Earliest budget still running out, kNever if none
+    std::uint64_t nextExpiry() const {
+        std::uint64_t earliest = kNever;
+        for (std::size_t slot = 0; isolated > 0 && slot < used; ++slot) {
+            if (inFlight[slot].state.load(std::memory_order_relaxed) == ReadState::READING) {
+                earliest = std::min(earliest, inFlight[slot].expiry.load(std::memory_order_relaxed));
+            }
+        }
+        return earliest;
+    }
+
+    void read(std::uint16_t slot) {
+        Read& pending = inFlight[slot];
+        record(counters[slot], Clock::monotonicMicros() - pending.deadline.load(std::memory_order_relaxed));
+        sensors[slot]->sensorRead();
+        const std::uint64_t finished = Clock::monotonicMicros();
+        // Take the read back from the sampler, failing means it timed the read out already
+        ReadState reading = ReadState::READING;
+        if (!pending.state.compare_exchange_strong(reading, ReadState::TIMED_OUT, std::memory_order_acq_rel)) {
+            overdueReads.fetch_sub(1, std::memory_order_relaxed);
+        } else if (finished <= pending.expiry.load(std::memory_order_relaxed)) {
+            counters[slot].consecutiveMisses.store(0, std::memory_order_relaxed);
+        } else {
+            counters[slot].timeouts.fetch_add(1, std::memory_order_relaxed);
+            miss(slot);
+        }
+        pending.state.store(ReadState::IDLE, std::memory_order_release);
+    }
+
+    // Only the sampler changes health, so a reset by a reader and a miss by the sampler cannot race on the state
+    void updateHealth() {
+        for (std::size_t slot = 0; isolated > 0 && slot < used; ++slot) {
+            const std::uint32_t misses = counters[slot].consecutiveMisses.load(std::memory_order_relaxed);
+            const sensorState_t health = misses >= SENSOR_DEGRADED_MISSES ? sensorState_t::DEGRADED
+                                                                           : sensorState_t::HEALTHY;
+            if (healths[slot].getState() != health) {
+                if (health == sensorState_t::DEGRADED) {
+                    EVENT_LOG(WARN, Sensor, "%s degraded, %lu reads missed in a row", sensors[slot]->getId().c_str(),
+                              static_cast<unsigned long>(misses));
+                }
+                healths[slot].setState(health);
+            }
+            healths[slot].expireFlapWindow();
+        }
+    }
+
+    void readerTask() {
+        while (true) {
+            readsQueued.acquire();
+            if (!running.load(std::memory_order_relaxed)) {
+                return;
+            }
+            if (std::optional<std::uint16_t> slot = readQueue.try_pop()) {
+                read(*slot);
+            }
+        }
+    }
+
+    void samplerTask() {
+#ifdef PLATFORM_ESP32
+        samplerHandle.store(xTaskGetCurrentTaskHandle());
+        esp_timer_create_args_t args = {};
+        args.callback = &BasicSamplingScheduler::onTimer;
+        args.arg = this;
+        args.name = "sampler";
+        esp_timer_create(&args, &timer);
+#endif
+        while (running.load(std::memory_order_relaxed)) {
+            runDue();
+            sleepUntil(std::min(nextDeadline(), nextExpiry()));
+        }
+#ifdef PLATFORM_ESP32
+        esp_timer_stop(timer);
+        esp_timer_delete(timer);
+#endif
+    }
+
+    void sleepUntil(std::uint64_t deadline) {
+        const std::uint64_t now = Clock::monotonicMicros();
+        if (deadline <= now) {
+            return;
+        }
+#ifdef PLATFORM_ESP32
+        if (deadline != kNever) {
+            esp_timer_stop(timer); // Still armed if stop() woke the sampler first
+            esp_timer_start_once(timer, deadline - now);
+        }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#else
+        std::unique_lock<std::mutex> lock(mtx);
+        auto woken = [&] { return wakeRequested || !running.load(std::memory_order_relaxed); };
+        if (deadline == kNever) {
+            cv.wait(lock, woken);
+        } else {
+            cv.wait_for(lock, std::chrono::microseconds(deadline - now), woken);
+        }
+        wakeRequested = false;
+#endif
+    }
+
+    void wake() {
+#ifdef PLATFORM_ESP32
+        // Not set yet means the sampler has not checked running yet either
+        if (TaskHandle_t handle = samplerHandle.load(); handle != nullptr) {
+            xTaskNotifyGive(handle);
+        }
+#else
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            wakeRequested = true;
+        }
+        cv.notify_one();
+#endif
+    }
+
+#ifdef PLATFORM_ESP32
+    static void onTimer(void* arg) {
+        xTaskNotifyGive(static_cast<BasicSamplingScheduler*>(arg)->samplerHandle.load());
+    }
+
+    std::atomic<TaskHandle_t> samplerHandle{nullptr};
+    esp_timer_handle_t timer{nullptr};
+#else
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool wakeRequested{false};
+#endif
+
+    std::array<Entry, Capacity> heap{};
+    std::array<Sensor*, Capacity> sensors{};
+    std::array<std::uint64_t, Capacity> budgets{}; // Read budget in microseconds, 0 reads on the sampler
+    std::array<Counters, Capacity> counters{};
+    std::array<Read, Capacity> inFlight{};
+    std::array<SensorHealth, Capacity> healths{};
+    std::size_t used{0};
+    std::size_t isolated{0};                  // Sensors with a read budget
+    std::atomic<std::size_t> overdueReads{0}; // Timed out by the sampler and not returned yet
+    MpmcQueue<std::uint16_t, std::max<std::size_t>(2, std::bit_ceil(Capacity))> readQueue;
+    std::counting_semaphore<> readsQueued{0};
+    std::atomic<bool> running{false};
+    std::thread sampler;
+    std::vector<std::thread> readers;
+};
+
+using SamplingScheduler = BasicSamplingScheduler<time_service::DefaultClock, SAMPLING_SCHEDULER_MAX_SENSORS>;
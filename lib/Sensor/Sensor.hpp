@@ -1,8 +1,75 @@
 #pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <ComponentId.hpp>
+#include <EnumNames.hpp>
+#include <StatefulObject.hpp>
+
+#ifndef SENSOR_DEFAULT_PERIOD_MS
+#define SENSOR_DEFAULT_PERIOD_MS 1000
+#endif
+
+#define SENSOR_STATES(X) \
+    X(HEALTHY)           \
+    X(DEGRADED)
+
+enum class sensorState_t : std::uint8_t {
+    SENSOR_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(sensorState_t, SENSOR_STATES)
 
 class Sensor {
 public:
-    Sensor(std::string id) {
+    // readBudget 0: sensorRead() runs on the sampler task. above 0: it runs on a reader task, and a read that takes
+    // longer than readBudget is a miss, the sensor's later periods are skipped until it returns
+    Sensor(std::string id, std::chrono::microseconds samplePeriod = std::chrono::milliseconds(SENSOR_DEFAULT_PERIOD_MS),
+           std::chrono::microseconds readBudget = std::chrono::microseconds(0))
+        : id(std::move(id)), samplePeriod(samplePeriod), readBudget(readBudget) {
+    }
+
+    virtual ~Sensor() = default;
+
+    const std::string& getId() const {
+        return id;
+    }
+
+    // Interval at which the SamplingScheduler calls sensorRead()
+    std::chrono::microseconds getSamplePeriod() const {
+        return samplePeriod;
+    }
+
+    std::chrono::microseconds getReadBudget() const {
+        return readBudget;
+    }
+
+    // Take one sample, called once per period on the sampler task, keep it short, every sensor without a read budget
+    // shares that task. with a budget it is called on a reader task
+    virtual void sensorRead() {
+    }
+
+private:
+    std::string id;
+    std::chrono::microseconds samplePeriod;
+    std::chrono::microseconds readBudget;
+};
+
+// Health of one scheduled sensor, DEGRADED after SENSOR_DEGRADED_MISSES periods in a row without an on-time read.
+// one instance of the Sensor component per sensor: logged as "Sensor <id> -> <state>" and published with its slot as
+// detail
+class SensorHealth : public StatefulObjectLogged<sensorState_t> {
+public:
+    SensorHealth() : StatefulObjectLogged<sensorState_t>(componentId_t::Sensor, sensorState_t::HEALTHY) {
+    }
+
+    // Called by the scheduler when it adds sensor at slot
+    void bind(const Sensor& sensor, std::uint16_t slot) {
+        setInstance(sensor.getId(), slot);
+    }
 
+    std::uint16_t getSlot() const {
+        return static_cast<std::uint16_t>(getDetail());
     }
-};
\ No newline at end of file
+};
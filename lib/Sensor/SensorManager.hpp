@@ -1,12 +1,26 @@
 #pragma once
 #include <memory>
+#include <vector>
+#include <EventLogger.hpp>
+#include <SamplingScheduler.hpp>
 #include <Sensor.hpp>
 
 class SensorManager {
 public:
     SensorManager(std::vector<std::shared_ptr<Sensor>> sensorList): sensorList(sensorList) {}
 
-    void startAllSensorDataAcquisitionTasks() {}
+    // Every sensor is sampled on the one SamplingScheduler task, at its own period
+    void startAllSensorDataAcquisitionTasks() {
+        SamplingScheduler& scheduler = SamplingScheduler::getInstance();
+        for (const std::shared_ptr<Sensor>& sensor : sensorList) {
+            if (scheduler.add(*sensor, sensor->getSamplePeriod(), sensor->getReadBudget()) ==
+                SamplingScheduler::kNoSlot) {
+                EVENT_LOG(ERROR, SensorManager, "%s not scheduled, %u sensors at most", sensor->getId().c_str(),
+                          static_cast<unsigned>(SAMPLING_SCHEDULER_MAX_SENSORS));
+            }
+        }
+        scheduler.start();
+    }
 
 private:
     std::vector<std::shared_ptr<Sensor>> sensorList;
@@ -0,0 +1,84 @@
+/**
+ * @file SimulatedBlockSource.hpp
+ * @brief stand-in for a DMA driver: a thread that fills the BlockAcquisition fill buffer at a set sample rate and
+ * completes a block every BlockSamples / rate seconds, on absolute deadlines so the rate does not drift. lets the
+ * block path, its throughput and its overrun handling run on Linux without an ADC or I2S peripheral.
+ *
+ * samples come from a generator called with the running sample index, the default returns the index itself, so a
+ * consumer can check that every block continues where the last one ended.
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "BlockAcquisition.hpp"
+
+template <typename Acquisition>
+class SimulatedBlockSource {
+public:
+    using Sample = std::remove_cvref_t<decltype(std::declval<Acquisition&>().fillBuffer()[0])>;
+    using Generator = std::function<Sample(std::uint64_t sampleIndex)>;
+
+    SimulatedBlockSource(Acquisition& acquisition, double sampleRateHz,
+                         Generator generator = [](std::uint64_t index) { return static_cast<Sample>(index); })
+        : acquisition(acquisition), generator(std::move(generator)),
+          blockPeriod(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(static_cast<double>(Acquisition::kBlockSamples) / sampleRateHz))) {
+    }
+
+    ~SimulatedBlockSource() {
+        stop();
+    }
+
+    SimulatedBlockSource(const SimulatedBlockSource&) = delete;
+    SimulatedBlockSource& operator=(const SimulatedBlockSource&) = delete;
+
+    void start() {
+        if (driver.joinable()) {
+            return;
+        }
+        running.store(true, std::memory_order_relaxed);
+        driver = std::thread(&SimulatedBlockSource::driverTask, this);
+    }
+
+    void stop() {
+        if (!driver.joinable()) {
+            return;
+        }
+        running.store(false, std::memory_order_relaxed);
+        driver.join();
+    }
+
+    // Fill and complete one block right away, for tests that drive the source step by step
+    bool produceBlock() {
+        for (Sample& sample : acquisition.fillBuffer()) {
+            sample = generator(nextSample++);
+        }
+        return acquisition.complete();
+    }
+
+private:
+    void driverTask() {
+        auto deadline = std::chrono::steady_clock::now();
+        while (running.load(std::memory_order_relaxed)) {
+            deadline += blockPeriod;
+            std::this_thread::sleep_until(deadline);
+            // A dropped block is lost on real hardware too, its sample indices are skipped
+            produceBlock();
+        }
+    }
+
+    Acquisition& acquisition;
+    Generator generator;
+    std::chrono::steady_clock::duration blockPeriod;
+    std::uint64_t nextSample{0};
+    std::atomic<bool> running{false};
+    std::thread driver;
+};
@@ -0,0 +1,180 @@
+/**
+ * @file TimeService.hpp
+ * @brief monotonic tick source for hot paths, plus the mapping from ticks to wall-clock time once SNTP (or the RTC)
+ * has provided one.
+ *
+ * capture stores ticks only: microseconds since boot from esp_timer (a register read and a few adds), or a 32-bit
+ * millisecond tick where space matters. wall time is computed when data is serialized, from the sync point closest
+ * before the sample, so samples captured while offline get the right time once a sync happens later. ticks are only
+ * meaningful within one boot.
+ *
+ * the clock is a template parameter so the host build uses std::chrono::steady_clock and tests use FakeClock.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <sys/time.h>
+#ifdef PLATFORM_ESP32
+#include <esp_sntp.h>
+#include <esp_timer.h>
+#endif
+
+namespace time_service {
+
+#ifdef PLATFORM_ESP32
+struct EspTimerClock {
+    static std::uint64_t monotonicMicros() {
+        return static_cast<std::uint64_t>(esp_timer_get_time());
+    }
+};
+using DefaultClock = EspTimerClock;
+#else
+struct SteadyClock {
+    static std::uint64_t monotonicMicros() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+using DefaultClock = SteadyClock;
+#endif
+
+// Manually driven clock for tests, shared by every BasicTimeService<FakeClock>
+struct FakeClock {
+    static std::uint64_t monotonicMicros() {
+        return current.load(std::memory_order_relaxed);
+    }
+
+    static void set(std::uint64_t micros) {
+        current.store(micros, std::memory_order_relaxed);
+    }
+
+    static void advance(std::uint64_t micros) {
+        current.fetch_add(micros, std::memory_order_relaxed);
+    }
+
+    static inline std::atomic<std::uint64_t> current{0};
+};
+
+// Wall time (unix microseconds) observed at a given tick
+struct SyncPoint {
+    std::uint64_t ticks;
+    std::int64_t wallMicros;
+};
+
+constexpr std::int64_t kValidWallSeconds = 1577836800; // 2020-01-01, an unset RTC reports 1970
+
+} // namespace time_service
+
+template <typename Clock>
+class BasicTimeService {
+public:
+    static constexpr std::size_t kSyncHistory = 4;
+
+    static BasicTimeService& getInstance() {
+        static BasicTimeService instance; // Get the singleton instance
+        return instance;
+    }
+
+    BasicTimeService() = default;
+    BasicTimeService(const BasicTimeService&) = delete;
+    BasicTimeService& operator=(const BasicTimeService&) = delete;
+
+    // Monotonic microseconds since boot, the capture path
+    static std::uint64_t now() {
+        return Clock::monotonicMicros();
+    }
+
+    // Compact millisecond tick, wraps after ~49.7 days. use widen() to get back 64-bit ticks
+    static std::uint32_t now32() {
+        return static_cast<std::uint32_t>(now() / 1000);
+    }
+
+    // 64-bit ticks of a 32-bit tick taken at most ~49.7 days before reference
+    static std::uint64_t widen(std::uint32_t ticks32, std::uint64_t reference = now()) {
+        std::uint64_t referenceMillis = reference / 1000;
+        std::uint32_t age = static_cast<std::uint32_t>(referenceMillis) - ticks32;
+        return (referenceMillis - std::min<std::uint64_t>(age, referenceMillis)) * 1000;
+    }
+
+    // Record that wallMicros (unix time) was the wall-clock time at atTicks
+    void sync(std::int64_t wallMicros, std::uint64_t atTicks = now()) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (syncCount > 0 && atTicks < history[(syncCount - 1) % kSyncHistory].ticks) {
+            return; // Out of order, keep the history sorted by ticks
+        }
+        history[syncCount % kSyncHistory] = {atTicks, wallMicros};
+        ++syncCount;
+        synced.store(true, std::memory_order_release);
+    }
+
+    // Use the system clock if it already holds a plausible time, e.g. kept by the RTC across a software reset
+    bool syncFromSystemClock() {
+        timeval tv{};
+        if (gettimeofday(&tv, nullptr) != 0 || tv.tv_sec < time_service::kValidWallSeconds) {
+            return false;
+        }
+        sync(static_cast<std::int64_t>(tv.tv_sec) * 1000000 + tv.tv_usec);
+        return true;
+    }
+
+    // Forget every sync point, e.g. when the wall clock turned out to be wrong. conversions wait for the next sync
+    void reset() {
+        std::lock_guard<std::mutex> lock(mtx);
+        syncCount = 0;
+        synced.store(false, std::memory_order_release);
+    }
+
+    bool isSynced() const {
+        return synced.load(std::memory_order_acquire);
+    }
+
+    // Unix microseconds for ticks, using the latest sync at or before them (the earliest sync for older ticks)
+    std::optional<std::int64_t> toWallMicros(std::uint64_t ticks) const {
+        if (!isSynced()) {
+            return std::nullopt;
+        }
+        std::lock_guard<std::mutex> lock(mtx);
+        std::size_t kept = std::min(syncCount, kSyncHistory);
+        const time_service::SyncPoint* best = &history[(syncCount - kept) % kSyncHistory];
+        for (std::size_t i = syncCount - kept; i < syncCount; ++i) {
+            const time_service::SyncPoint& point = history[i % kSyncHistory];
+            if (point.ticks <= ticks) {
+                best = &point;
+            }
+        }
+        return best->wallMicros + (static_cast<std::int64_t>(ticks) - static_cast<std::int64_t>(best->ticks));
+    }
+
+#ifdef PLATFORM_ESP32
+    // Poll an SNTP server, every update is recorded as a sync point. safe to call on every reconnect, SNTP keeps
+    // polling on its own once started
+    void startSntp(const char* server = "pool.ntp.org") {
+        if (esp_sntp_enabled()) {
+            return;
+        }
+        syncFromSystemClock();
+        esp_sntp_setoperatingmode(ESP_SNTP_OPMODE_POLL);
+        esp_sntp_setservername(0, server);
+        sntp_set_time_sync_notification_cb([](timeval* tv) {
+            getInstance().sync(static_cast<std::int64_t>(tv->tv_sec) * 1000000 + tv->tv_usec);
+        });
+        esp_sntp_init();
+    }
+#endif
+
+private:
+    mutable std::mutex mtx;
+    std::array<time_service::SyncPoint, kSyncHistory> history{};
+    std::size_t syncCount{0};
+    std::atomic<bool> synced{false};
+};
+
+using TimeService = BasicTimeService<time_service::DefaultClock>;
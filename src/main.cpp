@@ -5,6 +5,7 @@
 #include <WifiManager.hpp>
 #include <MqttManager.hpp>
 #include <EventLogger.hpp>
+#include <TimeService.hpp>
 // #include <OtaManager.hpp>
 // #include <LedManager.hpp>
 // #include <SDCardFilesystem.hpp>
@@ -24,6 +25,9 @@ int main() {
     }
     ESP_ERROR_CHECK(ret);
 
+    // The RTC keeps wall-clock time across a software reset, SNTP takes over once Wi-Fi is up
+    TimeService::getInstance().syncFromSystemClock();
+
     WifiManager& wifiManager = WifiManager::getInstance();
     wifiManager.init();
     ESP_LOGI(MAIN_TAG, "========= Main End =========");
@@ -42,12 +46,13 @@ int main() {
     OtaManager& otaManager = OtaManager::getInstance();
     otaManager.start();
     if (otaManager.getState() == OtaState::Checking || otaManager.getState() == OtaState::Downloading) {
-        EventLogger::getInstance().logStateChange("OTA", "Checking for updates");
-        while (otaManager.getState() != OtaState::Idle && otaManager.getState() != OtaState::Success) {
-            // Wait for OTA process to complete
+        EventLogger::getInstance().logStateChange(componentId_t::OtaManager, otaManager.getState());
+        // Sleep through the OTA process instead of spinning on getState()
+        for (OtaState state = otaManager.getState(); state != OtaState::Idle && state != OtaState::Success;) {
+            state = otaManager.waitUntilChanged(state);
         }
         if (otaManager.getState() == OtaState::Success) {
-            EventLogger::getInstance().logStateChange("OTA", "Update successful, restarting");
+            EVENT_LOG(INFO, OtaManager, "update successful, restarting");
             return 0; // Restart the device after OTA update
         }
     }
@@ -55,10 +60,10 @@ int main() {
     // Check SD Card
     SDCardFilesystem& sdCard = SDCardFilesystem::getInstance();
     if (!sdCard.mount()) {
-        EventLogger::getInstance().logStateChange("SDCard", "Failed to mount");
+        EVENT_LOG(ERROR, SDCard, "failed to mount");
         LedManager::getInstance().setLEDMode(LedManager::LEDColor::RED, LedManager::LEDMode::BLINK, 500); // Warning: SD card issue
     } else {
-        EventLogger::getInstance().logStateChange("SDCard", "Mounted successfully");
+        EVENT_LOG(INFO, SDCard, "mounted successfully");
     }
 
     // Initialize SensorManager and activate sensors
@@ -88,7 +93,7 @@ int main() {
         redundancyDataStorage.publishStoredDataTask();
 
         // Log system state periodically
-        EventLogger::getInstance().logStateChange("System", "Running");
+        EVENT_LOG(DEBUG, System, "running");
 
         // Sleep for a short interval to avoid busy-waiting
         std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -0,0 +1,33 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+/**
+ * @brief tiny helpers shared by the benchmarks: a steady clock stopwatch and a uniform result line.
+ */
+namespace bench {
+
+class Stopwatch {
+public:
+    Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+
+    double elapsedSeconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Keep the optimizer from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void report(const char* name, std::uint64_t operations, double seconds) {
+    std::printf("[ BENCH    ] %-48s %12.0f ops/s %10.1f ns/op\n", name, operations / seconds, seconds * 1e9 / operations);
+}
+
+} // namespace bench
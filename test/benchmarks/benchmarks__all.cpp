@@ -0,0 +1,12 @@
+#include <gtest/gtest.h>
+
+/**
+ * Native-only micro benchmarks, run with `pio test -e bm_all`.
+ * Every benchmark is a plain gtest case that prints its numbers, so the same runner and filters apply.
+ * Absolute figures depend on the host, compare the rows of one run against each other.
+ */
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
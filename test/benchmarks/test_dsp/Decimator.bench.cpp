@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Decimator.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * decimating a 3-channel stream by 4 with a 31-tap low-pass, reported in input samples (all channels) per second.
+ * the reference keeps the samples interleaved, one struct per sample as Sensor<T> queues them, and runs a direct-form
+ * FIR per channel with a circular history, computing one dot product per output. the SoA path deinterleaves into a
+ * SampleFrame and runs FrameDecimator on the rows. int16_t is the Q15 variant of both.
+ */
+
+namespace {
+
+constexpr std::size_t kChannels = 3;
+constexpr std::size_t kFrameSamples = 256;
+constexpr std::size_t kTaps = 31;
+constexpr std::size_t kFactor = 4;
+constexpr std::size_t kFrames = 4000;
+
+struct Sample3 {
+    float axis[kChannels];
+};
+
+struct Sample3Q15 {
+    std::int16_t axis[kChannels];
+};
+
+template <typename T>
+std::array<T, kTaps> lowPassTaps(float scale) {
+    std::array<T, kTaps> taps{};
+    for (std::size_t k = 0; k < kTaps; ++k) {
+        const float t = static_cast<float>(k) - (kTaps - 1) / 2.0f;
+        const float sinc = t == 0 ? 0.25f : std::sin(0.25f * 3.14159265f * t) / (3.14159265f * t);
+        const float hann = 0.5f - 0.5f * std::cos(2 * 3.14159265f * static_cast<float>(k) / (kTaps - 1));
+        taps[k] = static_cast<T>(sinc * hann * scale);
+    }
+    return taps;
+}
+
+template <typename Sample, typename T, typename Acc>
+class InterleavedFir {
+public:
+    explicit InterleavedFir(const std::array<T, kTaps>& taps) : taps(taps) {
+    }
+
+    // Push one interleaved sample, every kFactor-th push writes an output sample
+    bool push(const Sample& in, Sample& out) {
+        history[head] = in;
+        head = (head + 1) % kTaps;
+        if (++phase < kFactor) {
+            return false;
+        }
+        phase = 0;
+        for (std::size_t c = 0; c < kChannels; ++c) {
+            Acc sum{};
+            for (std::size_t k = 0; k < kTaps; ++k) {
+                sum += static_cast<Acc>(taps[k]) * static_cast<Acc>(history[(head + kTaps - 1 - k) % kTaps].axis[c]);
+            }
+            if constexpr (std::is_same_v<T, float>) {
+                out.axis[c] = sum;
+            } else {
+                out.axis[c] = static_cast<std::int16_t>(std::clamp<Acc>((sum + (1 << 14)) >> 15, INT16_MIN, INT16_MAX));
+            }
+        }
+        return true;
+    }
+
+private:
+    std::array<T, kTaps> taps;
+    std::array<Sample, kTaps> history{};
+    std::size_t head{0};
+    std::size_t phase{0};
+};
+
+template <typename T>
+std::vector<T> interleavedStream() {
+    std::vector<T> stream(kFrameSamples * kChannels);
+    for (std::size_t i = 0; i < stream.size(); ++i) {
+        stream[i] = static_cast<T>(1000.0f * std::sin(0.01f * static_cast<float>(i)));
+    }
+    return stream;
+}
+
+template <typename Sample, typename T, typename Acc>
+void runInterleaved(const char* name, float tapScale) {
+    const std::vector<T> stream = interleavedStream<T>();
+    const auto* samples = reinterpret_cast<const Sample*>(stream.data());
+    InterleavedFir<Sample, T, Acc> fir(lowPassTaps<T>(tapScale));
+    Sample out{};
+    std::uint64_t outputs = 0;
+
+    bench::Stopwatch stopwatch;
+    for (std::size_t frame = 0; frame < kFrames; ++frame) {
+        for (std::size_t i = 0; i < kFrameSamples; ++i) {
+            outputs += fir.push(samples[i], out);
+        }
+        bench::doNotOptimize(out);
+    }
+    bench::report(name, kFrames * kFrameSamples * kChannels, stopwatch.elapsedSeconds());
+    bench::doNotOptimize(outputs);
+}
+
+template <typename T>
+void runFrames(const char* name, float tapScale) {
+    const std::vector<T> stream = interleavedStream<T>();
+    SampleFrame<T, kChannels, kFrameSamples> raw;
+    SampleFrame<T, kChannels, kFrameSamples / kFactor> reduced;
+    dsp::FrameDecimator<T, kChannels, kTaps, kFactor> decimator(lowPassTaps<T>(tapScale));
+
+    bench::Stopwatch stopwatch;
+    for (std::size_t frame = 0; frame < kFrames; ++frame) {
+        raw.deinterleave(stream);
+        decimator.process(raw, reduced);
+        bench::doNotOptimize(reduced.channel(0)[0]);
+    }
+    bench::report(name, kFrames * kFrameSamples * kChannels, stopwatch.elapsedSeconds());
+}
+
+} // namespace
+
+TEST(DecimatorBench, interleaved_fir_float) {
+    runInterleaved<Sample3, float, float>("interleaved AoS FIR /4, float", 1.0f);
+}
+
+TEST(DecimatorBench, soa_frame_fir_float) {
+    runFrames<float>("SoA frame FIR /4, float", 1.0f);
+}
+
+TEST(DecimatorBench, interleaved_fir_q15) {
+    runInterleaved<Sample3Q15, std::int16_t, std::int32_t>("interleaved AoS FIR /4, Q15", 32767.0f);
+}
+
+TEST(DecimatorBench, soa_frame_fir_q15) {
+    runFrames<std::int16_t>("SoA frame FIR /4, Q15", 32767.0f);
+}
+
+TEST(DecimatorBench, soa_frame_average_q15) {
+    const std::vector<std::int16_t> stream = interleavedStream<std::int16_t>();
+    SampleFrame<std::int16_t, kChannels, kFrameSamples> raw;
+    SampleFrame<std::int16_t, kChannels, kFrameSamples / kFactor> reduced;
+
+    bench::Stopwatch stopwatch;
+    for (std::size_t frame = 0; frame < kFrames; ++frame) {
+        raw.deinterleave(stream);
+        dsp::decimateAverage<kFactor>(raw, reduced);
+        bench::doNotOptimize(reduced.channel(0)[0]);
+    }
+    bench::report("SoA frame average /4, Q15", kFrames * kFrameSamples * kChannels, stopwatch.elapsedSeconds());
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <vector>
+#include "Fft.hpp"
+#include "SpectralFeatures.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * transforms per second for N = 256 to 4096. the reference is the textbook path: a complex radix-2 FFT of size N on the
+ * real samples (zero imaginary parts), twiddles from std::polar at run time and std::complex arithmetic throughout.
+ * RealFft does N/2 complex points with compile-time tables, then splits. the last line per size is the whole feature
+ * stage (mean removal, window, transform, bands, peaks) per window.
+ */
+
+namespace {
+
+constexpr std::size_t kTotalSamples = 1 << 22; // Same work per size, about 4M samples
+
+void referenceFft(std::vector<std::complex<float>>& a) {
+    const std::size_t n = a.size();
+    for (std::size_t i = 1, j = 0; i < n; ++i) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(a[i], a[j]);
+        }
+    }
+    for (std::size_t length = 2; length <= n; length <<= 1) {
+        const std::complex<float> step = std::polar(1.0f, -2 * 3.14159265f / static_cast<float>(length));
+        for (std::size_t start = 0; start < n; start += length) {
+            std::complex<float> w = 1.0f;
+            for (std::size_t j = 0; j < length / 2; ++j) {
+                const std::complex<float> u = a[start + j];
+                const std::complex<float> v = a[start + j + length / 2] * w;
+                a[start + j] = u + v;
+                a[start + j + length / 2] = u - v;
+                w *= step;
+            }
+        }
+    }
+}
+
+template <std::size_t N>
+std::vector<float> signal() {
+    std::vector<float> x(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        x[i] = std::sin(0.07f * static_cast<float>(i)) + 0.3f * std::sin(0.9f * static_cast<float>(i));
+    }
+    return x;
+}
+
+template <std::size_t N>
+void runSize() {
+    const std::vector<float> x = signal<N>();
+    const std::size_t rounds = kTotalSamples / N;
+    char name[64];
+
+    std::vector<std::complex<float>> reference(N);
+    bench::Stopwatch referenceWatch;
+    for (std::size_t round = 0; round < rounds; ++round) {
+        std::copy(x.begin(), x.end(), reference.begin());
+        referenceFft(reference);
+        bench::doNotOptimize(reference[1]);
+    }
+    std::snprintf(name, sizeof(name), "complex FFT N=%zu, runtime twiddles", N);
+    bench::report(name, rounds, referenceWatch.elapsedSeconds());
+
+    std::array<std::complex<float>, N / 2> data{};
+    bench::Stopwatch realWatch;
+    for (std::size_t round = 0; round < rounds; ++round) {
+        std::copy(x.begin(), x.end(), dsp::RealFft<N>::samples(data).begin());
+        dsp::RealFft<N>::transform(data);
+        bench::doNotOptimize(data[1]);
+    }
+    std::snprintf(name, sizeof(name), "RealFft N=%zu, constexpr tables", N);
+    bench::report(name, rounds, realWatch.elapsedSeconds());
+
+    dsp::SpectralFeatureExtractor<N, 8, 3> extractor(3200.0f);
+    bench::Stopwatch featureWatch;
+    for (std::size_t round = 0; round < rounds; ++round) {
+        bench::doNotOptimize(extractor.processWindow(std::span<const float, N>(x.data(), N)).peakHz[0]);
+    }
+    std::snprintf(name, sizeof(name), "features N=%zu, 8 bands 3 peaks", N);
+    bench::report(name, rounds, featureWatch.elapsedSeconds());
+}
+
+} // namespace
+
+TEST(FftBench, sizes_256_to_4096) {
+    runSize<256>();
+    runSize<512>();
+    runSize<1024>();
+    runSize<2048>();
+    runSize<4096>();
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Pipeline.hpp"
+#include "Stages.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * samples per second through each stage on its own, float and Q15, then the same recipe (biquad low-pass, RMS,
+ * min/max, threshold) composed two ways: the compile-time Pipeline, and a chain of heap-allocated stages behind a
+ * virtual process(float), the usual runtime-configurable design it replaces.
+ */
+
+namespace {
+
+constexpr std::size_t kSamples = 1024;
+constexpr std::size_t kRounds = 4000;
+
+template <typename T>
+std::vector<T> stream() {
+    std::vector<T> x(kSamples);
+    const float scale = std::is_same_v<T, float> ? 1.0f : 16000.0f;
+    for (std::size_t i = 0; i < kSamples; ++i) {
+        x[i] = static_cast<T>(scale * (0.6f * std::sin(0.02f * static_cast<float>(i)) +
+                                        0.3f * std::sin(1.1f * static_cast<float>(i))));
+    }
+    return x;
+}
+
+template <typename T, typename Stage>
+void runStage(const char* name, Stage stage) {
+    const std::vector<T> x = stream<T>();
+    bench::Stopwatch stopwatch;
+    for (std::size_t round = 0; round < kRounds; ++round) {
+        for (T sample : x) {
+            auto y = stage.process(sample);
+            bench::doNotOptimize(y);
+        }
+    }
+    bench::report(name, kRounds * kSamples, stopwatch.elapsedSeconds());
+}
+
+template <typename T>
+std::array<typename dsp::SampleTraits<T>::Coefficient, 16> firTaps() {
+    std::array<typename dsp::SampleTraits<T>::Coefficient, 16> taps{};
+    if constexpr (std::is_same_v<T, float>) {
+        taps.fill(1.0f / 16);
+    } else {
+        taps.fill(dsp::toQ15(1.0f / 16));
+    }
+    return taps;
+}
+
+const dsp::BiquadCoefficients<float> kLowPass = dsp::lowPassBiquad(1000.0f, 50.0f);
+
+// Runtime chain of the same recipe
+struct VirtualStage {
+    virtual ~VirtualStage() = default;
+    virtual float process(float sample) = 0;
+};
+
+template <typename Stage>
+struct VirtualAdapter : VirtualStage {
+    explicit VirtualAdapter(Stage stage) : stage(std::move(stage)) {
+    }
+
+    float process(float sample) override {
+        return static_cast<float>(stage.process(sample));
+    }
+
+    Stage stage;
+};
+
+template <typename Stage>
+std::unique_ptr<VirtualStage> makeVirtual(Stage stage) {
+    return std::make_unique<VirtualAdapter<Stage>>(std::move(stage));
+}
+
+} // namespace
+
+TEST(PipelineBench, stages_float) {
+    runStage<float>("MovingAverage<16>, float", dsp::MovingAverage<float, 16>{});
+    runStage<float>("Fir<16>, float", dsp::Fir<float, 16>(firTaps<float>()));
+    runStage<float>("Biquad, float", dsp::Biquad<float>(kLowPass));
+    runStage<float>("Rms<64>, float", dsp::Rms<float, 64>{});
+    runStage<float>("MinMax, float", dsp::MinMax<float>{});
+    runStage<float>("Threshold, float", dsp::Threshold<float>(0.5f, 0.3f));
+}
+
+TEST(PipelineBench, stages_q15) {
+    runStage<std::int16_t>("MovingAverage<16>, Q15", dsp::MovingAverage<std::int16_t, 16>{});
+    runStage<std::int16_t>("Fir<16>, Q15", dsp::Fir<std::int16_t, 16>(firTaps<std::int16_t>()));
+    runStage<std::int16_t>("Biquad, Q14", dsp::Biquad<std::int16_t>(dsp::toQ14(kLowPass)));
+    runStage<std::int16_t>("Rms<64>, Q15", dsp::Rms<std::int16_t, 64>{});
+    runStage<std::int16_t>("MinMax, Q15", dsp::MinMax<std::int16_t>{});
+    runStage<std::int16_t>("Threshold, Q15", dsp::Threshold<std::int16_t>(8000, 5000));
+}
+
+TEST(PipelineBench, composed_pipeline_float) {
+    runStage<float>("Pipeline biquad>rms>minmax>threshold, float",
+                    dsp::Pipeline{dsp::Biquad<float>(kLowPass), dsp::Rms<float, 64>{}, dsp::MinMax<float>{},
+                                  dsp::Threshold<float>(0.5f, 0.3f)});
+}
+
+TEST(PipelineBench, composed_pipeline_q15) {
+    runStage<std::int16_t>("Pipeline biquad>rms>minmax>threshold, Q15",
+                           dsp::Pipeline{dsp::Biquad<std::int16_t>(dsp::toQ14(kLowPass)),
+                                         dsp::Rms<std::int16_t, 64>{}, dsp::MinMax<std::int16_t>{},
+                                         dsp::Threshold<std::int16_t>(8000, 5000)});
+}
+
+TEST(PipelineBench, virtual_chain_float) {
+    std::vector<std::unique_ptr<VirtualStage>> chain;
+    chain.push_back(makeVirtual(dsp::Biquad<float>(kLowPass)));
+    chain.push_back(makeVirtual(dsp::Rms<float, 64>{}));
+    chain.push_back(makeVirtual(dsp::MinMax<float>{}));
+    chain.push_back(makeVirtual(dsp::Threshold<float>(0.5f, 0.3f)));
+    const std::vector<float> x = stream<float>();
+
+    bench::Stopwatch stopwatch;
+    for (std::size_t round = 0; round < kRounds; ++round) {
+        for (float sample : x) {
+            for (const auto& stage : chain) {
+                sample = stage->process(sample);
+            }
+            bench::doNotOptimize(sample);
+        }
+    }
+    bench::report("virtual chain biquad>rms>minmax>threshold, float", kRounds * kSamples,
+                  stopwatch.elapsedSeconds());
+}
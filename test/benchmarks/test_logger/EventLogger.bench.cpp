@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CircularBuffer.hpp"
+#include "EventLogger.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * logStateChange call cost with 4 tasks logging at once: the previous implementation (snprintf into a static
+ * buffer, output and std::string history under one mutex, reprint of the whole history once it is full), kept here
+ * with the console replaced by a no-op sink, against the deferred binary record path. UART time is not part of
+ * either number, on the device it only adds to the previous implementation.
+ *
+ * then the cost of a call the filters hold back (runtime level, token bucket, flap window) next to one that is logged,
+ * which is what a misbehaving component pays per event while it floods.
+ */
+
+#define BENCH_STATES(X) X(DISCONNECTED) X(CONNECTED)
+
+enum class benchState_t : std::uint16_t {
+    BENCH_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(benchState_t, BENCH_STATES)
+
+namespace {
+
+constexpr int kTasks = 4;
+constexpr std::uint64_t kCallsPerTask = 100'000;
+
+std::atomic<std::uint64_t> sinkBytes{0};
+
+void nullSink(const char* line) {
+    sinkBytes.fetch_add(line[0], std::memory_order_relaxed);
+}
+
+class LegacyEventLogger {
+public:
+    void logStateChange(const std::string& id, const std::string& state) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            static char buffer[64];
+            snprintf(buffer, sizeof(buffer), "[%s] %s -> %s", getCurrentTimestamp().c_str(), id.c_str(), state.c_str());
+            nullSink(buffer);
+            logs.push(std::string(buffer));
+        }
+
+        if (logs.is_max()) {
+            printLatestLogs();
+        }
+    }
+
+    void printLatestLogs() {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto spans = std::as_const(logs).peek_spans();
+        for (const auto& span : {spans.first, spans.second}) {
+            for (const std::string& log : span) {
+                nullSink(log.c_str());
+            }
+        }
+    }
+
+private:
+    std::string getCurrentTimestamp() const {
+        return "<timestamp_not_implemented>";
+    }
+
+    CircularBuffer<std::string, CIRCULAR_BUFFER_MAX_SIZE> logs;
+    std::mutex mtx;
+};
+
+// Sum of the time spent inside the calls only. Tasks yield between calls like real tasks that log now and then,
+// which also lets a drain keep up on a single core host
+template <typename Log>
+double runContended(Log log) {
+    std::atomic<bool> go{false};
+    std::atomic<std::int64_t> insideNs{0};
+    std::vector<std::thread> tasks;
+    for (int task = 0; task < kTasks; ++task) {
+        tasks.emplace_back([&] {
+            const std::string id = "WifiManager";
+            const std::string state = "CONNECTED";
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            std::chrono::nanoseconds inside{0};
+            for (std::uint64_t i = 0; i < kCallsPerTask; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                log(id, state);
+                inside += std::chrono::steady_clock::now() - start;
+                std::this_thread::yield();
+            }
+            insideNs.fetch_add(inside.count());
+        });
+    }
+
+    go.store(true, std::memory_order_release);
+    for (std::thread& task : tasks) {
+        task.join();
+    }
+    return insideNs.load() * 1e-9;
+}
+
+} // namespace
+
+TEST(EventLoggerBenchmark, log_state_change_under_4_contending_tasks) {
+    const std::uint64_t calls = kTasks * kCallsPerTask;
+
+    auto legacy = std::make_unique<LegacyEventLogger>();
+    bench::report("previous logStateChange, 4 tasks", calls,
+                  runContended([&](const std::string& id, const std::string& state) { legacy->logStateChange(id, state); }));
+
+    EventLogger& logger = EventLogger::getInstance();
+    logger.setLineSink(nullSink);
+    std::uint32_t droppedBefore = logger.droppedRecords();
+    // Stands in for the drain task running on the other core
+    std::atomic<bool> draining{true};
+    std::thread drain([&] {
+        while (draining.load(std::memory_order_relaxed)) {
+            logger.flush();
+            std::this_thread::yield();
+        }
+    });
+    bench::report("deferred logStateChange, 4 tasks", calls,
+                  runContended([&](const std::string& id, const std::string& state) { logger.logStateChange(id, state); }));
+    // Unfiltered, the same state over and over would otherwise be collapsed as flapping
+    logger.setFlapSuppression(componentId_t::WifiManager, 0, 0);
+    logger.setRateLimit(componentId_t::WifiManager, 0, 0);
+    bench::report("deferred logStateChange(componentId_t, enum)", calls,
+                  runContended([&](const std::string&, const std::string&) {
+                      logger.logStateChange(componentId_t::WifiManager, benchState_t::CONNECTED);
+                  }));
+    draining.store(false, std::memory_order_relaxed);
+    drain.join();
+    logger.setFlapSuppression(componentId_t::WifiManager, EVENT_LOGGER_FLAP_THRESHOLD, EVENT_LOGGER_FLAP_WINDOW_MS);
+    logger.setRateLimit(componentId_t::WifiManager, EVENT_LOGGER_RATE_PER_SECOND, EVENT_LOGGER_RATE_BURST);
+    logger.flush();
+    std::printf("[ BENCH    ] deferred path dropped %u of %llu records\n", logger.droppedRecords() - droppedBefore,
+                static_cast<unsigned long long>(2 * calls));
+    logger.setLineSink(nullptr);
+    bench::doNotOptimize(sinkBytes.load());
+}
+
+TEST(EventLoggerBenchmark, filtered_calls_while_component_floods) {
+    constexpr std::uint64_t kCalls = 1'000'000;
+    EventLogger& logger = EventLogger::getInstance();
+    logger.setLineSink(nullSink);
+
+    logger.setLevel(componentId_t::MqttManager, logLevel_t::WARN);
+    bench::Stopwatch levelWatch;
+    for (std::uint64_t i = 0; i < kCalls; ++i) {
+        EVENT_LOG(INFO, MqttManager, "publish %u ok", i);
+    }
+    bench::report("EVENT_LOG below component level", kCalls, levelWatch.elapsedSeconds());
+    logger.setLevel(componentId_t::MqttManager, logLevel_t::INFO);
+
+    logger.setRateLimit(componentId_t::OtaManager, 1, 1);
+    bench::Stopwatch rateWatch;
+    for (std::uint64_t i = 0; i < kCalls; ++i) {
+        EVENT_LOG(ERROR, OtaManager, "chunk %u rejected", i);
+    }
+    bench::report("EVENT_LOG over rate limit", kCalls, rateWatch.elapsedSeconds());
+    logger.setRateLimit(componentId_t::OtaManager, EVENT_LOGGER_RATE_PER_SECOND, EVENT_LOGGER_RATE_BURST);
+
+    logger.setFlapSuppression(componentId_t::SDCard, 3, 60'000);
+    bench::Stopwatch flapWatch;
+    for (std::uint64_t i = 0; i < kCalls; ++i) {
+        logger.logStateChange(componentId_t::SDCard, i % 2 == 0 ? benchState_t::CONNECTED : benchState_t::DISCONNECTED);
+    }
+    bench::report("logStateChange inside a flap window", kCalls, flapWatch.elapsedSeconds());
+    logger.setFlapSuppression(componentId_t::SDCard, EVENT_LOGGER_FLAP_THRESHOLD, EVENT_LOGGER_FLAP_WINDOW_MS);
+
+    logger.setRateLimit(componentId_t::System, 0, 0);
+    bench::Stopwatch loggedWatch;
+    for (std::uint64_t i = 0; i < kCalls; ++i) {
+        EVENT_LOG(INFO, System, "tick %u", i);
+        if (i % 8 == 0) {
+            logger.flush(); // Keep the ring from overflowing into the drop path
+        }
+    }
+    bench::report("EVENT_LOG logged (incl. drain every 8 calls)", kCalls, loggedWatch.elapsedSeconds());
+    logger.setRateLimit(componentId_t::System, EVENT_LOGGER_RATE_PER_SECOND, EVENT_LOGGER_RATE_BURST);
+
+    logger.flush();
+    logger.setLineSink(nullptr);
+    bench::doNotOptimize(sinkBytes.load());
+}
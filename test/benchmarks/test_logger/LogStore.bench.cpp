@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include "LogStore.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * LogStore append throughput for state change records, including rotation with a bounded footprint. runs against
+ * the host filesystem, so it shows the encoding and block buffering cost rather than SD card write speed.
+ */
+
+namespace {
+constexpr std::uint64_t kRecords = 500'000;
+} // namespace
+
+TEST(LogStoreBenchmark, append_state_changes_with_rotation) {
+    std::string directory = ::testing::TempDir() + "log_store_bench";
+    ::mkdir(directory.c_str(), 0755);
+    auto store = std::make_unique<LogStore>(LogStore::Config{directory, 64 * 1024, 8});
+
+    const char* states[] = {"CONNECTING", "CONNECTED", "DISCONNECTED"};
+    LogRecord record;
+    bench::Stopwatch stopwatch;
+    for (std::uint64_t i = 0; i < kRecords; ++i) {
+        log_record::capture(record, 1'000'000 + i * 250, "%s -> %s", "WifiManager", states[i % 3]);
+        store->append(record);
+    }
+    store->flush();
+    bench::report("LogStore::append, 64 KiB segments", kRecords, stopwatch.elapsedSeconds());
+
+    std::size_t segments = store->listSegments().size();
+    std::printf("[ BENCH    ] %zu segments kept, %u records lost\n", segments, store->lostRecords());
+    for (std::uint32_t sequence : store->listSegments()) {
+        std::remove(store->segmentPath(sequence).c_str());
+    }
+    store.reset();
+    ::rmdir(directory.c_str());
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ActiveObject.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * ActiveObject event throughput: components sharing two dispatcher tasks against the previous model of one thread per
+ * component, each waiting on its own mutex/condition_variable protected queue. a producer posts events round robin to
+ * every component, as the esp_event and MQTT client tasks do.
+ */
+
+#define BENCH_COUNTER_STATES(X) X(COUNTING)
+
+enum class benchCounterState_t : std::uint16_t {
+    BENCH_COUNTER_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(benchCounterState_t, BENCH_COUNTER_STATES)
+
+namespace {
+
+constexpr std::size_t kComponents = 8;
+constexpr std::uint64_t kEventsPerComponent = 200'000;
+
+constexpr StateHierarchy<benchCounterState_t> kCounterHierarchy{};
+
+class CountingObject : public ActiveObject<benchCounterState_t> {
+public:
+    explicit CountingObject(ActiveDispatcher& dispatcher)
+        : ActiveObject<benchCounterState_t>(componentId_t::System, kCounterHierarchy, benchCounterState_t::COUNTING,
+                                            dispatcher) {
+    }
+
+    ~CountingObject() override {
+        stop();
+    }
+
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> count{0};
+
+protected:
+    Reaction handle(benchCounterState_t, const ActiveEvent& event) override {
+        sum.store(sum.load(std::memory_order_relaxed) + event.param, std::memory_order_relaxed);
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        return handled();
+    }
+};
+
+class ThreadComponent {
+public:
+    ThreadComponent() : worker(&ThreadComponent::run, this) {
+    }
+
+    ~ThreadComponent() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_one();
+        worker.join();
+    }
+
+    void post(const ActiveEvent& event) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            events.push_back(event);
+        }
+        cv.notify_one();
+    }
+
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> count{0};
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            cv.wait(lock, [&] { return stopping || !events.empty(); });
+            if (events.empty()) {
+                return;
+            }
+            ActiveEvent event = events.front();
+            events.pop_front();
+            lock.unlock();
+            sum.store(sum.load(std::memory_order_relaxed) + event.param, std::memory_order_relaxed);
+            count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            lock.lock();
+        }
+    }
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<ActiveEvent> events;
+    bool stopping{false};
+    std::thread worker;
+};
+
+template <typename Component>
+void waitForAll(const std::vector<std::unique_ptr<Component>>& components) {
+    for (const auto& component : components) {
+        while (component->count.load(std::memory_order_acquire) < kEventsPerComponent) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace
+
+TEST(ActiveObjectBench, thread_per_component_queue) {
+    std::vector<std::unique_ptr<ThreadComponent>> components;
+    for (std::size_t i = 0; i < kComponents; ++i) {
+        components.push_back(std::make_unique<ThreadComponent>());
+    }
+
+    bench::Stopwatch stopwatch;
+    for (std::uint64_t i = 0; i < kEventsPerComponent; ++i) {
+        for (auto& component : components) {
+            component->post({0, static_cast<std::uint32_t>(i)});
+        }
+    }
+    waitForAll(components);
+    bench::report("thread per component, mutex queue", kComponents * kEventsPerComponent, stopwatch.elapsedSeconds());
+}
+
+TEST(ActiveObjectBench, active_objects_on_two_dispatchers) {
+    ActiveDispatcher dispatcher(2);
+    std::vector<std::unique_ptr<CountingObject>> components;
+    for (std::size_t i = 0; i < kComponents; ++i) {
+        components.push_back(std::make_unique<CountingObject>(dispatcher));
+    }
+
+    bench::Stopwatch stopwatch;
+    for (std::uint64_t i = 0; i < kEventsPerComponent; ++i) {
+        for (auto& component : components) {
+            while (!component->post({0, static_cast<std::uint32_t>(i)})) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    waitForAll(components);
+    bench::report("active objects, 2 dispatchers", kComponents * kEventsPerComponent, stopwatch.elapsedSeconds());
+}
+
+TEST(ActiveObjectBench, active_objects_step_mode) {
+    ActiveDispatcher dispatcher(0);
+    std::vector<std::unique_ptr<CountingObject>> components;
+    for (std::size_t i = 0; i < kComponents; ++i) {
+        components.push_back(std::make_unique<CountingObject>(dispatcher));
+    }
+
+    bench::Stopwatch stopwatch;
+    for (std::uint64_t i = 0; i < kEventsPerComponent; ++i) {
+        for (auto& component : components) {
+            component->post({0, static_cast<std::uint32_t>(i)});
+        }
+        dispatcher.runUntilIdle();
+    }
+    waitForAll(components);
+    bench::report("active objects, step mode", kComponents * kEventsPerComponent, stopwatch.elapsedSeconds());
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include "CircularBuffer.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * CircularBuffer storage layout: raw aligned slots against the previous std::array<std::optional<T>, N + 1> layout,
+ * kept here verbatim (minus logging) as the reference.
+ */
+
+namespace {
+
+template <typename T, std::size_t BufferSize>
+class OptionalSlotCircularBuffer {
+public:
+    bool push(T item) {
+        std::size_t next_head = (head_ + 1) % (BufferSize + 1);
+        if ((head_ + 1) % (BufferSize + 1) == tail_) {
+            tail_ = (tail_ + 1) % (BufferSize + 1);
+            --size_;
+        }
+        buffer_[head_] = std::move(item);
+        head_ = next_head;
+        ++size_;
+        return true;
+    }
+
+    std::optional<T> pop() {
+        if (head_ == tail_) {
+            return std::nullopt;
+        }
+        std::optional<T> item = std::move(buffer_[tail_]);
+        tail_ = (tail_ + 1) % (BufferSize + 1);
+        --size_;
+        return item;
+    }
+
+private:
+    std::array<std::optional<T>, BufferSize + 1> buffer_;
+    std::size_t head_ = 0;
+    std::size_t tail_ = 0;
+    std::size_t size_ = 0;
+};
+
+constexpr std::size_t kBufferSize = 30; // EventLogger's size
+constexpr std::uint64_t kRounds = 200'000;
+
+// Fill past capacity (exercising the overwrite path), then drain
+template <typename Buffer, typename Make>
+double runFillDrain(Buffer& buffer, Make make) {
+    bench::Stopwatch stopwatch;
+    for (std::uint64_t round = 0; round < kRounds; ++round) {
+        for (std::size_t i = 0; i < kBufferSize + 2; ++i) {
+            buffer.push(make(i));
+        }
+        while (auto item = buffer.pop()) {
+            bench::doNotOptimize(*item);
+        }
+    }
+    return stopwatch.elapsedSeconds();
+}
+
+} // namespace
+
+TEST(CircularBufferBenchmark, raw_slot_layout_against_optional_slot_layout) {
+    std::printf("[ BENCH    ] sizeof<int, 30>:         optional slots %zu B, raw slots %zu B\n",
+                sizeof(OptionalSlotCircularBuffer<int, kBufferSize>), sizeof(CircularBuffer<int, kBufferSize>));
+    std::printf("[ BENCH    ] sizeof<std::string, 30>: optional slots %zu B, raw slots %zu B\n",
+                sizeof(OptionalSlotCircularBuffer<std::string, kBufferSize>), sizeof(CircularBuffer<std::string, kBufferSize>));
+
+    const std::uint64_t operations = kRounds * (kBufferSize + 2);
+    auto makeInt = [](std::size_t i) { return static_cast<int>(i); };
+    auto makeString = [](std::size_t i) { return std::string("state change #") + char('a' + i % 26); };
+
+    auto optionalInts = std::make_unique<OptionalSlotCircularBuffer<int, kBufferSize>>();
+    auto rawInts = std::make_unique<CircularBuffer<int, kBufferSize>>();
+    bench::report("optional slots, int push+pop", operations, runFillDrain(*optionalInts, makeInt));
+    bench::report("raw slots, int push+pop", operations, runFillDrain(*rawInts, makeInt));
+
+    auto optionalStrings = std::make_unique<OptionalSlotCircularBuffer<std::string, kBufferSize>>();
+    auto rawStrings = std::make_unique<CircularBuffer<std::string, kBufferSize>>();
+    bench::report("optional slots, std::string push+pop", operations, runFillDrain(*optionalStrings, makeString));
+    bench::report("raw slots, std::string push+pop", operations, runFillDrain(*rawStrings, makeString));
+}
+
+// =============================================================
+
+namespace {
+
+std::uint64_t spillSink = 0;
+
+void spillToSink(int&& item) {
+    spillSink += item;
+}
+
+// Push into a full buffer, so every push goes through the overflow policy
+template <typename Buffer>
+double runOverflowPath(Buffer& buffer) {
+    for (std::size_t i = 0; i < kBufferSize; ++i) {
+        buffer.push(static_cast<int>(i));
+    }
+    bench::Stopwatch stopwatch;
+    for (std::uint64_t i = 0; i < kRounds * kBufferSize; ++i) {
+        bench::doNotOptimize(buffer.push(static_cast<int>(i)));
+    }
+    return stopwatch.elapsedSeconds();
+}
+
+// Push then pop with room available, the cost every policy pays on the happy path
+template <typename Buffer>
+double runHappyPath(Buffer& buffer) {
+    bench::Stopwatch stopwatch;
+    for (std::uint64_t i = 0; i < kRounds * kBufferSize; ++i) {
+        buffer.push(static_cast<int>(i));
+        bench::doNotOptimize(*buffer.pop());
+    }
+    return stopwatch.elapsedSeconds();
+}
+
+} // namespace
+
+TEST(CircularBufferBenchmark, overflow_policies) {
+    const std::uint64_t operations = kRounds * kBufferSize;
+
+    CircularBuffer<int, kBufferSize, overflow::OverwriteOldest> overwrite;
+    CircularBuffer<int, kBufferSize, overflow::RejectNewest> reject;
+    CircularBuffer<int, kBufferSize, overflow::SpillOldest<spillToSink>> spill;
+    CircularBuffer<int, kBufferSize, overflow::BlockWithTimeout<100>> block;
+
+    bench::report("full push, OverwriteOldest", operations, runOverflowPath(overwrite));
+    bench::report("full push, RejectNewest", operations, runOverflowPath(reject));
+    bench::report("full push, SpillOldest", operations, runOverflowPath(spill));
+    bench::doNotOptimize(spillSink);
+
+    overwrite.clear();
+    reject.clear();
+    spill.clear();
+    bench::report("push+pop with room, OverwriteOldest", operations, runHappyPath(overwrite));
+    bench::report("push+pop with room, RejectNewest", operations, runHappyPath(reject));
+    bench::report("push+pop with room, SpillOldest", operations, runHappyPath(spill));
+    bench::report("push+pop with room, BlockWithTimeout", operations, runHappyPath(block));
+}
+
+TEST(CircularBufferBenchmark, stats_policies) {
+    const std::uint64_t operations = kRounds * kBufferSize;
+
+    CircularBuffer<int, kBufferSize, overflow::OverwriteOldest, stats::None> plain;
+    CircularBuffer<int, kBufferSize, overflow::OverwriteOldest, stats::Atomic> instrumented;
+
+    bench::report("push+pop, stats::None", operations, runHappyPath(plain));
+    bench::report("push+pop, stats::Atomic", operations, runHappyPath(instrumented));
+    bench::doNotOptimize(instrumented.stats());
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "EventBus.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * EventBus with 1 to 16 subscribers: throughput of one publishing task, and latency from publish() to the handler of
+ * the last subscriber on the dispatcher task. Each subscriber filters on the component, like LedManager does.
+ */
+
+namespace {
+
+constexpr std::uint32_t kEvents = 100'000;
+
+struct FanOutResult {
+    double seconds;
+    std::vector<std::uint32_t> latenciesNs;
+};
+
+FanOutResult runFanOut(int subscriberCount) {
+    auto bus = std::make_unique<EventBus>();
+    std::vector<std::chrono::steady_clock::time_point> published(kEvents);
+    std::vector<std::uint32_t> latencies(kEvents);
+    std::atomic<std::uint32_t> delivered{0};
+
+    for (int s = 0; s < subscriberCount; ++s) {
+        bool last = s == subscriberCount - 1;
+        bus->subscribe(EventFilter::any().components(componentId_t::WifiManager), [&, last](const Event& event) {
+            if (last) {
+                auto latency = std::chrono::steady_clock::now() - published[event.detail];
+                latencies[event.detail] =
+                    static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+                delivered.fetch_add(1, std::memory_order_release);
+            }
+        });
+    }
+
+    bench::Stopwatch stopwatch;
+    for (std::uint32_t i = 0; i < kEvents; ++i) {
+        published[i] = std::chrono::steady_clock::now();
+        while (!bus->publish(Event::fault(componentId_t::WifiManager, 1, i))) {
+            std::this_thread::yield(); // Let the dispatcher catch up on a single core host
+        }
+        if ((i & 7) == 0) {
+            std::this_thread::yield(); // Bursts of 8, closer to how state changes arrive
+        }
+    }
+    while (delivered.load(std::memory_order_acquire) < kEvents) {
+        std::this_thread::yield();
+    }
+    return {stopwatch.elapsedSeconds(), std::move(latencies)};
+}
+
+std::uint32_t percentile(std::vector<std::uint32_t>& values, double p) {
+    std::size_t index = static_cast<std::size_t>(p * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+} // namespace
+
+TEST(EventBusBenchmark, fan_out_to_1_to_16_subscribers) {
+    for (int subscribers : {1, 2, 4, 8, 16}) {
+        FanOutResult result = runFanOut(subscribers);
+        char name[64];
+        std::snprintf(name, sizeof(name), "publish -> %2d subscribers", subscribers);
+        bench::report(name, kEvents, result.seconds);
+        std::printf("[ BENCH    ] %-48s p50 %6u ns  p99 %8u ns\n", "  publish-to-last-handler latency",
+                    percentile(result.latenciesNs, 0.50), percentile(result.latenciesNs, 0.99));
+    }
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "MpmcQueue.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * Producer scaling of MpmcQueue: 1 to 8 producers feeding a single drain thread, the SensorManager to
+ * SensorDataPublisher shape. Latency is the time a producer spends in its push loop, including retries while full.
+ */
+
+namespace {
+
+constexpr std::uint32_t kItemsPerProducer = 200'000;
+constexpr std::size_t kQueueSize = 1024;
+
+struct ScalingResult {
+    double seconds;
+    std::vector<std::uint32_t> latenciesNs;
+};
+
+ScalingResult runProducers(int producerCount) {
+    auto queue = std::make_unique<MpmcQueue<std::uint32_t, kQueueSize>>();
+    std::vector<std::vector<std::uint32_t>> latencies(producerCount);
+    const std::uint32_t total = producerCount * kItemsPerProducer;
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&, p] {
+            auto& samples = latencies[p];
+            samples.reserve(kItemsPerProducer);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::uint32_t i = 0; i < kItemsPerProducer; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                while (!queue->try_push(i)) {
+                    std::this_thread::yield();
+                }
+                samples.push_back(static_cast<std::uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+            }
+        });
+    }
+
+    bench::Stopwatch stopwatch;
+    go.store(true, std::memory_order_release);
+    std::uint64_t checksum = 0;
+    for (std::uint32_t received = 0; received < total;) {
+        if (auto item = queue->try_pop()) {
+            checksum += *item;
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    double seconds = stopwatch.elapsedSeconds();
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    bench::doNotOptimize(checksum);
+
+    ScalingResult result{seconds, {}};
+    for (auto& samples : latencies) {
+        result.latenciesNs.insert(result.latenciesNs.end(), samples.begin(), samples.end());
+    }
+    return result;
+}
+
+std::uint32_t percentile(std::vector<std::uint32_t>& samples, double fraction) {
+    auto nth = samples.begin() + static_cast<std::ptrdiff_t>(fraction * (samples.size() - 1));
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+}
+
+} // namespace
+
+TEST(MpmcQueueBenchmark, producer_scaling_with_single_consumer) {
+    std::printf("[ BENCH    ] %-10s %14s %10s %10s %10s\n", "producers", "ops/s", "p50 ns", "p99 ns", "p99.9 ns");
+    for (int producers : {1, 2, 4, 8}) {
+        auto result = runProducers(producers);
+        const double opsPerSecond = producers * kItemsPerProducer / result.seconds;
+        std::printf("[ BENCH    ] %-10d %14.0f %10u %10u %10u\n", producers, opsPerSecond,
+                    percentile(result.latenciesNs, 0.50), percentile(result.latenciesNs, 0.99),
+                    percentile(result.latenciesNs, 0.999));
+    }
+}
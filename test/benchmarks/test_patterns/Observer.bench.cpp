@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Observer.hpp"
+#include "Signal.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * notify cost with 4 observers: the previous Observable (shared_from_this() and a shared_ptr copy per observer per
+ * notification), kept here as the reference, against the Signal based Observable and a plain Signal
+ * with member function slots.
+ */
+
+namespace {
+
+constexpr std::uint64_t kNotifications = 2'000'000;
+constexpr int kObservers = 4;
+
+class LegacyObservable;
+
+class LegacyObserver {
+public:
+    virtual ~LegacyObserver() = default;
+    virtual void notify(std::weak_ptr<LegacyObservable> observable) = 0;
+};
+
+class LegacyObservable : public std::enable_shared_from_this<LegacyObservable> {
+public:
+    void addObserver(std::shared_ptr<LegacyObserver> observer) {
+        observerList.push_back(observer);
+    }
+
+    void notifyObservers() {
+        auto self = shared_from_this();
+        for (auto observer : observerList) {
+            observer->notify(self);
+        }
+    }
+
+private:
+    std::vector<std::shared_ptr<LegacyObserver>> observerList;
+};
+
+struct CountingLegacyObserver : LegacyObserver {
+    std::uint64_t count{0};
+
+    void notify(std::weak_ptr<LegacyObservable>) override {
+        ++count;
+    }
+};
+
+struct CountingObserver : Observer {
+    std::uint64_t count{0};
+
+    void notify(const std::weak_ptr<Observable>&) override {
+        ++count;
+    }
+};
+
+struct CountingSlot {
+    std::uint64_t count{0};
+
+    void onChanged(int) {
+        ++count;
+    }
+};
+
+} // namespace
+
+TEST(ObserverBenchmark, notify_4_observers) {
+    auto legacy = std::make_shared<LegacyObservable>();
+    std::vector<std::shared_ptr<CountingLegacyObserver>> legacyObservers;
+    for (int i = 0; i < kObservers; ++i) {
+        legacyObservers.push_back(std::make_shared<CountingLegacyObserver>());
+        legacy->addObserver(legacyObservers.back());
+    }
+    bench::Stopwatch legacyWatch;
+    for (std::uint64_t i = 0; i < kNotifications; ++i) {
+        legacy->notifyObservers();
+    }
+    bench::report("previous Observable::notifyObservers", kNotifications, legacyWatch.elapsedSeconds());
+
+    auto observable = std::make_shared<Observable>();
+    std::vector<std::shared_ptr<CountingObserver>> observers;
+    for (int i = 0; i < kObservers; ++i) {
+        observers.push_back(std::make_shared<CountingObserver>());
+        observable->addObserver(observers.back());
+    }
+    bench::Stopwatch observableWatch;
+    for (std::uint64_t i = 0; i < kNotifications; ++i) {
+        observable->notifyObservers();
+    }
+    bench::report("Signal based Observable::notifyObservers", kNotifications, observableWatch.elapsedSeconds());
+
+    Signal<int> signal;
+    std::array<CountingSlot, kObservers> slots;
+    std::array<Connection, kObservers> connections;
+    for (int i = 0; i < kObservers; ++i) {
+        connections[i] = signal.connect<&CountingSlot::onChanged>(slots[i]);
+    }
+    bench::Stopwatch signalWatch;
+    for (std::uint64_t i = 0; i < kNotifications; ++i) {
+        signal.emit(static_cast<int>(i));
+    }
+    bench::report("Signal<int>::emit, member slots", kNotifications, signalWatch.elapsedSeconds());
+
+    EXPECT_EQ(legacyObservers[0]->count, kNotifications);
+    EXPECT_EQ(observers[0]->count, kNotifications);
+    EXPECT_EQ(slots[0].count, kNotifications);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "CircularBuffer.hpp"
+#include "SpscRingBuffer.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * Producer/consumer hand-off throughput: SpscRingBuffer against a CircularBuffer guarded by a mutex, which is what
+ * every task pair had to do before. Both run the same two-thread loop over the same number of items.
+ */
+
+namespace {
+
+constexpr std::uint32_t kItemCount = 5'000'000;
+constexpr std::size_t kBufferSize = 256;
+
+// CircularBuffer overwrites when full, so the wrapper refuses the push instead to keep the comparison lossless
+class MutexCircularBuffer {
+public:
+    bool push(std::uint32_t item) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (buffer.is_max()) {
+            return false;
+        }
+        return buffer.push(item);
+    }
+
+    std::optional<std::uint32_t> pop() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return buffer.pop();
+    }
+
+private:
+    std::mutex mtx;
+    CircularBuffer<std::uint32_t, kBufferSize> buffer;
+};
+
+template <typename Buffer>
+double runHandOff(Buffer& buffer) {
+    bench::Stopwatch stopwatch;
+    std::thread producer([&] {
+        for (std::uint32_t i = 0; i < kItemCount; ++i) {
+            while (!buffer.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::uint64_t checksum = 0;
+    for (std::uint32_t received = 0; received < kItemCount;) {
+        if (auto item = buffer.pop()) {
+            checksum += *item;
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    bench::doNotOptimize(checksum);
+    return stopwatch.elapsedSeconds();
+}
+
+} // namespace
+
+TEST(SpscRingBufferBenchmark, hand_off_throughput_against_mutex_wrapped_circular_buffer) {
+    auto locked = std::make_unique<MutexCircularBuffer>();
+    auto lockFree = std::make_unique<SpscRingBuffer<std::uint32_t, kBufferSize>>();
+
+    bench::report("CircularBuffer + std::mutex (2 threads)", kItemCount, runHandOff(*locked));
+    bench::report("SpscRingBuffer (2 threads)", kItemCount, runHandOff(*lockFree));
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "StateMachine.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * StateMachine transition throughput: the constexpr table against the previous map based layout (unordered_map of
+ * vectors for validity, pair keyed callbacks). the previous code keyed an unordered_map by std::pair, which has no
+ * hash, so the reference uses std::map for the callbacks, the closest version of it that compiles.
+ */
+
+#define BENCH_LINK_STATES(X) X(DISCONNECTED) X(CONNECTING) X(CONNECTED) X(FAILED)
+
+enum class benchLinkState_t : std::uint16_t {
+    BENCH_LINK_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(benchLinkState_t, BENCH_LINK_STATES)
+
+namespace {
+
+constexpr std::uint64_t kTransitions = 10'000'000;
+
+struct Counter {
+    std::uint64_t actions{0};
+
+    static void count(Counter& counter, benchLinkState_t, benchLinkState_t) {
+        ++counter.actions;
+    }
+};
+
+constexpr StateMachine<benchLinkState_t, Counter>::Table kTable{
+    {
+        {benchLinkState_t::DISCONNECTED, benchLinkState_t::CONNECTING, &Counter::count},
+        {benchLinkState_t::CONNECTING, benchLinkState_t::CONNECTED, &Counter::count},
+        {benchLinkState_t::CONNECTING, benchLinkState_t::FAILED, &Counter::count},
+        {benchLinkState_t::CONNECTED, benchLinkState_t::DISCONNECTED, &Counter::count},
+        {benchLinkState_t::FAILED, benchLinkState_t::DISCONNECTED, &Counter::count},
+    },
+    {
+        {benchLinkState_t::CONNECTED, &Counter::count},
+    }};
+
+class MapStateMachine {
+public:
+    using StateChangeCallback = std::function<void(benchLinkState_t, benchLinkState_t)>;
+
+    explicit MapStateMachine(benchLinkState_t initialState) : currentState(initialState) {}
+
+    void registerStateTransition(benchLinkState_t from, benchLinkState_t to, StateChangeCallback callback) {
+        stateTransitions[from].push_back(to);
+        stateChangeCallbacks[{from, to}] = callback;
+    }
+
+    bool changeToState(benchLinkState_t newState) {
+        auto it = stateTransitions.find(currentState);
+        if (it == stateTransitions.end()) {
+            return false;
+        }
+        for (benchLinkState_t validState : it->second) {
+            if (validState == newState) {
+                benchLinkState_t oldState = currentState;
+                currentState = newState;
+                auto callbackIt = stateChangeCallbacks.find({oldState, newState});
+                if (callbackIt != stateChangeCallbacks.end()) {
+                    callbackIt->second(oldState, newState);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    benchLinkState_t currentState;
+    std::unordered_map<benchLinkState_t, std::vector<benchLinkState_t>> stateTransitions;
+    std::map<std::pair<benchLinkState_t, benchLinkState_t>, StateChangeCallback> stateChangeCallbacks;
+};
+
+// A connect cycle with one failed attempt, plus one rejected transition
+constexpr benchLinkState_t kCycle[] = {benchLinkState_t::CONNECTING, benchLinkState_t::FAILED,
+                                       benchLinkState_t::DISCONNECTED, benchLinkState_t::CONNECTING,
+                                       benchLinkState_t::CONNECTED, benchLinkState_t::FAILED,
+                                       benchLinkState_t::DISCONNECTED};
+
+} // namespace
+
+TEST(StateMachineBenchmark, transitions_per_second) {
+    MapStateMachine mapMachine(benchLinkState_t::DISCONNECTED);
+    std::uint64_t mapActions = 0;
+    auto count = [&](benchLinkState_t, benchLinkState_t) { ++mapActions; };
+    mapMachine.registerStateTransition(benchLinkState_t::DISCONNECTED, benchLinkState_t::CONNECTING, count);
+    mapMachine.registerStateTransition(benchLinkState_t::CONNECTING, benchLinkState_t::CONNECTED, count);
+    mapMachine.registerStateTransition(benchLinkState_t::CONNECTING, benchLinkState_t::FAILED, count);
+    mapMachine.registerStateTransition(benchLinkState_t::CONNECTED, benchLinkState_t::DISCONNECTED, count);
+    mapMachine.registerStateTransition(benchLinkState_t::FAILED, benchLinkState_t::DISCONNECTED, count);
+
+    bench::Stopwatch mapWatch;
+    std::uint64_t mapAccepted = 0;
+    for (std::uint64_t i = 0; i < kTransitions; ++i) {
+        mapAccepted += mapMachine.changeToState(kCycle[i % std::size(kCycle)]);
+    }
+    bench::report("previous map based changeToState", kTransitions, mapWatch.elapsedSeconds());
+
+    Counter counter;
+    StateMachine<benchLinkState_t, Counter> machine(kTable, counter, benchLinkState_t::DISCONNECTED);
+    bench::Stopwatch tableWatch;
+    std::uint64_t tableAccepted = 0;
+    for (std::uint64_t i = 0; i < kTransitions; ++i) {
+        tableAccepted += machine.changeToState(kCycle[i % std::size(kCycle)]);
+    }
+    bench::report("constexpr table changeToState", kTransitions, tableWatch.elapsedSeconds());
+
+    EXPECT_EQ(mapAccepted, tableAccepted);
+    bench::doNotOptimize(mapActions);
+    bench::doNotOptimize(counter.actions);
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "StatefulObject.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * cost of the residency statistics inside setState(): the same toggling StatefulObject with a named state enum
+ * (stats recorded) and with a plain integer state (NoStateStats, the previous behaviour).
+ */
+
+#define BENCH_TOGGLE_STATES(X) X(LOW) X(HIGH)
+
+enum class benchToggleState_t : std::uint16_t {
+    BENCH_TOGGLE_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(benchToggleState_t, BENCH_TOGGLE_STATES)
+
+namespace {
+
+constexpr std::uint64_t kChanges = 2'000'000;
+
+} // namespace
+
+TEST(StateStatsBench, set_state_without_stats) {
+    StatefulObject<std::uint16_t> toggle("toggle", 0);
+
+    bench::Stopwatch stopwatch;
+    for (std::uint64_t i = 0; i < kChanges; ++i) {
+        toggle.setState(static_cast<std::uint16_t>(i & 1));
+    }
+    bench::report("setState, no stats", kChanges, stopwatch.elapsedSeconds());
+    bench::doNotOptimize(toggle.getState());
+}
+
+TEST(StateStatsBench, set_state_with_stats) {
+    StatefulObject<benchToggleState_t> toggle("toggle", benchToggleState_t::LOW);
+
+    bench::Stopwatch stopwatch;
+    for (std::uint64_t i = 0; i < kChanges; ++i) {
+        toggle.setState(static_cast<benchToggleState_t>(i & 1));
+    }
+    bench::report("setState, residency stats", kChanges, stopwatch.elapsedSeconds());
+    bench::doNotOptimize(toggle.stateStats().entries(benchToggleState_t::HIGH));
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include "TimeSeriesBuffer.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * since(t) on a full, wrapped TimeSeriesBuffer: binary search against the linear scan it replaces.
+ */
+
+namespace {
+
+constexpr int kQueries = 20'000;
+
+template <std::size_t Entries>
+void runRangeLookups() {
+    using Series = TimeSeriesBuffer<float, Entries>;
+    auto series = std::make_unique<Series>();
+    // Overfill by a third so the buffered region wraps
+    const std::uint64_t pushed = Entries + Entries / 3;
+    for (std::uint64_t t = 0; t < pushed; ++t) {
+        series->push(t * 10, static_cast<float>(t));
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::uint64_t> pick((pushed - Entries) * 10, pushed * 10);
+    std::vector<std::uint64_t> queries(kQueries);
+    for (auto& query : queries) {
+        query = pick(rng);
+    }
+
+    std::size_t found = 0;
+    bench::Stopwatch binary;
+    for (auto query : queries) {
+        found += series->since(query).size();
+    }
+    double binarySeconds = binary.elapsedSeconds();
+
+    std::size_t scanned = 0;
+    bench::Stopwatch linear;
+    for (auto query : queries) {
+        auto all = series->all();
+        std::size_t count = 0;
+        for (const auto& span : {all.first, all.second}) {
+            for (const auto& entry : span) {
+                count += entry.timestamp >= query;
+            }
+        }
+        scanned += count;
+    }
+    double linearSeconds = linear.elapsedSeconds();
+    EXPECT_EQ(found, scanned);
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "since(t), %zu entries, binary search", Entries);
+    bench::report(name, kQueries, binarySeconds);
+    std::snprintf(name, sizeof(name), "since(t), %zu entries, linear scan", Entries);
+    bench::report(name, kQueries, linearSeconds);
+}
+
+} // namespace
+
+TEST(TimeSeriesBufferBenchmark, range_lookup_10k_to_100k_entries) {
+    runRangeLookups<10'000>();
+    runRangeLookups<30'000>();
+    runRangeLookups<100'000>();
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include "BlockAcquisition.hpp"
+#include "SpscRingBuffer.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * hand-off cost per sample between a driver and its consumer, both sides run in turn on one thread so only the
+ * hand-off is measured, not how the host schedules two threads. the reference hands every sample over on its own
+ * through an SpscRingBuffer, the per-sample path a polling sensor ends up with; the block path fills a 256-sample
+ * block in place and hands it over through BlockAcquisition.
+ */
+
+namespace {
+
+constexpr std::size_t kBlockSamples = 256;
+constexpr std::uint64_t kSamples = std::uint64_t{1} << 24;
+
+} // namespace
+
+TEST(BlockAcquisitionBench, per_sample_spsc_ring) {
+    SpscRingBuffer<std::int32_t, 1024> ring;
+    std::int64_t sum = 0;
+
+    bench::Stopwatch stopwatch;
+    for (std::uint64_t i = 0; i < kSamples; i += kBlockSamples) {
+        for (std::size_t n = 0; n < kBlockSamples; ++n) {
+            ring.push(static_cast<std::int32_t>(i + n));
+        }
+        while (std::optional<std::int32_t> sample = ring.pop()) {
+            sum += *sample;
+        }
+    }
+    bench::report("per-sample SPSC hand-off", kSamples, stopwatch.elapsedSeconds());
+    bench::doNotOptimize(sum);
+}
+
+TEST(BlockAcquisitionBench, ping_pong_blocks) {
+    BlockAcquisition<std::int32_t, kBlockSamples> acquisition;
+    std::int64_t sum = 0;
+
+    bench::Stopwatch stopwatch;
+    for (std::uint64_t i = 0; i < kSamples; i += kBlockSamples) {
+        std::int32_t next = static_cast<std::int32_t>(i);
+        for (std::int32_t& sample : acquisition.fillBuffer()) {
+            sample = next++;
+        }
+        acquisition.complete();
+        std::optional<AcquiredBlock<std::int32_t>> block = acquisition.acquire(std::chrono::microseconds(0));
+        for (std::int32_t sample : block->samples) {
+            sum += sample;
+        }
+        acquisition.release();
+    }
+    bench::report("ping-pong 256-sample blocks", kSamples, stopwatch.elapsedSeconds());
+    bench::doNotOptimize(sum);
+}
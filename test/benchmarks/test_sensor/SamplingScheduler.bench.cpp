@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include "SamplingScheduler.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * SamplingScheduler overhead with 128 virtual sensors over 10 s of FakeClock time: the EDF heap against a single
+ * sampler loop that scans every sensor for the earliest deadline, the simplest way to share one task. the clock jumps
+ * straight to the next deadline, so only scheduling cost is measured, sensorRead() is a counter. periods are 1 to
+ * 128 ms apart by odd microseconds, like independent sensors, so deadlines rarely coincide.
+ */
+
+namespace {
+
+constexpr std::size_t kSensors = 128;
+constexpr std::uint64_t kVirtualMicros = 10'000'000;
+
+struct VirtualSensor : Sensor {
+    VirtualSensor() : Sensor("virtual") {
+    }
+
+    void sensorRead() override {
+        ++reads;
+    }
+
+    std::uint64_t reads{0};
+};
+
+std::chrono::microseconds periodOf(std::size_t i) {
+    return std::chrono::microseconds(1000 + 997 * i);
+}
+
+} // namespace
+
+TEST(SamplingSchedulerBench, linear_scan_128_sensors) {
+    std::array<VirtualSensor, kSensors> sensors;
+    std::array<std::uint64_t, kSensors> deadlines{};
+    time_service::FakeClock::set(0);
+
+    bench::Stopwatch stopwatch;
+    std::uint64_t reads = 0;
+    while (time_service::FakeClock::monotonicMicros() < kVirtualMicros) {
+        std::uint64_t now = time_service::FakeClock::monotonicMicros();
+        std::uint64_t next = std::numeric_limits<std::uint64_t>::max();
+        for (std::size_t i = 0; i < kSensors; ++i) {
+            if (deadlines[i] <= now) {
+                sensors[i].sensorRead();
+                deadlines[i] += static_cast<std::uint64_t>(periodOf(i).count());
+                ++reads;
+            }
+            next = std::min(next, deadlines[i]);
+        }
+        time_service::FakeClock::set(next);
+    }
+    bench::report("linear scan, 128 sensors", reads, stopwatch.elapsedSeconds());
+    bench::doNotOptimize(sensors[0].reads);
+}
+
+TEST(SamplingSchedulerBench, edf_heap_128_sensors) {
+    std::array<VirtualSensor, kSensors> sensors;
+    BasicSamplingScheduler<time_service::FakeClock, kSensors> scheduler;
+    time_service::FakeClock::set(0);
+    for (std::size_t i = 0; i < kSensors; ++i) {
+        scheduler.add(sensors[i], periodOf(i));
+    }
+
+    bench::Stopwatch stopwatch;
+    std::uint64_t reads = 0;
+    while (time_service::FakeClock::monotonicMicros() < kVirtualMicros) {
+        reads += scheduler.runDue();
+        time_service::FakeClock::set(scheduler.nextDeadline());
+    }
+    bench::report("EDF heap, 128 sensors", reads, stopwatch.elapsedSeconds());
+    bench::doNotOptimize(sensors[0].reads);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <ctime>
+#include <string>
+#include "TimeService.hpp"
+#include "../Benchmark.hpp"
+
+/**
+ * capture cost of a timestamp: TimeService ticks against formatting wall time on the spot (the approach sketched in
+ * EventLogger::getCurrentTimestamp), plus the deferred tick-to-wall conversion done at serialization.
+ */
+
+namespace {
+constexpr std::uint64_t kCalls = 2'000'000;
+} // namespace
+
+TEST(TimeServiceBenchmark, capture_cost) {
+    bench::Stopwatch ticks;
+    for (std::uint64_t i = 0; i < kCalls; ++i) {
+        bench::doNotOptimize(TimeService::now());
+    }
+    bench::report("TimeService::now()", kCalls, ticks.elapsedSeconds());
+
+    bench::Stopwatch compact;
+    for (std::uint64_t i = 0; i < kCalls; ++i) {
+        bench::doNotOptimize(TimeService::now32());
+    }
+    bench::report("TimeService::now32()", kCalls, compact.elapsedSeconds());
+
+    const std::uint64_t formatCalls = kCalls / 10;
+    bench::Stopwatch formatted;
+    for (std::uint64_t i = 0; i < formatCalls; ++i) {
+        std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::tm local{};
+        localtime_r(&now, &local);
+        char text[32];
+        std::strftime(text, sizeof(text), "%Y-%m-%d %X", &local);
+        std::string timestamp(text);
+        bench::doNotOptimize(timestamp);
+    }
+    bench::report("system_clock + localtime + strftime string", formatCalls, formatted.elapsedSeconds());
+
+    TimeService& service = TimeService::getInstance();
+    service.sync(1'790'000'000LL * 1'000'000);
+    bench::Stopwatch conversion;
+    for (std::uint64_t i = 0; i < formatCalls; ++i) {
+        bench::doNotOptimize(service.toWallMicros(i));
+    }
+    bench::report("toWallMicros() at serialization", formatCalls, conversion.elapsedSeconds());
+}
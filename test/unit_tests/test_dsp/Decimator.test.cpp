@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Decimator.hpp"
+
+/**
+ * TEST CASES
+ * DecimateAverageTest
+ * - should_average_each_group_when_decimating_float
+ * - should_truncate_toward_zero_when_decimating_int16
+ * - should_decimate_every_channel_when_given_a_frame
+ * FirDecimatorTest
+ * - should_match_direct_convolution_when_fed_in_uneven_blocks
+ * - should_match_direct_convolution_when_block_exceeds_max_block
+ * - should_round_and_saturate_when_filtering_q15
+ * - should_filter_channels_independently_when_decimating_a_frame
+ */
+
+namespace {
+
+// Direct form reference: y[m] = sum over k of taps[k] * x[m * factor + factor - 1 - k], x before the start is 0
+template <typename Tap>
+std::vector<double> referenceFir(const std::vector<double>& x, const std::vector<Tap>& taps, std::size_t factor,
+                                 double tapScale = 1.0) {
+    std::vector<double> y;
+    for (std::size_t end = factor - 1; end < x.size(); end += factor) {
+        double sum = 0;
+        for (std::size_t k = 0; k < taps.size() && k <= end; ++k) {
+            sum += static_cast<double>(taps[k]) / tapScale * x[end - k];
+        }
+        y.push_back(sum);
+    }
+    return y;
+}
+
+std::vector<float> signal(std::size_t length) {
+    std::vector<float> x(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        x[i] = std::sin(0.05f * static_cast<float>(i)) + 0.25f * std::sin(1.3f * static_cast<float>(i));
+    }
+    return x;
+}
+
+constexpr std::array<float, 7> kTaps{0.02f, 0.08f, 0.2f, 0.4f, 0.2f, 0.08f, 0.02f};
+
+} // namespace
+
+TEST(DecimateAverageTest, should_average_each_group_when_decimating_float) {
+    const std::vector<float> in{1, 2, 3, 4, 10, 20, 30, 40, 7};
+    std::vector<float> out(4, -1);
+
+    EXPECT_EQ(dsp::decimateAverage<4>(std::span<const float>(in), std::span<float>(out)), 2u);
+
+    EXPECT_FLOAT_EQ(out[0], 2.5f);
+    EXPECT_FLOAT_EQ(out[1], 25.0f);
+    EXPECT_FLOAT_EQ(out[2], -1.0f);
+}
+
+TEST(DecimateAverageTest, should_truncate_toward_zero_when_decimating_int16) {
+    const std::vector<std::int16_t> in{32767, 32767, -3, -4, 1, 2};
+    std::vector<std::int16_t> out(3);
+
+    dsp::decimateAverage<2>(std::span<const std::int16_t>(in), std::span<std::int16_t>(out));
+
+    EXPECT_EQ(out, (std::vector<std::int16_t>{32767, -3, 1}));
+}
+
+TEST(DecimateAverageTest, should_decimate_every_channel_when_given_a_frame) {
+    SampleFrame<std::int16_t, 2, 8> raw;
+    std::vector<std::int16_t> fifo;
+    for (std::int16_t i = 0; i < 8; ++i) {
+        fifo.push_back(i);
+        fifo.push_back(static_cast<std::int16_t>(-10 * i));
+    }
+    raw.deinterleave(fifo, 99);
+    SampleFrame<std::int16_t, 2, 2> reduced;
+
+    dsp::decimateAverage<4>(raw, reduced);
+
+    EXPECT_EQ(reduced.size(), 2u);
+    EXPECT_EQ(reduced.channel(0)[1], 5);   // (4 + 5 + 6 + 7) / 4
+    EXPECT_EQ(reduced.channel(1)[0], -15); // -(0 + 10 + 20 + 30) / 4
+    EXPECT_EQ(reduced.getFirstSampleTicks(), 99u);
+}
+
+// =============================================================
+
+TEST(FirDecimatorTest, should_match_direct_convolution_when_fed_in_uneven_blocks) {
+    const std::vector<float> x = signal(300);
+    dsp::FirDecimator<float, 7, 3> decimator(kTaps);
+    std::vector<float> y(100);
+
+    std::size_t written = 0;
+    std::size_t consumed = 0;
+    for (std::size_t block : {3u, 30u, 9u, 150u, 108u}) {
+        written += decimator.process(std::span<const float>(x).subspan(consumed, block),
+                                     std::span<float>(y).subspan(written));
+        consumed += block;
+    }
+
+    const std::vector<double> expected = referenceFir(std::vector<double>(x.begin(), x.end()),
+                                                      std::vector<float>(kTaps.begin(), kTaps.end()), 3);
+    ASSERT_EQ(written, expected.size());
+    for (std::size_t m = 0; m < expected.size(); ++m) {
+        EXPECT_NEAR(y[m], expected[m], 1e-5) << "output " << m;
+    }
+}
+
+TEST(FirDecimatorTest, should_match_direct_convolution_when_block_exceeds_max_block) {
+    const std::vector<float> x = signal(3 * DSP_MAX_BLOCK + 40);
+    dsp::FirDecimator<float, 7, 4> decimator(kTaps);
+    std::vector<float> y(x.size() / 4);
+
+    EXPECT_EQ(decimator.process(x, y), y.size());
+
+    const std::vector<double> expected = referenceFir(std::vector<double>(x.begin(), x.end()),
+                                                      std::vector<float>(kTaps.begin(), kTaps.end()), 4);
+    for (std::size_t m = 0; m < y.size(); ++m) {
+        EXPECT_NEAR(y[m], expected[m], 1e-5) << "output " << m;
+    }
+}
+
+TEST(FirDecimatorTest, should_round_and_saturate_when_filtering_q15) {
+    // 0.5 and 0.75 in Q15: a full-scale step overflows int16 and must clip instead of wrapping
+    const std::array<std::int16_t, 2> taps{16384, 24576};
+    dsp::FirDecimator<std::int16_t, 2, 1> decimator(taps);
+    const std::vector<std::int16_t> x{1000, 3, 32767, 32767, -32768, -32768};
+    std::vector<std::int16_t> y(x.size());
+
+    decimator.process(x, y);
+
+    EXPECT_EQ(y[0], 500);   // 0.5 * 1000
+    EXPECT_EQ(y[1], 752);   // 0.5 * 3 + 0.75 * 1000 = 751.5, rounded half up
+    EXPECT_EQ(y[3], 32767); // 1.25 * 32767 clips
+    EXPECT_EQ(y[5], -32768);
+}
+
+TEST(FirDecimatorTest, should_filter_channels_independently_when_decimating_a_frame) {
+    const std::vector<float> x = signal(64);
+    std::vector<float> fifo;
+    for (float sample : x) {
+        fifo.push_back(sample);
+        fifo.push_back(-2.0f * sample);
+    }
+    SampleFrame<float, 2, 32> raw;
+    SampleFrame<float, 2, 16> reduced;
+    dsp::FrameDecimator<float, 2, 7, 2> decimator(kTaps);
+    std::vector<float> firstChannel;
+
+    for (std::size_t frame = 0; frame < 2; ++frame) {
+        raw.deinterleave(std::span<const float>(fifo).subspan(frame * 64, 64));
+        decimator.process(raw, reduced);
+        for (std::size_t m = 0; m < reduced.size(); ++m) {
+            EXPECT_FLOAT_EQ(reduced.channel(1)[m], -2.0f * reduced.channel(0)[m]);
+            firstChannel.push_back(reduced.channel(0)[m]);
+        }
+    }
+
+    const std::vector<double> expected = referenceFir(std::vector<double>(x.begin(), x.end()),
+                                                      std::vector<float>(kTaps.begin(), kTaps.end()), 2);
+    ASSERT_EQ(firstChannel.size(), expected.size());
+    for (std::size_t m = 0; m < expected.size(); ++m) {
+        EXPECT_NEAR(firstChannel[m], expected[m], 1e-5);
+    }
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "Fft.hpp"
+
+/**
+ * TEST CASES
+ * RealFftTest
+ * - should_match_direct_dft_when_transforming_small_size
+ * - should_match_direct_dft_when_transforming_large_size
+ * - should_pack_dc_and_nyquist_into_first_bin_when_transforming
+ * FftTablesTest
+ * - should_match_std_sin_when_tables_are_generated_at_compile_time
+ * - should_be_symmetric_and_zero_at_start_when_hann_window_is_generated
+ */
+
+namespace {
+
+// Direct O(N^2) DFT in double, bins 0..N/2
+std::vector<std::complex<double>> directDft(const std::vector<float>& x) {
+    const std::size_t n = x.size();
+    std::vector<std::complex<double>> bins(n / 2 + 1);
+    for (std::size_t k = 0; k <= n / 2; ++k) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const double angle = -2 * M_PI * static_cast<double>(k * i % n) / static_cast<double>(n);
+            bins[k] += static_cast<double>(x[i]) * std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+    }
+    return bins;
+}
+
+template <std::size_t N>
+void expectMatchesDft(double tolerance) {
+    std::array<std::complex<float>, N / 2> data{};
+    std::span<float, N> samples = dsp::RealFft<N>::samples(data);
+    std::vector<float> x(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        x[i] = std::sin(0.3f * static_cast<float>(i)) + 0.5f * std::cos(2.1f * static_cast<float>(i)) +
+               static_cast<float>(i % 7) * 0.1f;
+        samples[i] = x[i];
+    }
+
+    dsp::RealFft<N>::transform(data);
+
+    const std::vector<std::complex<double>> expected = directDft(x);
+    EXPECT_NEAR(data[0].real(), expected[0].real(), tolerance);
+    EXPECT_NEAR(data[0].imag(), expected[N / 2].real(), tolerance);
+    for (std::size_t k = 1; k < N / 2; ++k) {
+        EXPECT_NEAR(data[k].real(), expected[k].real(), tolerance) << "bin " << k;
+        EXPECT_NEAR(data[k].imag(), expected[k].imag(), tolerance) << "bin " << k;
+    }
+}
+
+} // namespace
+
+TEST(RealFftTest, should_match_direct_dft_when_transforming_small_size) {
+    expectMatchesDft<4>(1e-5);
+    expectMatchesDft<8>(1e-5);
+    expectMatchesDft<64>(1e-4);
+}
+
+TEST(RealFftTest, should_match_direct_dft_when_transforming_large_size) {
+    expectMatchesDft<1024>(2e-3);
+}
+
+TEST(RealFftTest, should_pack_dc_and_nyquist_into_first_bin_when_transforming) {
+    std::array<std::complex<float>, 4> data{};
+    const std::array<float, 8> x{3, 1, 3, 1, 3, 1, 3, 1}; // DC 2 plus alternating 1
+    std::copy(x.begin(), x.end(), dsp::RealFft<8>::samples(data).begin());
+
+    dsp::RealFft<8>::transform(data);
+
+    EXPECT_FLOAT_EQ(data[0].real(), 16.0f); // Sum of samples
+    EXPECT_FLOAT_EQ(data[0].imag(), 8.0f);  // Alternating sum
+    for (std::size_t k = 1; k < 4; ++k) {
+        EXPECT_NEAR(std::abs(data[k]), 0.0f, 1e-6) << "bin " << k;
+    }
+}
+
+// =============================================================
+
+TEST(FftTablesTest, should_match_std_sin_when_tables_are_generated_at_compile_time) {
+    static_assert(dsp::detail::sinConstexpr(0.0) == 0.0);
+    for (double x = -20.0; x < 20.0; x += 0.173) {
+        EXPECT_NEAR(dsp::detail::sinConstexpr(x), std::sin(x), 1e-12) << x;
+        EXPECT_NEAR(dsp::detail::cosConstexpr(x), std::cos(x), 1e-12) << x;
+    }
+}
+
+TEST(FftTablesTest, should_be_symmetric_and_zero_at_start_when_hann_window_is_generated) {
+    constexpr std::array<float, 16> window = dsp::hannWindow<16>();
+
+    EXPECT_NEAR(window[0], 0.0f, 1e-7f);
+    EXPECT_FLOAT_EQ(window[8], 1.0f);
+    for (std::size_t n = 1; n < 16; ++n) {
+        EXPECT_FLOAT_EQ(window[n], window[16 - n]) << n;
+    }
+}
@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Pipeline.hpp"
+#include "Stages.hpp"
+
+/**
+ * TEST CASES
+ * StagesTest
+ * - should_match_window_mean_when_moving_average_runs_past_its_window
+ * - should_truncate_toward_zero_when_moving_average_is_q15
+ * - should_match_direct_convolution_when_fir_filters_float
+ * - should_round_and_saturate_when_fir_filters_q15
+ * - should_match_difference_equation_when_biquad_filters_float
+ * - should_track_float_biquad_when_biquad_is_q14
+ * - should_match_window_rms_when_rms_runs_past_its_window
+ * - should_keep_range_and_pass_samples_through_when_min_max_runs
+ * - should_switch_once_per_crossing_when_threshold_sees_noise_in_hysteresis_band
+ * PipelineTest
+ * - should_chain_stages_in_order_when_processing_a_sample
+ * - should_match_stages_run_one_by_one_when_processing_a_block
+ * - should_clear_every_stage_when_reset
+ */
+
+namespace {
+
+std::vector<float> signal(std::size_t length) {
+    std::vector<float> x(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        x[i] = 0.5f * std::sin(0.05f * static_cast<float>(i)) + 0.25f * std::sin(1.3f * static_cast<float>(i));
+    }
+    return x;
+}
+
+std::vector<std::int16_t> toQ15(const std::vector<float>& x) {
+    std::vector<std::int16_t> q(x.size());
+    std::transform(x.begin(), x.end(), q.begin(), [](float value) { return dsp::toQ15(value); });
+    return q;
+}
+
+// References, in double over the whole history, x before the start is 0
+double windowMean(const std::vector<double>& x, std::size_t n, std::size_t window) {
+    double sum = 0;
+    for (std::size_t k = 0; k < window && k <= n; ++k) {
+        sum += x[n - k];
+    }
+    return sum / static_cast<double>(window);
+}
+
+double windowRms(const std::vector<double>& x, std::size_t n, std::size_t window) {
+    double sum = 0;
+    for (std::size_t k = 0; k < window && k <= n; ++k) {
+        sum += x[n - k] * x[n - k];
+    }
+    return std::sqrt(sum / static_cast<double>(window));
+}
+
+std::vector<double> directBiquad(const std::vector<double>& x, const dsp::BiquadCoefficients<float>& c) {
+    std::vector<double> y(x.size());
+    double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+    for (std::size_t n = 0; n < x.size(); ++n) {
+        y[n] = c.b0 * x[n] + c.b1 * x1 + c.b2 * x2 - c.a1 * y1 - c.a2 * y2;
+        x2 = x1;
+        x1 = x[n];
+        y2 = y1;
+        y1 = y[n];
+    }
+    return y;
+}
+
+constexpr std::array<float, 7> kTaps{0.02f, 0.08f, 0.2f, 0.4f, 0.2f, 0.08f, 0.02f};
+
+} // namespace
+
+TEST(StagesTest, should_match_window_mean_when_moving_average_runs_past_its_window) {
+    const std::vector<float> x = signal(500);
+    const std::vector<double> reference(x.begin(), x.end());
+    dsp::MovingAverage<float, 16> average;
+
+    for (std::size_t n = 0; n < x.size(); ++n) {
+        EXPECT_NEAR(average.process(x[n]), windowMean(reference, n, 16), 1e-6) << "sample " << n;
+    }
+}
+
+TEST(StagesTest, should_truncate_toward_zero_when_moving_average_is_q15) {
+    dsp::MovingAverage<std::int16_t, 4> average;
+
+    EXPECT_EQ(average.process(32767), 8191); // Zeros before the start count
+    average.process(32767);
+    average.process(32767);
+    EXPECT_EQ(average.process(32767), 32767); // No overflow in the int32 sum
+    average.process(-3);
+    average.process(-3);
+    average.process(-3);
+    EXPECT_EQ(average.process(-2), -2); // -11 / 4
+}
+
+TEST(StagesTest, should_match_direct_convolution_when_fir_filters_float) {
+    const std::vector<float> x = signal(100);
+    dsp::Fir<float, 7> fir(kTaps);
+
+    for (std::size_t n = 0; n < x.size(); ++n) {
+        double expected = 0;
+        for (std::size_t k = 0; k < kTaps.size() && k <= n; ++k) {
+            expected += kTaps[k] * static_cast<double>(x[n - k]);
+        }
+        EXPECT_NEAR(fir.process(x[n]), expected, 1e-6) << "sample " << n;
+    }
+}
+
+TEST(StagesTest, should_round_and_saturate_when_fir_filters_q15) {
+    // 0.5 and 0.75 in Q15: a full-scale step overflows int16 and must clip instead of wrapping
+    dsp::Fir<std::int16_t, 2> fir({16384, 24576});
+
+    EXPECT_EQ(fir.process(1000), 500);
+    EXPECT_EQ(fir.process(3), 752); // 0.5 * 3 + 0.75 * 1000 = 751.5, rounded half up
+    fir.process(32767);
+    EXPECT_EQ(fir.process(32767), 32767);
+    fir.process(-32768);
+    EXPECT_EQ(fir.process(-32768), -32768);
+}
+
+TEST(StagesTest, should_match_difference_equation_when_biquad_filters_float) {
+    const std::vector<float> x = signal(400);
+    const dsp::BiquadCoefficients<float> c = dsp::lowPassBiquad(1000.0f, 40.0f);
+    const std::vector<double> expected = directBiquad(std::vector<double>(x.begin(), x.end()), c);
+    dsp::Biquad<float> biquad(c);
+
+    for (std::size_t n = 0; n < x.size(); ++n) {
+        EXPECT_NEAR(biquad.process(x[n]), expected[n], 1e-5) << "sample " << n;
+    }
+    // Unity gain at DC, the 1.3 rad/sample component is gone
+    for (int i = 0; i < 400; ++i) {
+        biquad.process(0.25f);
+    }
+    EXPECT_NEAR(biquad.process(0.25f), 0.25f, 1e-4);
+}
+
+TEST(StagesTest, should_track_float_biquad_when_biquad_is_q14) {
+    const std::vector<float> x = signal(400);
+    const dsp::BiquadCoefficients<float> c = dsp::lowPassBiquad(1000.0f, 40.0f);
+    const std::vector<std::int16_t> q = toQ15(x);
+    dsp::Biquad<float> reference(c);
+    dsp::Biquad<std::int16_t> biquad(dsp::toQ14(c));
+
+    for (std::size_t n = 0; n < x.size(); ++n) {
+        const float expected = reference.process(x[n]);
+        // Q14 coefficients and 16-bit state: a few LSB of 1 / 32768
+        EXPECT_NEAR(biquad.process(q[n]) / 32768.0f, expected, 2e-3f) << "sample " << n;
+    }
+}
+
+TEST(StagesTest, should_match_window_rms_when_rms_runs_past_its_window) {
+    const std::vector<float> x = signal(300);
+    const std::vector<std::int16_t> q = toQ15(x);
+    const std::vector<double> reference(x.begin(), x.end());
+    const std::vector<double> referenceQ15(q.begin(), q.end());
+    dsp::Rms<float, 32> rms;
+    dsp::Rms<std::int16_t, 32> rmsQ15;
+
+    for (std::size_t n = 0; n < x.size(); ++n) {
+        EXPECT_NEAR(rms.process(x[n]), windowRms(reference, n, 32), 1e-5) << "sample " << n;
+        EXPECT_NEAR(rmsQ15.process(q[n]), windowRms(referenceQ15, n, 32), 1.0) << "sample " << n;
+    }
+}
+
+TEST(StagesTest, should_keep_range_and_pass_samples_through_when_min_max_runs) {
+    dsp::MinMax<std::int16_t> range;
+
+    EXPECT_EQ(range.process(5), 5);
+    EXPECT_EQ(range.process(-7), -7);
+    range.process(3);
+
+    EXPECT_EQ(range.min(), -7);
+    EXPECT_EQ(range.max(), 5);
+    range.reset();
+    range.process(1);
+    EXPECT_EQ(range.min(), 1);
+    EXPECT_EQ(range.max(), 1);
+}
+
+TEST(StagesTest, should_switch_once_per_crossing_when_threshold_sees_noise_in_hysteresis_band) {
+    dsp::Threshold<float> threshold(1.0f, 0.5f);
+    const std::vector<float> x{0.2f, 1.0f, 0.9f, 1.1f, 0.6f, 1.2f, 0.5f, 0.9f, 0.4f, 1.5f};
+    const std::vector<bool> expected{false, true, true, true, true, true, false, false, false, true};
+
+    for (std::size_t n = 0; n < x.size(); ++n) {
+        EXPECT_EQ(threshold.process(x[n]), expected[n]) << "sample " << n;
+    }
+    EXPECT_EQ(threshold.crossings(), 2u);
+}
+
+// =============================================================
+
+TEST(PipelineTest, should_chain_stages_in_order_when_processing_a_sample) {
+    dsp::Pipeline recipe{dsp::MovingAverage<float, 2>{}, dsp::MinMax<float>{}, dsp::Threshold<float>(3.0f, 1.0f)};
+
+    EXPECT_FALSE(recipe.process(4.0f)); // Average 2
+    EXPECT_TRUE(recipe.process(4.0f));  // Average 4
+    EXPECT_TRUE(recipe.process(0.0f));  // Average 2, still above low
+    EXPECT_FALSE(recipe.process(0.0f));
+
+    EXPECT_EQ(decltype(recipe)::size(), 3u);
+    EXPECT_FLOAT_EQ(recipe.stage<1>().max(), 4.0f);
+    EXPECT_FLOAT_EQ(recipe.stage<1>().min(), 0.0f);
+    EXPECT_EQ(recipe.stage<2>().crossings(), 1u);
+}
+
+TEST(PipelineTest, should_match_stages_run_one_by_one_when_processing_a_block) {
+    const std::vector<std::int16_t> x = toQ15(signal(256));
+    const auto c = dsp::toQ14(dsp::lowPassBiquad(1000.0f, 100.0f));
+    dsp::Pipeline recipe{dsp::Fir<std::int16_t, 2>({16384, 16384}), dsp::Biquad<std::int16_t>(c),
+                         dsp::Rms<std::int16_t, 8>{}};
+    dsp::Fir<std::int16_t, 2> fir({16384, 16384});
+    dsp::Biquad<std::int16_t> biquad(c);
+    dsp::Rms<std::int16_t, 8> rms;
+    std::vector<std::int16_t> y(x.size());
+
+    EXPECT_EQ(recipe.process(std::span<const std::int16_t>(x), std::span<std::int16_t>(y)), x.size());
+
+    for (std::size_t n = 0; n < x.size(); ++n) {
+        EXPECT_EQ(y[n], rms.process(biquad.process(fir.process(x[n])))) << "sample " << n;
+    }
+}
+
+TEST(PipelineTest, should_clear_every_stage_when_reset) {
+    dsp::Pipeline recipe{dsp::MovingAverage<float, 4>{}, dsp::Threshold<float>(0.5f, 0.1f)};
+    recipe.process(4.0f);
+
+    recipe.reset();
+
+    EXPECT_EQ(recipe.stage<1>().crossings(), 0u);
+    EXPECT_FALSE(recipe.process(1.0f)); // Average 0.25, no 4 left in the window
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "SampleFrame.hpp"
+
+/**
+ * TEST CASES
+ * SampleFrameTest
+ * - should_align_every_channel_row_when_frame_is_created
+ * - should_sort_samples_into_channel_rows_when_deinterleaving
+ * - should_take_at_most_frame_size_when_input_is_longer
+ * - should_restore_original_order_when_interleaving_again
+ */
+
+TEST(SampleFrameTest, should_align_every_channel_row_when_frame_is_created) {
+    SampleFrame<std::int16_t, 3, 10> frame;
+
+    static_assert(SampleFrame<std::int16_t, 3, 10>::kStride % (DSP_ALIGNMENT / sizeof(std::int16_t)) == 0);
+    for (std::size_t c = 0; c < 3; ++c) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(frame.channel(c).data()) % DSP_ALIGNMENT, 0u);
+    }
+}
+
+TEST(SampleFrameTest, should_sort_samples_into_channel_rows_when_deinterleaving) {
+    SampleFrame<std::int16_t, 3, 4> frame;
+    const std::vector<std::int16_t> fifo{1, 10, 100, 2, 20, 200, 3, 30, 300, 4, 40, 400, 5}; // Trailing partial set
+
+    EXPECT_EQ(frame.deinterleave(fifo, 1234), 4u);
+
+    EXPECT_EQ(std::vector<std::int16_t>(frame.channel(0).begin(), frame.channel(0).end()),
+              (std::vector<std::int16_t>{1, 2, 3, 4}));
+    EXPECT_EQ(std::vector<std::int16_t>(frame.channel(2).begin(), frame.channel(2).end()),
+              (std::vector<std::int16_t>{100, 200, 300, 400}));
+    EXPECT_EQ(frame.size(), 4u);
+    EXPECT_EQ(frame.getFirstSampleTicks(), 1234u);
+}
+
+TEST(SampleFrameTest, should_take_at_most_frame_size_when_input_is_longer) {
+    SampleFrame<float, 2, 2> frame;
+    const std::vector<float> fifo{1, -1, 2, -2, 3, -3};
+
+    EXPECT_EQ(frame.deinterleave(fifo), 2u);
+    EXPECT_FLOAT_EQ(frame.channel(1)[1], -2.0f);
+}
+
+TEST(SampleFrameTest, should_restore_original_order_when_interleaving_again) {
+    SampleFrame<std::int16_t, 3, 8> frame;
+    std::vector<std::int16_t> fifo(15);
+    for (std::size_t i = 0; i < fifo.size(); ++i) {
+        fifo[i] = static_cast<std::int16_t>(i * 7 - 50);
+    }
+    frame.deinterleave(fifo);
+
+    std::vector<std::int16_t> out(24, 0);
+    EXPECT_EQ(frame.interleave(out), 15u);
+
+    out.resize(15);
+    EXPECT_EQ(out, fifo);
+}
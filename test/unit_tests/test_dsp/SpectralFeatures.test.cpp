@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "SpectralFeatures.hpp"
+
+/**
+ * TEST CASES
+ * SpectralFeatureExtractorTest
+ * - should_find_frequency_and_amplitude_when_window_holds_sines
+ * - should_sum_band_energies_to_variance_when_window_has_dc_offset
+ * - should_report_crest_factor_when_window_holds_sine_or_impulse
+ * - should_complete_window_every_n_samples_when_fed_one_by_one
+ * - should_shrink_payload_by_two_orders_when_features_replace_waveform
+ */
+
+namespace {
+
+constexpr float kRate = 1024.0f;
+
+std::vector<float> sines(std::size_t length, float offset = 0.0f) {
+    std::vector<float> x(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        const float t = static_cast<float>(i) / kRate;
+        x[i] = offset + 1.0f * std::sin(2 * 3.14159265f * 50.0f * t) + 0.25f * std::sin(2 * 3.14159265f * 203.3f * t);
+    }
+    return x;
+}
+
+} // namespace
+
+TEST(SpectralFeatureExtractorTest, should_find_frequency_and_amplitude_when_window_holds_sines) {
+    const std::vector<float> x = sines(1024);
+    dsp::SpectralFeatureExtractor<1024, 4, 3> extractor(kRate);
+
+    const auto& features = extractor.processWindow(std::span<const float, 1024>(x.data(), 1024));
+
+    EXPECT_NEAR(features.peakHz[0], 50.0f, 0.1f);
+    EXPECT_NEAR(features.peakAmplitude[0], 1.0f, 0.02f);
+    EXPECT_NEAR(features.peakHz[1], 203.3f, 0.2f); // Between bins
+    EXPECT_NEAR(features.peakAmplitude[1], 0.25f, 0.04f);
+    EXPECT_FLOAT_EQ(features.peakHz[2], 0.0f); // Nothing else stands out from leakage
+}
+
+TEST(SpectralFeatureExtractorTest, should_sum_band_energies_to_variance_when_window_has_dc_offset) {
+    const std::vector<float> x = sines(1024, 9.81f);
+    dsp::SpectralFeatureExtractor<1024, 3> extractor(kRate, {0.0f, 100.0f, 300.0f, 512.0f});
+
+    const auto& features = extractor.processWindow(std::span<const float, 1024>(x.data(), 1024));
+
+    EXPECT_NEAR(features.bandEnergy[0], 0.5f, 0.01f);     // 1^2 / 2 at 50 Hz, gravity removed
+    EXPECT_NEAR(features.bandEnergy[1], 0.03125f, 0.002f); // 0.25^2 / 2 at 203 Hz
+    EXPECT_NEAR(features.bandEnergy[2], 0.0f, 1e-4f);
+    EXPECT_NEAR(features.bandEnergy[0] + features.bandEnergy[1] + features.bandEnergy[2],
+                features.rms * features.rms, 0.01f);
+}
+
+TEST(SpectralFeatureExtractorTest, should_report_crest_factor_when_window_holds_sine_or_impulse) {
+    dsp::SpectralFeatureExtractor<256, 1> extractor(kRate);
+    std::array<float, 256> x{};
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        x[i] = std::sin(2 * 3.14159265f * 16.0f * static_cast<float>(i) / 256.0f);
+    }
+
+    EXPECT_NEAR(extractor.processWindow(x).crestFactor, std::sqrt(2.0f), 0.01f);
+    EXPECT_NEAR(extractor.features().rms, std::sqrt(0.5f), 1e-3f);
+
+    x.fill(0.0f);
+    x[100] = 5.0f;
+    EXPECT_NEAR(extractor.processWindow(x).crestFactor, 16.0f, 0.1f); // Impact: (N - 1) / sqrt(N - 1)
+}
+
+TEST(SpectralFeatureExtractorTest, should_complete_window_every_n_samples_when_fed_one_by_one) {
+    const std::vector<float> x = sines(3 * 256 + 10);
+    dsp::SpectralFeatureExtractor<256, 2> extractor(kRate);
+    std::vector<std::size_t> completedAt;
+
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        if (extractor.process(x[i])) {
+            completedAt.push_back(i);
+        }
+    }
+
+    EXPECT_EQ(completedAt, (std::vector<std::size_t>{255, 511, 767}));
+    EXPECT_EQ(extractor.features().window, 3u);
+    EXPECT_NEAR(extractor.features().peakHz[0], 50.0f, 2.0f);
+    extractor.reset();
+    EXPECT_EQ(extractor.features().window, 0u);
+}
+
+TEST(SpectralFeatureExtractorTest, should_shrink_payload_by_two_orders_when_features_replace_waveform) {
+    const std::vector<float> x = sines(4096);
+    dsp::SpectralFeatureExtractor<4096, 8, 3> extractor(kRate);
+    extractor.processWindow(std::span<const float, 4096>(x.data(), 4096));
+
+    std::string waveform = "[";
+    char sample[16];
+    for (float value : x) {
+        std::snprintf(sample, sizeof(sample), "%.4g,", static_cast<double>(value));
+        waveform += sample;
+    }
+    char payload[256];
+    const std::size_t length = extractor.features().writeJson(payload, sizeof(payload));
+
+    ASSERT_LT(length, sizeof(payload));
+    EXPECT_EQ(std::string(payload).substr(0, 12), "{\"w\":1,\"rms\"");
+    EXPECT_NE(std::string(payload).find("\"peaks\":[[50.0,"), std::string::npos);
+    EXPECT_GE(waveform.size() / length, 100u); // About 30 KB against 150 bytes
+}
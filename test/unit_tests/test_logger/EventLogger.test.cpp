@@ -0,0 +1,349 @@
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+#include "EventLogger.hpp"
+#include "StatefulObject.hpp"
+
+/**
+ * TEST CASES
+ * LogRecordTest
+ * - should_format_each_arg_by_captured_type_when_record_is_formatted
+ * - should_truncate_string_args_when_they_exceed_inline_text
+ * - should_apply_caller_precision_when_string_arg_has_one
+ * - should_mark_missing_args_when_format_has_more_specifiers
+ * - should_keep_enum_as_integer_until_formatted_given_enum_has_names
+ * EventLoggerTest
+ * - should_output_state_change_when_logger_is_flushed
+ * - should_print_each_record_once_when_history_is_full
+ * - should_account_for_every_record_when_more_tasks_than_rings_log
+ * - should_give_ring_to_later_task_when_short_lived_tasks_release_theirs
+ * - should_persist_drained_records_when_store_is_attached
+ * - should_log_component_and_state_names_when_stateful_object_changes_state
+ * - should_print_utc_time_when_record_was_captured_before_time_service_synced
+ * - should_drop_and_count_records_below_component_level_when_level_is_raised
+ * - should_drop_and_count_records_over_rate_when_component_exceeds_burst
+ * - should_log_one_summary_with_last_state_when_component_flaps
+ * - should_detect_flapping_per_instance_when_instances_of_one_component_change_state
+ */
+
+namespace {
+
+std::string formatted(const LogRecord& record) {
+    char out[128];
+    log_record::format(record, out, sizeof(out));
+    return out;
+}
+
+} // namespace
+
+TEST(LogRecordTest, should_format_each_arg_by_captured_type_when_record_is_formatted) {
+    LogRecord record;
+    log_record::capture(record, 0, "%s=%d (%5.2f%%) 0x%02x", std::string("rssi"), -67, 12.345, 10u);
+
+    EXPECT_EQ(formatted(record), "rssi=-67 (12.35%) 0x0a");
+}
+
+TEST(LogRecordTest, should_truncate_string_args_when_they_exceed_inline_text) {
+    LogRecord record;
+    std::string id(40, 'x');
+    log_record::capture(record, 0, "%s -> %s", id, "CONNECTED");
+
+    EXPECT_EQ(formatted(record), std::string(LogRecord::kTextBytes, 'x') + " -> ");
+}
+
+TEST(LogRecordTest, should_apply_caller_precision_when_string_arg_has_one) {
+    LogRecord record;
+    log_record::capture(record, 0, "[%.3s] [%-6.2s] [%.9s]", "CONNECTED", std::string("wifi"), "ok");
+
+    EXPECT_EQ(formatted(record), "[CON] [wi    ] [ok]");
+}
+
+TEST(LogRecordTest, should_mark_missing_args_when_format_has_more_specifiers) {
+    LogRecord record;
+    log_record::capture(record, 0, "%d %d", 1);
+
+    EXPECT_EQ(formatted(record), "1 <?>");
+}
+
+TEST(LogRecordTest, should_keep_enum_as_integer_until_formatted_given_enum_has_names) {
+    LogRecord record;
+    log_record::capture(record, 0, "%s -> %s", componentId_t::SDCard, componentId_t::Error);
+
+    EXPECT_EQ(record.types[0], logArgType_t::NAME);
+    EXPECT_EQ(record.textUsed, 0u);
+    EXPECT_EQ(formatted(record), "SDCard -> Error");
+}
+
+// =============================================================
+
+#define VALVE_STATES(X) X(CLOSED) X(OPENING) X(OPEN)
+
+enum class valveState_t : std::uint16_t {
+    VALVE_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(valveState_t, VALVE_STATES)
+
+namespace {
+std::mutex linesMutex;
+std::vector<std::string> lines; // Formatted output captured instead of the console
+
+void captureLine(const char* line) {
+    std::lock_guard<std::mutex> lock(linesMutex);
+    lines.emplace_back(line);
+}
+} // namespace
+
+class EventLoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        logger.flush();
+        logger.setLineSink(captureLine);
+        lines.clear();
+    }
+
+    void TearDown() override {
+        logger.setLineSink(nullptr);
+    }
+
+    std::size_t countLines(const std::string& needle) {
+        std::lock_guard<std::mutex> lock(linesMutex);
+        std::size_t count = 0;
+        for (const std::string& line : lines) {
+            count += line.find(needle) != std::string::npos;
+        }
+        return count;
+    }
+
+    EventLogger& logger = EventLogger::getInstance();
+};
+
+TEST_F(EventLoggerTest, should_output_state_change_when_logger_is_flushed) {
+    logger.logStateChange("WifiManager", "CONNECTED");
+    logger.flush();
+
+    EXPECT_EQ(countLines("] WifiManager -> CONNECTED"), 1u);
+}
+
+TEST_F(EventLoggerTest, should_print_each_record_once_when_history_is_full) {
+    for (int i = 0; i < 2 * CIRCULAR_BUFFER_MAX_SIZE; ++i) {
+        logger.log("history %d", i);
+        logger.flush(); // Keeps the test task's ring from overflowing
+    }
+
+    EXPECT_EQ(countLines("history "), 2u * CIRCULAR_BUFFER_MAX_SIZE);
+
+    logger.printLatestLogs();
+    EXPECT_EQ(countLines("history "), 3u * CIRCULAR_BUFFER_MAX_SIZE);
+}
+
+TEST_F(EventLoggerTest, should_account_for_every_record_when_more_tasks_than_rings_log) {
+    constexpr int kTasks = EVENT_LOGGER_PRODUCER_RINGS + 2;
+    constexpr int kRecordsPerTask = 200;
+    std::uint32_t droppedBefore = logger.droppedRecords();
+
+    std::vector<std::thread> tasks;
+    for (int task = 0; task < kTasks; ++task) {
+        tasks.emplace_back([&, task] {
+            for (int i = 0; i < kRecordsPerTask; ++i) {
+                logger.log("task %d record %d", task, i);
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (std::thread& task : tasks) {
+        task.join();
+    }
+    logger.flush();
+
+    EXPECT_EQ(countLines(" record ") + (logger.droppedRecords() - droppedBefore),
+              static_cast<std::size_t>(kTasks * kRecordsPerTask));
+}
+
+TEST_F(EventLoggerTest, should_give_ring_to_later_task_when_short_lived_tasks_release_theirs) {
+    constexpr int kTasks = EVENT_LOGGER_PRODUCER_RINGS + 2;
+    std::vector<bool> gotRing(kTasks, false);
+    std::binary_semaphore done{0};
+    std::counting_semaphore<> end{0};
+
+    // Like xTaskCreate tasks: each one stays parked after its work, so no thread_local destructor gives its ring back
+    std::vector<std::thread> tasks;
+    for (int task = 0; task < kTasks; ++task) {
+        tasks.emplace_back([&, task] {
+            logger.log("short-lived task %d", task);
+            gotRing[task] = logger.hasTaskRing();
+            logger.releaseTaskRing();
+            done.release();
+            end.acquire();
+        });
+        done.acquire(); // One at a time, each finds the ring its predecessor released
+    }
+    end.release(kTasks);
+    for (std::thread& task : tasks) {
+        task.join();
+    }
+    logger.flush();
+
+    EXPECT_EQ(gotRing, std::vector<bool>(kTasks, true));
+    EXPECT_EQ(countLines("short-lived task "), static_cast<std::size_t>(kTasks));
+}
+
+TEST_F(EventLoggerTest, should_persist_drained_records_when_store_is_attached) {
+    std::string directory = ::testing::TempDir() + "event_logger_store";
+    ::mkdir(directory.c_str(), 0755);
+    LogStore leftovers(LogStore::Config{directory});
+    for (std::uint32_t sequence : leftovers.listSegments()) {
+        std::remove(leftovers.segmentPath(sequence).c_str());
+    }
+    auto store = std::make_unique<LogStore>(LogStore::Config{directory});
+
+    logger.attachStore(store.get());
+    logger.logStateChange("MqttManager", "DISCONNECTED");
+    logger.flush();
+    logger.attachStore(nullptr);
+
+    std::ifstream file(store->segmentPath(0), std::ios::binary);
+    std::vector<std::uint8_t> segment{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    std::vector<std::string> decoded;
+    EXPECT_TRUE(log_store::decode(segment, [&](const LogRecord& record) {
+        char line[64];
+        log_record::format(record, line, sizeof(line));
+        decoded.emplace_back(line);
+    }));
+    EXPECT_EQ(decoded, (std::vector<std::string>{"MqttManager -> DISCONNECTED"}));
+
+    store.reset();
+    std::remove((directory + "/LG000000.BIN").c_str());
+    ::rmdir(directory.c_str());
+}
+
+TEST_F(EventLoggerTest, should_log_component_and_state_names_when_stateful_object_changes_state) {
+    class Valve : public StatefulObjectLogged<valveState_t> {
+    public:
+        Valve() : StatefulObjectLogged<valveState_t>(componentId_t::System, valveState_t::CLOSED) {}
+    } valve;
+    // Other suites change System state in bursts, its flap window and rate bucket may already be spent
+    logger.setFlapSuppression(componentId_t::System, 0, 0);
+    logger.setRateLimit(componentId_t::System, 0, 0);
+
+    valve.setState(valveState_t::OPENING);
+    valve.setState(valveState_t::OPENING);
+    valve.setState(valveState_t::OPEN);
+    logger.flush();
+    logger.setFlapSuppression(componentId_t::System, EVENT_LOGGER_FLAP_THRESHOLD, EVENT_LOGGER_FLAP_WINDOW_MS);
+    logger.setRateLimit(componentId_t::System, EVENT_LOGGER_RATE_PER_SECOND, EVENT_LOGGER_RATE_BURST);
+
+    EXPECT_EQ(valve.getId(), "System");
+    EXPECT_STREQ(valve.getStateName(), "OPEN");
+    EXPECT_EQ(countLines("] System -> OPENING"), 1u);
+    EXPECT_EQ(countLines("] System -> OPEN"), 2u); // Also matches OPENING
+}
+
+TEST_F(EventLoggerTest, should_print_utc_time_when_record_was_captured_before_time_service_synced) {
+    logger.log("captured offline");
+    logger.flush(); // Printed with boot-relative time, the record stays in the history
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    // Sync one second after the capture, as if SNTP only answered then
+    TimeService::getInstance().sync(1'790'000'000LL * 1'000'000, TimeService::now() + 1'000'000 - 2'000);
+    {
+        std::lock_guard<std::mutex> lock(linesMutex);
+        lines.clear();
+    }
+    logger.printLatestLogs(); // Formats the history again, now in UTC
+    TimeService::getInstance().reset();
+
+    EXPECT_GE(countLines("] captured offline"), 1u);
+    std::lock_guard<std::mutex> lock(linesMutex);
+    for (const std::string& line : lines) {
+        if (line.find("] captured offline") != std::string::npos) {
+            EXPECT_EQ(line.rfind("[2026-09-21 14:13:1", 0), 0u) << line;
+        }
+    }
+}
+
+TEST_F(EventLoggerTest, should_drop_and_count_records_below_component_level_when_level_is_raised) {
+    EventLogger::ComponentStats before = logger.stats(componentId_t::MqttManager);
+    logger.setLevel(componentId_t::MqttManager, logLevel_t::WARN);
+
+    EVENT_LOG(INFO, MqttManager, "publish %d ok", 1);
+    EVENT_LOG(WARN, MqttManager, "publish %d retried", 2);
+    EVENT_LOG(DEBUG, MqttManager, "compiled out"); // Above the default INFO floor
+    logger.setLevel(componentId_t::MqttManager, logLevel_t::INFO);
+    logger.flush();
+
+    EXPECT_EQ(countLines("] MqttManager: publish "), 1u);
+    EXPECT_EQ(countLines("] MqttManager: publish 2 retried"), 1u);
+    EXPECT_EQ(logger.stats(componentId_t::MqttManager).levelFiltered - before.levelFiltered, 1u);
+}
+
+TEST_F(EventLoggerTest, should_drop_and_count_records_over_rate_when_component_exceeds_burst) {
+    EventLogger::ComponentStats before = logger.stats(componentId_t::OtaManager);
+    logger.setRateLimit(componentId_t::OtaManager, 1, 5);
+
+    for (int i = 0; i < 20; ++i) {
+        EVENT_LOG(ERROR, OtaManager, "chunk %d rejected", i);
+    }
+    logger.setRateLimit(componentId_t::OtaManager, EVENT_LOGGER_RATE_PER_SECOND, EVENT_LOGGER_RATE_BURST);
+    logger.flush();
+
+    EXPECT_EQ(countLines("] OtaManager: chunk "), 5u);
+    EXPECT_EQ(logger.stats(componentId_t::OtaManager).rateLimited - before.rateLimited, 15u);
+}
+
+TEST_F(EventLoggerTest, should_log_one_summary_with_last_state_when_component_flaps) {
+    EventLogger::ComponentStats before = logger.stats(componentId_t::WifiManager);
+    logger.setFlapSuppression(componentId_t::WifiManager, 2, 50);
+
+    for (int i = 0; i < 10; ++i) {
+        logger.logStateChange(componentId_t::WifiManager, i % 2 == 0 ? valveState_t::OPEN : valveState_t::CLOSED);
+    }
+    logger.flush();
+    EXPECT_EQ(countLines("] WifiManager -> "), 2u);
+    EXPECT_EQ(countLines("flapping"), 0u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    logger.flush();
+    logger.setFlapSuppression(componentId_t::WifiManager, EVENT_LOGGER_FLAP_THRESHOLD, EVENT_LOGGER_FLAP_WINDOW_MS);
+
+    EXPECT_EQ(countLines("] WifiManager -> "), 2u);
+    EXPECT_EQ(countLines("] WifiManager flapping: 10 state changes in "), 1u);
+    EXPECT_EQ(countLines(" ms, last CLOSED"), 1u);
+    EXPECT_EQ(logger.stats(componentId_t::WifiManager).flapSuppressed - before.flapSuppressed, 8u);
+}
+
+TEST_F(EventLoggerTest, should_detect_flapping_per_instance_when_instances_of_one_component_change_state) {
+    class Card : public StatefulObjectLogged<valveState_t> {
+    public:
+        Card(const std::string& instance, std::uint32_t slot)
+            : StatefulObjectLogged<valveState_t>(componentId_t::SDCard, valveState_t::CLOSED) {
+            setInstance(instance, slot);
+        }
+    };
+    Card first("slot0", 0);
+    Card second("slot1", 1);
+    EventLogger::ComponentStats before = logger.stats(componentId_t::SDCard);
+
+    for (int i = 0; i < 2 * EVENT_LOGGER_FLAP_THRESHOLD; ++i) {
+        const valveState_t state = i % 2 == 0 ? valveState_t::OPEN : valveState_t::CLOSED;
+        first.setState(state);
+        second.setState(state);
+    }
+    logger.logStateChange(componentId_t::SDCard, valveState_t::OPENING); // The component's own window is untouched
+    logger.flush();
+
+    EXPECT_EQ(first.getId(), "SDCard slot0");
+    EXPECT_EQ(second.getDetail(), 1u);
+    EXPECT_EQ(countLines("] SDCard slot0 -> "), static_cast<std::size_t>(EVENT_LOGGER_FLAP_THRESHOLD));
+    EXPECT_EQ(countLines("] SDCard slot1 -> "), static_cast<std::size_t>(EVENT_LOGGER_FLAP_THRESHOLD));
+    EXPECT_EQ(countLines("] SDCard -> OPENING"), 1u);
+    EXPECT_EQ(logger.stats(componentId_t::SDCard).flapSuppressed - before.flapSuppressed,
+              2u * EVENT_LOGGER_FLAP_THRESHOLD);
+}
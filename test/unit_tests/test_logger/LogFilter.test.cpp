@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "LogFilter.hpp"
+
+/**
+ * TEST CASES
+ * LogLevelTest
+ * - should_compile_in_only_levels_up_to_floor_when_floor_is_default
+ * TokenBucketTest
+ * - should_allow_burst_then_refill_at_rate_when_bucket_is_drained
+ * - should_never_limit_when_rate_is_zero
+ * FlapDetectorTest
+ * - should_summarize_transitions_over_threshold_when_window_is_over
+ * - should_not_summarize_when_window_stays_under_threshold
+ * - should_close_window_on_next_transition_given_window_is_over
+ * - should_log_threshold_transitions_once_when_tasks_report_concurrently
+ */
+
+TEST(LogLevelTest, should_compile_in_only_levels_up_to_floor_when_floor_is_default) {
+    static_assert(log_filter::compiledIn<logLevel_t::ERROR>());
+    static_assert(log_filter::compiledIn<logLevel_t::INFO>());
+    static_assert(!log_filter::compiledIn<logLevel_t::DEBUG>());
+    static_assert(!log_filter::compiledIn<logLevel_t::NONE>());
+    EXPECT_STREQ(enum_names::nameOf(logLevel_t::WARN), "WARN");
+}
+
+// =============================================================
+
+TEST(TokenBucketTest, should_allow_burst_then_refill_at_rate_when_bucket_is_drained) {
+    TokenBucket bucket(10, 3); // One token per 100 ms
+    std::uint64_t now = 5'000'000;
+
+    EXPECT_TRUE(bucket.tryTake(now));
+    EXPECT_TRUE(bucket.tryTake(now));
+    EXPECT_TRUE(bucket.tryTake(now));
+    EXPECT_FALSE(bucket.tryTake(now));
+    EXPECT_FALSE(bucket.tryTake(now + 99'000));
+    EXPECT_TRUE(bucket.tryTake(now + 100'000));
+    EXPECT_FALSE(bucket.tryTake(now + 100'000));
+
+    // A long pause refills up to the burst, not beyond
+    int taken = 0;
+    while (bucket.tryTake(now + 60'000'000)) {
+        ++taken;
+    }
+    EXPECT_EQ(taken, 3);
+}
+
+TEST(TokenBucketTest, should_never_limit_when_rate_is_zero) {
+    TokenBucket bucket(0, 0);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(bucket.tryTake(0));
+    }
+}
+
+// =============================================================
+
+TEST(FlapDetectorTest, should_summarize_transitions_over_threshold_when_window_is_over) {
+    FlapDetector flap(3, 1000);
+    std::optional<FlapDetector::Summary> closed;
+    int logged = 0;
+    for (int i = 0; i < 8; ++i) {
+        logged += flap.onTransition(1'000'000 + i * 50'000, closed);
+        EXPECT_FALSE(closed);
+    }
+    EXPECT_EQ(logged, 3);
+    EXPECT_FALSE(flap.expire(1'999'999));
+
+    std::optional<FlapDetector::Summary> summary = flap.expire(2'000'000);
+    ASSERT_TRUE(summary);
+    EXPECT_EQ(summary->changes, 8u);
+    EXPECT_EQ(summary->durationMs, 350u);
+    EXPECT_EQ(flap.suppressed(), 5u);
+    EXPECT_FALSE(flap.expire(3'000'000));
+}
+
+TEST(FlapDetectorTest, should_not_summarize_when_window_stays_under_threshold) {
+    FlapDetector flap(3, 1000);
+    std::optional<FlapDetector::Summary> closed;
+    EXPECT_TRUE(flap.onTransition(0, closed));
+    EXPECT_TRUE(flap.onTransition(10'000, closed));
+
+    EXPECT_FALSE(flap.expire(5'000'000));
+    EXPECT_EQ(flap.suppressed(), 0u);
+}
+
+TEST(FlapDetectorTest, should_close_window_on_next_transition_given_window_is_over) {
+    FlapDetector flap(1, 1000);
+    std::optional<FlapDetector::Summary> closed;
+    EXPECT_TRUE(flap.onTransition(0, closed));
+    EXPECT_FALSE(flap.onTransition(100'000, closed));
+
+    // Starts a new window, whose first transition is logged again
+    EXPECT_TRUE(flap.onTransition(1'500'000, closed));
+    ASSERT_TRUE(closed);
+    EXPECT_EQ(closed->changes, 2u);
+    EXPECT_EQ(closed->durationMs, 100u);
+}
+
+TEST(FlapDetectorTest, should_log_threshold_transitions_once_when_tasks_report_concurrently) {
+    constexpr int kTasks = 4;
+    constexpr int kTransitions = 10'000;
+    FlapDetector flap(3, 1000);
+    std::atomic<int> logged{0};
+    std::atomic<int> summaries{0};
+
+    std::vector<std::thread> tasks;
+    for (int task = 0; task < kTasks; ++task) {
+        tasks.emplace_back([&] {
+            std::optional<FlapDetector::Summary> closed;
+            for (int i = 0; i < kTransitions; ++i) {
+                logged += flap.onTransition(500'000, closed); // One window, never over
+                summaries += closed.has_value();
+            }
+        });
+    }
+    for (std::thread& task : tasks) {
+        task.join();
+    }
+
+    EXPECT_EQ(logged.load(), 3);
+    EXPECT_EQ(summaries.load(), 0);
+    EXPECT_EQ(flap.suppressed(), static_cast<std::uint32_t>(kTasks * kTransitions - 3));
+    std::optional<FlapDetector::Summary> summary = flap.expire(1'500'000);
+    ASSERT_TRUE(summary);
+    EXPECT_EQ(summary->changes, static_cast<std::uint32_t>(kTasks * kTransitions));
+}
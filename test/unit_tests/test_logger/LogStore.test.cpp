@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ComponentId.hpp"
+#include "LogStore.hpp"
+
+/**
+ * TEST CASES
+ * LogStoreTest
+ * - should_decode_every_record_when_segment_is_read_back
+ * - should_rewrite_partial_block_in_place_when_segment_is_flushed_again
+ * - should_keep_at_most_max_segments_when_rotating
+ * - should_decode_each_segment_on_its_own_given_segments_were_rotated
+ * - should_continue_after_newest_segment_when_store_is_reopened
+ * - should_report_truncation_and_keep_earlier_records_when_segment_ends_mid_entry
+ * - should_store_enum_names_as_text_when_record_has_named_args
+ */
+
+class LogStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory = ::testing::TempDir() + "log_store_" +
+                    ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        ::mkdir(directory.c_str(), 0755);
+        removeSegments();
+        open();
+    }
+
+    void TearDown() override {
+        store.reset();
+        removeSegments();
+        ::rmdir(directory.c_str());
+    }
+
+    void open(std::size_t segmentBytes = 4096, std::size_t maxSegments = 3) {
+        store.reset();
+        store = std::make_unique<LogStore>(LogStore::Config{directory, segmentBytes, maxSegments});
+    }
+
+    void removeSegments() {
+        LogStore probe(LogStore::Config{directory});
+        for (std::uint32_t sequence : probe.listSegments()) {
+            std::remove(probe.segmentPath(sequence).c_str());
+        }
+    }
+
+    void append(std::uint64_t timestamp, int value) {
+        LogRecord record;
+        log_record::capture(record, timestamp, "WifiManager -> %s (%d)", "CONNECTED", value);
+        ASSERT_TRUE(store->append(record));
+    }
+
+    std::vector<std::uint8_t> readSegment(std::uint32_t sequence) {
+        std::ifstream file(store->segmentPath(sequence), std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    // Formatted lines of one segment, prefixed with the timestamp
+    static std::vector<std::string> decodeLines(const std::vector<std::uint8_t>& segment, bool* complete = nullptr) {
+        std::vector<std::string> lines;
+        bool ok = log_store::decode(segment, [&](const LogRecord& record) {
+            char line[128];
+            log_record::format(record, line, sizeof(line));
+            lines.push_back(std::to_string(record.timestamp) + " " + line);
+        });
+        if (complete != nullptr) {
+            *complete = ok;
+        }
+        return lines;
+    }
+
+    std::string directory;
+    std::unique_ptr<LogStore> store;
+};
+
+TEST_F(LogStoreTest, should_decode_every_record_when_segment_is_read_back) {
+    append(1'000'000, 1);
+    append(1'000'250, -2);
+    append(999'000, 3); // Drained from another task, slightly older
+    store->flush();
+
+    EXPECT_EQ(decodeLines(readSegment(0)), (std::vector<std::string>{
+                                                "1000000 WifiManager -> CONNECTED (1)",
+                                                "1000250 WifiManager -> CONNECTED (-2)",
+                                                "999000 WifiManager -> CONNECTED (3)",
+                                            }));
+}
+
+TEST_F(LogStoreTest, should_rewrite_partial_block_in_place_when_segment_is_flushed_again) {
+    append(10, 1);
+    store->flush();
+    append(20, 2);
+    store->flush();
+
+    std::vector<std::uint8_t> segment = readSegment(0);
+    EXPECT_EQ(segment.size(), log_store::kBlockBytes); // Both records share the first block
+    EXPECT_EQ(decodeLines(segment).size(), 2u);
+
+    // Sporadic logging, flushed after every record: blocks are only as many as the bytes need
+    for (int i = 3; i <= 60; ++i) {
+        append(i * 10, i);
+        store->flush();
+    }
+    segment = readSegment(0);
+    EXPECT_EQ(segment.size() % log_store::kBlockBytes, 0u);
+    EXPECT_LE(segment.size(), 4 * log_store::kBlockBytes);
+    EXPECT_EQ(decodeLines(segment).size(), 60u);
+}
+
+TEST_F(LogStoreTest, should_keep_at_most_max_segments_when_rotating) {
+    for (int i = 0; i < 2000; ++i) {
+        append(i * 100, i);
+    }
+    store->flush();
+
+    std::vector<std::uint32_t> segments = store->listSegments();
+    ASSERT_EQ(segments.size(), 3u);
+    EXPECT_GT(segments.front(), 0u);
+    for (std::uint32_t sequence : segments) {
+        EXPECT_LE(readSegment(sequence).size(), 4096u);
+    }
+}
+
+TEST_F(LogStoreTest, should_decode_each_segment_on_its_own_given_segments_were_rotated) {
+    int appended = 0;
+    while (store->listSegments().size() < 2) {
+        append(5'000'000 + appended * 10, appended);
+        ++appended;
+    }
+    store->flush();
+
+    std::vector<std::string> first = decodeLines(readSegment(0));
+    std::vector<std::string> second = decodeLines(readSegment(1));
+    ASSERT_FALSE(second.empty());
+    EXPECT_EQ(first.size() + second.size(), static_cast<std::size_t>(appended));
+    std::string expected = std::to_string(5'000'000 + first.size() * 10) + " WifiManager -> CONNECTED (" +
+                           std::to_string(first.size()) + ")";
+    EXPECT_EQ(second.front(), expected);
+}
+
+TEST_F(LogStoreTest, should_continue_after_newest_segment_when_store_is_reopened) {
+    append(1, 1);
+    open();
+    append(2, 2);
+    store->flush();
+
+    EXPECT_EQ(store->listSegments(), (std::vector<std::uint32_t>{0, 1}));
+    EXPECT_EQ(decodeLines(readSegment(0)), (std::vector<std::string>{"1 WifiManager -> CONNECTED (1)"}));
+}
+
+TEST_F(LogStoreTest, should_report_truncation_and_keep_earlier_records_when_segment_ends_mid_entry) {
+    append(1, 1);
+    append(2, 2);
+    store->flush();
+    std::vector<std::uint8_t> segment = readSegment(0);
+
+    // Cut inside the second record, as a power loss during the write would
+    std::size_t secondRecord = segment.size();
+    while (segment[secondRecord - 1] == log_store::PADDING) {
+        --secondRecord;
+    }
+    segment.resize(secondRecord - 3);
+
+    bool complete = true;
+    EXPECT_EQ(decodeLines(segment, &complete), (std::vector<std::string>{"1 WifiManager -> CONNECTED (1)"}));
+    EXPECT_FALSE(complete);
+}
+
+TEST_F(LogStoreTest, should_store_enum_names_as_text_when_record_has_named_args) {
+    LogRecord record;
+    log_record::capture(record, 7, "%s -> %s", componentId_t::OtaManager, componentId_t::Error);
+    ASSERT_TRUE(store->append(record));
+    store->flush();
+
+    EXPECT_EQ(decodeLines(readSegment(0)), (std::vector<std::string>{"7 OtaManager -> Error"}));
+}
@@ -0,0 +1,336 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ActiveObject.hpp"
+
+/**
+ * TEST CASES
+ * ActiveObjectTest
+ * - should_enter_initial_children_when_started
+ * - should_exit_to_common_ancestor_and_enter_target_when_transitioning
+ * - should_reenter_target_when_transitioning_to_enclosing_state
+ * - should_bubble_event_to_parent_when_leaf_does_not_handle_it
+ * - should_run_event_to_completion_when_handler_posts_another_event
+ * - should_drop_and_count_event_when_queue_is_full
+ * - should_produce_same_trace_when_same_events_are_replayed
+ * - should_publish_state_change_when_leaf_state_changes
+ * - should_drop_queued_and_later_events_when_object_is_stopped
+ * ActiveDispatcherTest
+ * - should_process_every_event_once_per_object_when_pool_is_smaller_than_object_count
+ * - should_finish_turn_in_progress_before_object_is_destroyed
+ */
+
+#define PLAYER_STATES(X) X(OFF) X(ON) X(IDLE) X(ACTIVE) X(RUNNING) X(PAUSED)
+
+enum class playerState_t : std::uint16_t {
+    PLAYER_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(playerState_t, PLAYER_STATES)
+
+namespace {
+
+enum playerSignal_t : std::uint16_t {
+    POWER,
+    GO,
+    PAUSE,
+    RESUME,
+    RESET,
+    COUNT,
+    CHAIN
+};
+
+// OFF | ON { IDLE | ACTIVE { RUNNING | PAUSED } }
+constexpr StateHierarchy<playerState_t> kPlayerHierarchy{
+    {
+        {playerState_t::IDLE, playerState_t::ON},
+        {playerState_t::ACTIVE, playerState_t::ON},
+        {playerState_t::RUNNING, playerState_t::ACTIVE},
+        {playerState_t::PAUSED, playerState_t::ACTIVE},
+    },
+    {
+        {playerState_t::ON, playerState_t::IDLE},
+        {playerState_t::ACTIVE, playerState_t::RUNNING},
+    }};
+
+class Player : public ActiveObject<playerState_t> {
+public:
+    explicit Player(ActiveDispatcher& dispatcher, componentId_t component = componentId_t::SDCard)
+        : ActiveObject<playerState_t>(component, kPlayerHierarchy, playerState_t::OFF, dispatcher) {
+    }
+
+    ~Player() override {
+        stop();
+    }
+
+    void send(playerSignal_t signal, std::uint32_t param = 0) {
+        post({signal, param});
+    }
+
+    std::vector<std::string> trace;
+    std::atomic<std::uint32_t> counted{0};
+    std::atomic<bool> busy{false};
+    std::atomic<bool> overlapped{false}; // Set if two dispatchers ever ran this object at once
+
+protected:
+    Reaction handle(playerState_t state, const ActiveEvent& event) override {
+        if (busy.exchange(true)) {
+            overlapped.store(true);
+        }
+        Reaction reaction = react(state, event);
+        busy.store(false);
+        return reaction;
+    }
+
+    void onEntry(playerState_t state) override {
+        trace.push_back(std::string("enter ") + enum_names::nameOf(state));
+    }
+
+    void onExit(playerState_t state) override {
+        trace.push_back(std::string("exit ") + enum_names::nameOf(state));
+    }
+
+private:
+    Reaction react(playerState_t state, const ActiveEvent& event) {
+        switch (state) {
+            case playerState_t::OFF:
+                return event.signal == POWER ? transitionTo(playerState_t::ON) : unhandled();
+            case playerState_t::ON:
+                if (event.signal == POWER) {
+                    return transitionTo(playerState_t::OFF);
+                }
+                if (event.signal == COUNT) {
+                    counted.fetch_add(1, std::memory_order_relaxed);
+                    return handled();
+                }
+                if (event.signal == CHAIN) {
+                    trace.push_back("chain " + std::to_string(event.param) + " begin");
+                    if (event.param > 0) {
+                        send(CHAIN, event.param - 1);
+                    }
+                    trace.push_back("chain " + std::to_string(event.param) + " end");
+                    return handled();
+                }
+                return unhandled();
+            case playerState_t::IDLE:
+                return event.signal == GO ? transitionTo(playerState_t::ACTIVE) : unhandled();
+            case playerState_t::ACTIVE:
+                return event.signal == RESET ? transitionTo(playerState_t::ACTIVE) : unhandled();
+            case playerState_t::RUNNING:
+                return event.signal == PAUSE ? transitionTo(playerState_t::PAUSED) : unhandled();
+            case playerState_t::PAUSED:
+                return event.signal == RESUME ? transitionTo(playerState_t::RUNNING) : unhandled();
+        }
+        return unhandled();
+    }
+};
+
+} // namespace
+
+class ActiveObjectTest : public ::testing::Test {
+protected:
+    void bootToRunning() {
+        player.start();
+        player.send(POWER);
+        player.send(GO);
+        dispatcher.runUntilIdle();
+        player.trace.clear();
+    }
+
+    ActiveDispatcher dispatcher{0}; // Step mode, the test drives runUntilIdle()
+    Player player{dispatcher};
+};
+
+TEST_F(ActiveObjectTest, should_enter_initial_children_when_started) {
+    player.start();
+    player.send(POWER);
+
+    EXPECT_EQ(player.getState(), playerState_t::OFF); // Nothing runs until the dispatcher does
+    EXPECT_EQ(dispatcher.runUntilIdle(), 2u);
+
+    EXPECT_EQ(player.getState(), playerState_t::IDLE);
+    EXPECT_TRUE(player.isIn(playerState_t::ON));
+    EXPECT_FALSE(player.isIn(playerState_t::ACTIVE));
+    EXPECT_EQ(player.trace, (std::vector<std::string>{"enter OFF", "exit OFF", "enter ON", "enter IDLE"}));
+}
+
+TEST_F(ActiveObjectTest, should_exit_to_common_ancestor_and_enter_target_when_transitioning) {
+    bootToRunning();
+
+    player.send(PAUSE);
+    player.send(POWER);
+    dispatcher.runUntilIdle();
+
+    EXPECT_EQ(player.getState(), playerState_t::OFF);
+    EXPECT_EQ(player.trace, (std::vector<std::string>{"exit RUNNING", "enter PAUSED", "exit PAUSED", "exit ACTIVE",
+                                                      "exit ON", "enter OFF"}));
+}
+
+TEST_F(ActiveObjectTest, should_reenter_target_when_transitioning_to_enclosing_state) {
+    bootToRunning();
+    player.send(PAUSE);
+    dispatcher.runUntilIdle();
+    player.trace.clear();
+
+    player.send(RESET);
+    dispatcher.runUntilIdle();
+
+    EXPECT_EQ(player.getState(), playerState_t::RUNNING);
+    EXPECT_EQ(player.trace,
+              (std::vector<std::string>{"exit PAUSED", "exit ACTIVE", "enter ACTIVE", "enter RUNNING"}));
+}
+
+TEST_F(ActiveObjectTest, should_bubble_event_to_parent_when_leaf_does_not_handle_it) {
+    bootToRunning();
+
+    player.send(COUNT);
+    player.send(RESUME); // Handled nowhere while RUNNING
+    dispatcher.runUntilIdle();
+
+    EXPECT_EQ(player.counted.load(), 1u);
+    EXPECT_EQ(player.getState(), playerState_t::RUNNING);
+    EXPECT_TRUE(player.trace.empty());
+}
+
+TEST_F(ActiveObjectTest, should_run_event_to_completion_when_handler_posts_another_event) {
+    bootToRunning();
+
+    player.send(CHAIN, 2);
+    dispatcher.runUntilIdle();
+
+    EXPECT_EQ(player.trace, (std::vector<std::string>{"chain 2 begin", "chain 2 end", "chain 1 begin", "chain 1 end",
+                                                      "chain 0 begin", "chain 0 end"}));
+}
+
+TEST_F(ActiveObjectTest, should_drop_and_count_event_when_queue_is_full) {
+    bootToRunning();
+
+    std::size_t accepted = 0;
+    for (int i = 0; i < ACTIVE_OBJECT_QUEUE_SIZE + 3; ++i) {
+        accepted += player.post({COUNT, 0});
+    }
+    dispatcher.runUntilIdle();
+
+    EXPECT_EQ(accepted, static_cast<std::size_t>(ACTIVE_OBJECT_QUEUE_SIZE));
+    EXPECT_EQ(player.droppedEvents(), 3u);
+    EXPECT_EQ(player.counted.load(), static_cast<std::uint32_t>(ACTIVE_OBJECT_QUEUE_SIZE));
+}
+
+TEST_F(ActiveObjectTest, should_produce_same_trace_when_same_events_are_replayed) {
+    const std::vector<playerSignal_t> recorded{POWER, GO, PAUSE, COUNT, RESET, PAUSE, RESUME, POWER, POWER, GO};
+    Player replay{dispatcher};
+    player.start();
+    replay.start();
+
+    for (playerSignal_t signal : recorded) {
+        player.send(signal);
+        replay.send(signal);
+        dispatcher.runUntilIdle();
+    }
+
+    EXPECT_EQ(player.getState(), playerState_t::RUNNING);
+    EXPECT_EQ(replay.getState(), player.getState());
+    EXPECT_EQ(replay.trace, player.trace);
+}
+
+TEST_F(ActiveObjectTest, should_publish_state_change_when_leaf_state_changes) {
+    std::atomic<int> published{0};
+    EventBus::SubscriptionId id = EventBus::getInstance().subscribe(
+        EventFilter::any().components(componentId_t::SDCard),
+        [&](const Event& event) { published += event.is(componentId_t::SDCard, playerState_t::IDLE); });
+
+    player.start();
+    player.send(POWER);
+    dispatcher.runUntilIdle();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (published.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EventBus::getInstance().unsubscribe(id);
+
+    EXPECT_EQ(published.load(), 1);
+    EXPECT_EQ(player.getComponentId(), componentId_t::SDCard);
+}
+
+TEST_F(ActiveObjectTest, should_drop_queued_and_later_events_when_object_is_stopped) {
+    bootToRunning();
+    player.send(COUNT);
+    player.send(COUNT);
+
+    player.stop(); // Step mode: the pending turn runs here, without dispatching
+
+    EXPECT_FALSE(player.post({COUNT, 0}));
+    EXPECT_EQ(dispatcher.runUntilIdle(), 0u);
+    EXPECT_EQ(player.counted.load(), 0u);
+    EXPECT_EQ(player.droppedEvents(), 1u);
+}
+
+// =============================================================
+
+TEST(ActiveDispatcherTest, should_process_every_event_once_per_object_when_pool_is_smaller_than_object_count) {
+    constexpr std::size_t kPlayers = 6;
+    constexpr std::uint32_t kEventsPerProducer = 2000;
+    ActiveDispatcher dispatcher(2);
+    std::vector<std::unique_ptr<Player>> players;
+    for (std::size_t i = 0; i < kPlayers; ++i) {
+        players.push_back(std::make_unique<Player>(dispatcher, componentId_t::System));
+        players.back()->start();
+        players.back()->send(POWER);
+        players.back()->waitFor(playerState_t::IDLE);
+    }
+
+    auto produce = [&] {
+        for (std::uint32_t i = 0; i < kEventsPerProducer; ++i) {
+            for (auto& player : players) {
+                while (!player->post({COUNT, i})) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+    std::thread first(produce);
+    std::thread second(produce);
+    first.join();
+    second.join();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    for (auto& player : players) {
+        while (player->counted.load() < 2 * kEventsPerProducer && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    for (auto& player : players) {
+        EXPECT_EQ(player->counted.load(), 2 * kEventsPerProducer);
+        EXPECT_FALSE(player->overlapped.load());
+    }
+}
+
+TEST(ActiveDispatcherTest, should_finish_turn_in_progress_before_object_is_destroyed) {
+    ActiveDispatcher dispatcher(2);
+    bool handlerStillRunning = false;
+    bool countedAfterStop = false;
+    for (int round = 0; round < 200; ++round) {
+        auto player = std::make_unique<Player>(dispatcher, componentId_t::System);
+        player->start();
+        player->send(POWER);
+        for (int i = 0; i < ACTIVE_OBJECT_QUEUE_SIZE; ++i) {
+            player->send(COUNT);
+        }
+        std::this_thread::yield();
+
+        player->stop(); // As ~Player() does, usually while a dispatcher is still in its turn
+        std::uint32_t counted = player->counted.load();
+        handlerStillRunning = handlerStillRunning || player->busy.load();
+        std::this_thread::yield();
+        countedAfterStop = countedAfterStop || player->counted.load() != counted;
+        player.reset();
+    }
+
+    EXPECT_FALSE(handlerStillRunning);
+    EXPECT_FALSE(countedAfterStop);
+}
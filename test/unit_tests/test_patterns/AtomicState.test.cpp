@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "AtomicState.hpp"
+#include "StateMachine.hpp"
+
+/**
+ * TEST CASES
+ * AtomicStateTest
+ * - should_return_immediately_when_state_already_is_expected
+ * - should_wake_waiter_when_state_changes_to_expected
+ * - should_time_out_when_state_never_becomes_expected
+ * - should_return_new_state_when_waiting_until_changed
+ * - should_return_same_state_when_wait_until_changed_times_out
+ * - should_wake_every_waiter_when_state_changes
+ * AtomicStateMachineTest
+ * - should_wake_waiter_when_state_machine_transitions
+ */
+
+#define PUMP_STATES(X) X(STOPPED) X(PRIMING) X(RUNNING)
+
+enum class pumpState_t : std::uint16_t {
+    PUMP_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(pumpState_t, PUMP_STATES)
+
+using namespace std::chrono_literals;
+
+TEST(AtomicStateTest, should_return_immediately_when_state_already_is_expected) {
+    AtomicState<pumpState_t> state(pumpState_t::RUNNING);
+
+    EXPECT_TRUE(state.waitFor(pumpState_t::RUNNING));
+    EXPECT_TRUE(state.waitFor(pumpState_t::RUNNING, 0ms));
+    EXPECT_EQ(state.waitUntilChanged(pumpState_t::STOPPED), pumpState_t::RUNNING);
+}
+
+TEST(AtomicStateTest, should_wake_waiter_when_state_changes_to_expected) {
+    AtomicState<pumpState_t> state(pumpState_t::STOPPED);
+    std::atomic<bool> woke{false};
+    std::thread waiter([&] {
+        woke = state.waitFor(pumpState_t::RUNNING);
+    });
+
+    std::this_thread::sleep_for(5ms);
+    state.exchange(pumpState_t::PRIMING); // Not the state the waiter wants
+    std::this_thread::sleep_for(5ms);
+    EXPECT_FALSE(woke.load());
+    state.exchange(pumpState_t::RUNNING);
+    waiter.join();
+
+    EXPECT_TRUE(woke.load());
+}
+
+TEST(AtomicStateTest, should_time_out_when_state_never_becomes_expected) {
+    AtomicState<pumpState_t> state(pumpState_t::STOPPED);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(state.waitFor(pumpState_t::RUNNING, 20ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+}
+
+TEST(AtomicStateTest, should_return_new_state_when_waiting_until_changed) {
+    AtomicState<pumpState_t> state(pumpState_t::STOPPED);
+    std::thread changer([&] {
+        std::this_thread::sleep_for(5ms);
+        state.exchange(pumpState_t::PRIMING);
+    });
+
+    EXPECT_EQ(state.waitUntilChanged(pumpState_t::STOPPED, 2000ms), pumpState_t::PRIMING);
+    changer.join();
+}
+
+TEST(AtomicStateTest, should_return_same_state_when_wait_until_changed_times_out) {
+    AtomicState<pumpState_t> state(pumpState_t::STOPPED);
+
+    EXPECT_EQ(state.waitUntilChanged(pumpState_t::STOPPED, 10ms), pumpState_t::STOPPED);
+}
+
+TEST(AtomicStateTest, should_wake_every_waiter_when_state_changes) {
+    AtomicState<pumpState_t> state(pumpState_t::STOPPED);
+    std::atomic<int> woken{0};
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 4; ++i) {
+        waiters.emplace_back([&, i] {
+            // Half of them wait without a timeout, half with one
+            bool reached = i % 2 == 0 ? state.waitFor(pumpState_t::RUNNING) : state.waitFor(pumpState_t::RUNNING, 2000ms);
+            woken += reached;
+        });
+    }
+
+    std::this_thread::sleep_for(10ms);
+    state.exchange(pumpState_t::RUNNING);
+    for (std::thread& waiter : waiters) {
+        waiter.join();
+    }
+
+    EXPECT_EQ(woken.load(), 4);
+}
+
+// =============================================================
+
+namespace {
+
+struct Pump {};
+
+constexpr StateMachine<pumpState_t, Pump>::Table kPumpTable{{
+    {pumpState_t::STOPPED, pumpState_t::PRIMING},
+    {pumpState_t::PRIMING, pumpState_t::RUNNING},
+}};
+
+} // namespace
+
+TEST(AtomicStateMachineTest, should_wake_waiter_when_state_machine_transitions) {
+    Pump pump;
+    StateMachine<pumpState_t, Pump> machine(kPumpTable, pump, pumpState_t::STOPPED);
+    std::vector<pumpState_t> seen;
+    std::thread waiter([&] {
+        for (pumpState_t state = pumpState_t::STOPPED; state != pumpState_t::RUNNING;) {
+            state = machine.waitUntilChanged(state);
+            seen.push_back(state);
+        }
+    });
+
+    std::this_thread::sleep_for(5ms);
+    machine.changeToState(pumpState_t::PRIMING);
+    std::this_thread::sleep_for(5ms);
+    machine.changeToState(pumpState_t::RUNNING);
+    waiter.join();
+
+    EXPECT_TRUE(machine.waitFor(pumpState_t::RUNNING, 0ms));
+    ASSERT_FALSE(seen.empty());
+    EXPECT_EQ(seen.back(), pumpState_t::RUNNING);
+}
@@ -317,4 +317,213 @@ TEST_F(CircularBufferTest, should_be_full_when_5_items_are_pushed_given_buffer_s
     EXPECT_EQ(buffer->at(2).value(), "Item 4");
     EXPECT_EQ(buffer->at(3).value(), "Item 5");
     EXPECT_EQ(buffer->at(4).value(), "Item 6");
-}
\ No newline at end of file
+}
+
+// =============================================================
+
+// Fixture for the batch and span API
+class CircularBufferBatchTest : public ::testing::Test {
+protected:
+    CircularBuffer<int, 5> buffer;
+
+    std::vector<int> flatten(const CircularBuffer<int, 5>::Spans<const int>& spans) {
+        std::vector<int> items(spans.first.begin(), spans.first.end());
+        items.insert(items.end(), spans.second.begin(), spans.second.end());
+        return items;
+    }
+};
+
+TEST_F(CircularBufferBatchTest, should_push_block_when_push_n_is_called_given_enough_space) {
+    std::array<int, 3> block = {1, 2, 3};
+
+    EXPECT_EQ(buffer.push_n(block), 3);
+
+    EXPECT_EQ(buffer.size(), 3);
+    EXPECT_EQ(flatten(std::as_const(buffer).peek_spans()), (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(CircularBufferBatchTest, should_overwrite_oldest_items_when_push_n_overflows_given_buffer_size_is_5) {
+    buffer.push(1);
+    buffer.push(2);
+    buffer.push(3);
+    std::array<int, 4> block = {4, 5, 6, 7};
+
+    buffer.push_n(block);
+
+    EXPECT_TRUE(buffer.is_max());
+    EXPECT_EQ(flatten(std::as_const(buffer).peek_spans()), (std::vector<int>{3, 4, 5, 6, 7}));
+}
+
+TEST_F(CircularBufferBatchTest, should_keep_only_newest_items_when_block_is_larger_than_buffer) {
+    std::array<int, 8> block = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    EXPECT_EQ(buffer.push_n(block), 5);
+
+    EXPECT_EQ(flatten(std::as_const(buffer).peek_spans()), (std::vector<int>{4, 5, 6, 7, 8}));
+}
+
+TEST_F(CircularBufferBatchTest, should_return_two_spans_when_buffered_region_wraps_around) {
+    // Given: the write position has wrapped past the end of the storage
+    for (int i = 1; i <= 8; ++i) {
+        buffer.push(i);
+    }
+
+    // When: the buffered region is peeked
+    auto spans = std::as_const(buffer).peek_spans();
+
+    // Then: both spans are non-empty and hold the items oldest first
+    EXPECT_FALSE(spans.first.empty());
+    EXPECT_FALSE(spans.second.empty());
+    EXPECT_EQ(spans.size(), 5);
+    EXPECT_EQ(flatten(spans), (std::vector<int>{4, 5, 6, 7, 8}));
+}
+
+TEST_F(CircularBufferBatchTest, should_release_items_when_commit_is_called_after_peek) {
+    std::array<int, 4> block = {1, 2, 3, 4};
+    buffer.push_n(block);
+
+    auto spans = buffer.peek_spans();
+    ASSERT_EQ(spans.first.front(), 1);
+    EXPECT_EQ(buffer.commit(3), 3);
+
+    EXPECT_EQ(buffer.size(), 1);
+    EXPECT_EQ(buffer.pop().value(), 4);
+    EXPECT_EQ(buffer.commit(10), 0); // Nothing left to release
+}
+
+TEST_F(CircularBufferBatchTest, should_pop_items_in_fifo_order_when_pop_n_is_called_across_the_wrap) {
+    for (int i = 1; i <= 9; ++i) {
+        buffer.push(i);
+    }
+    std::array<int, 3> out{};
+
+    EXPECT_EQ(buffer.pop_n(out), 3);
+    EXPECT_EQ(out, (std::array<int, 3>{5, 6, 7}));
+
+    EXPECT_EQ(buffer.pop_n(out), 2);
+    EXPECT_EQ(out[0], 8);
+    EXPECT_EQ(out[1], 9);
+    EXPECT_TRUE(buffer.is_empty());
+}
+
+TEST(CircularBufferMovableBatchTest, should_move_items_out_when_pop_n_is_called_given_unique_ptr_items) {
+    CircularBuffer<std::unique_ptr<int>, 3> buffer;
+    buffer.push(std::make_unique<int>(1));
+    buffer.push(std::make_unique<int>(2));
+    std::array<std::unique_ptr<int>, 2> out;
+
+    EXPECT_EQ(buffer.pop_n(out), 2);
+
+    EXPECT_EQ(*out[0], 1);
+    EXPECT_EQ(*out[1], 2);
+    EXPECT_TRUE(buffer.is_empty());
+}
+
+// =============================================================
+
+// Counts live instances so slot construction and destruction can be checked
+struct LifetimeTracker {
+    static inline int alive = 0;
+    static inline int defaultConstructed = 0;
+    int value;
+
+    LifetimeTracker() : value(0) { ++alive; ++defaultConstructed; }
+    explicit LifetimeTracker(int v) : value(v) { ++alive; }
+    LifetimeTracker(const LifetimeTracker& other) : value(other.value) { ++alive; }
+    LifetimeTracker(LifetimeTracker&& other) noexcept : value(other.value) { ++alive; }
+    LifetimeTracker& operator=(const LifetimeTracker&) = default;
+    LifetimeTracker& operator=(LifetimeTracker&&) = default;
+    ~LifetimeTracker() { --alive; }
+};
+
+class CircularBufferStorageTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        LifetimeTracker::alive = 0;
+        LifetimeTracker::defaultConstructed = 0;
+    }
+};
+
+TEST_F(CircularBufferStorageTest, should_not_construct_any_slot_when_buffer_is_created) {
+    CircularBuffer<LifetimeTracker, 8> buffer;
+
+    EXPECT_EQ(LifetimeTracker::alive, 0);
+    EXPECT_EQ(LifetimeTracker::defaultConstructed, 0);
+}
+
+TEST_F(CircularBufferStorageTest, should_construct_item_in_place_when_emplace_is_called) {
+    CircularBuffer<LifetimeTracker, 4> buffer;
+
+    EXPECT_TRUE(buffer.emplace(7));
+
+    EXPECT_EQ(LifetimeTracker::alive, 1);
+    EXPECT_EQ(buffer.at(0)->value, 7);
+    EXPECT_FALSE(buffer.at(1).has_value());
+}
+
+TEST_F(CircularBufferStorageTest, should_destroy_items_when_popped_overwritten_committed_or_buffer_destroyed) {
+    {
+        CircularBuffer<LifetimeTracker, 3> buffer;
+        for (int i = 0; i < 5; ++i) {
+            buffer.emplace(i); // The last two overwrite the oldest
+        }
+        EXPECT_EQ(LifetimeTracker::alive, 3);
+
+        buffer.pop();
+        EXPECT_EQ(LifetimeTracker::alive, 2);
+
+        buffer.commit(1);
+        EXPECT_EQ(LifetimeTracker::alive, 1);
+    }
+    EXPECT_EQ(LifetimeTracker::alive, 0);
+}
+
+TEST(CircularBufferSizeTest, should_only_spend_ram_on_items_two_small_indices_and_drop_counter) {
+    // Regression guard for the DRAM footprint: no per-slot flag, no sentinel slot, byte sized indices below 256,
+    // plus the 32-bit overflow counter
+    constexpr std::size_t counter = sizeof(std::uint32_t);
+    EXPECT_EQ(sizeof(CircularBuffer<std::uint8_t, 16>), 16 + 2 + 2 /* padding */ + counter);
+    EXPECT_EQ(sizeof(CircularBuffer<std::uint32_t, 30>), 30 * sizeof(std::uint32_t) + sizeof(std::uint32_t) + counter);
+    EXPECT_EQ(sizeof(CircularBuffer<std::uint16_t, 1000>), 1000 * sizeof(std::uint16_t) + 2 * sizeof(std::uint16_t) + counter);
+    EXPECT_LE(sizeof(CircularBuffer<std::string, 30>), 30 * sizeof(std::string) + alignof(std::string));
+}
+
+// =============================================================
+
+TEST(CircularBufferStatsTest, should_count_pushes_pops_overwrites_and_high_water_mark_given_atomic_stats) {
+    CircularBuffer<int, 4, overflow::OverwriteOldest, stats::Atomic> buffer;
+
+    for (int i = 0; i < 6; ++i) {
+        buffer.push(i); // The last two overwrite
+    }
+    buffer.pop();
+    std::array<int, 2> out{};
+    buffer.pop_n(out);
+    std::array<int, 3> block = {6, 7, 8};
+    buffer.push_n(block);
+    buffer.commit(1);
+
+    auto snapshot = buffer.stats();
+    EXPECT_EQ(snapshot.pushes, 9u);
+    EXPECT_EQ(snapshot.pops, 4u);
+    EXPECT_EQ(snapshot.overwrites, 2u);
+    EXPECT_EQ(snapshot.highWaterMark, 4u);
+}
+
+TEST(CircularBufferStatsTest, should_not_count_rejected_items_as_pushes) {
+    CircularBuffer<int, 2, overflow::RejectNewest, stats::Atomic> buffer;
+
+    buffer.push(1);
+    buffer.push(2);
+    buffer.push(3);
+
+    EXPECT_EQ(buffer.stats().pushes, 2u);
+    EXPECT_EQ(buffer.stats().overwrites, 0u);
+    EXPECT_EQ(buffer.dropped(), 1u);
+}
+
+TEST(CircularBufferStatsTest, should_cost_no_ram_when_stats_are_disabled) {
+    EXPECT_EQ(sizeof(CircularBuffer<int, 8, overflow::OverwriteOldest, stats::None>), sizeof(CircularBuffer<int, 8>));
+    EXPECT_EQ(sizeof(CircularBuffer<int, 8, overflow::OverwriteOldest, stats::Atomic>),
+              sizeof(CircularBuffer<int, 8>) + sizeof(stats::Snapshot));
+}
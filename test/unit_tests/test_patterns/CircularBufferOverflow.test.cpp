@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CircularBuffer.hpp"
+
+/**
+ * TEST CASES
+ * OverwriteOldest
+ * - should_overwrite_oldest_and_count_drop_when_pushing_given_buffer_is_full
+ * RejectNewest
+ * - should_reject_newest_and_keep_buffered_items_when_pushing_given_buffer_is_full
+ * - should_accept_only_free_space_when_push_n_is_called_given_buffer_is_almost_full
+ * BlockWithTimeout
+ * - should_fail_after_timeout_when_pushing_given_buffer_stays_full
+ * - should_complete_push_when_consumer_makes_room_before_timeout
+ * - should_deliver_every_item_when_producer_outpaces_consumer
+ * SpillOldest
+ * - should_spill_oldest_item_instead_of_dropping_when_pushing_given_buffer_is_full
+ * - should_spill_in_fifo_order_when_push_n_overflows
+ */
+
+TEST(OverwriteOldestPolicyTest, should_overwrite_oldest_and_count_drop_when_pushing_given_buffer_is_full) {
+    CircularBuffer<int, 3, overflow::OverwriteOldest> buffer;
+    for (int i = 1; i <= 5; ++i) {
+        EXPECT_TRUE(buffer.push(i));
+    }
+
+    EXPECT_EQ(buffer.at(0), 3);
+    EXPECT_EQ(buffer.dropped(), 2u);
+    EXPECT_EQ(buffer.spilled(), 0u);
+}
+
+// =============================================================
+
+TEST(RejectNewestPolicyTest, should_reject_newest_and_keep_buffered_items_when_pushing_given_buffer_is_full) {
+    CircularBuffer<int, 3, overflow::RejectNewest> buffer;
+    for (int i = 1; i <= 3; ++i) {
+        EXPECT_TRUE(buffer.push(i));
+    }
+
+    EXPECT_FALSE(buffer.push(4));
+    EXPECT_FALSE(buffer.emplace(5));
+
+    EXPECT_EQ(buffer.at(0), 1);
+    EXPECT_EQ(buffer.at(2), 3);
+    EXPECT_EQ(buffer.dropped(), 2u);
+}
+
+TEST(RejectNewestPolicyTest, should_accept_only_free_space_when_push_n_is_called_given_buffer_is_almost_full) {
+    CircularBuffer<int, 4, overflow::RejectNewest> buffer;
+    buffer.push(1);
+    buffer.push(2);
+    std::array<int, 3> block = {3, 4, 5};
+
+    EXPECT_EQ(buffer.push_n(block), 2);
+
+    EXPECT_EQ(buffer.at(3), 4);
+    EXPECT_EQ(buffer.dropped(), 1u);
+}
+
+// =============================================================
+
+TEST(BlockWithTimeoutPolicyTest, should_fail_after_timeout_when_pushing_given_buffer_stays_full) {
+    CircularBuffer<int, 2, overflow::BlockWithTimeout<20>> buffer;
+    buffer.push(1);
+    buffer.push(2);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(buffer.push(3));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    EXPECT_EQ(buffer.dropped(), 1u);
+}
+
+TEST(BlockWithTimeoutPolicyTest, should_complete_push_when_consumer_makes_room_before_timeout) {
+    CircularBuffer<int, 2, overflow::BlockWithTimeout<2000>> buffer;
+    buffer.push(1);
+    buffer.push(2);
+
+    std::thread consumer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        buffer.pop();
+    });
+    EXPECT_TRUE(buffer.push(3));
+    consumer.join();
+
+    EXPECT_EQ(buffer.at(0), 2);
+    EXPECT_EQ(buffer.at(1), 3);
+    EXPECT_EQ(buffer.dropped(), 0u);
+}
+
+TEST(BlockWithTimeoutPolicyTest, should_deliver_every_item_when_producer_outpaces_consumer) {
+    constexpr int kItemCount = 20'000;
+    CircularBuffer<int, 8, overflow::BlockWithTimeout<5000>> buffer;
+
+    std::thread producer([&] {
+        std::array<int, 5> block{};
+        for (int i = 0; i < kItemCount; i += block.size()) {
+            for (std::size_t j = 0; j < block.size(); ++j) {
+                block[j] = i + j;
+            }
+            buffer.push_n(block);
+        }
+    });
+
+    int expected = 0;
+    int outOfOrder = 0;
+    std::array<int, 3> out{};
+    while (expected < kItemCount) {
+        std::size_t count = buffer.pop_n(out);
+        for (std::size_t i = 0; i < count; ++i) {
+            outOfOrder += out[i] != expected++;
+        }
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_EQ(outOfOrder, 0);
+    EXPECT_EQ(buffer.dropped(), 0u);
+}
+
+// =============================================================
+
+namespace {
+std::vector<std::string> spillStorage; // Stands in for RedundancyDataStorage
+
+void spillToStorage(std::string&& item) {
+    spillStorage.push_back(std::move(item));
+}
+} // namespace
+
+class SpillOldestPolicyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spillStorage.clear();
+    }
+
+    CircularBuffer<std::string, 3, overflow::SpillOldest<spillToStorage>> buffer;
+};
+
+TEST_F(SpillOldestPolicyTest, should_spill_oldest_item_instead_of_dropping_when_pushing_given_buffer_is_full) {
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_TRUE(buffer.push("Item " + std::to_string(i)));
+    }
+
+    ASSERT_EQ(spillStorage.size(), 1u);
+    EXPECT_EQ(spillStorage[0], "Item 1");
+    EXPECT_EQ(buffer.at(0), "Item 2");
+    EXPECT_EQ(buffer.spilled(), 1u);
+    EXPECT_EQ(buffer.dropped(), 0u);
+}
+
+TEST_F(SpillOldestPolicyTest, should_spill_in_fifo_order_when_push_n_overflows) {
+    buffer.push("a");
+    buffer.push("b");
+    std::array<std::string, 5> block = {"c", "d", "e", "f", "g"};
+
+    EXPECT_EQ(buffer.push_n(block), 3);
+
+    EXPECT_EQ(spillStorage, (std::vector<std::string>{"a", "b", "c", "d"}));
+    EXPECT_EQ(buffer.at(0), "e");
+    EXPECT_EQ(buffer.at(2), "g");
+    EXPECT_EQ(buffer.spilled(), 4u);
+}
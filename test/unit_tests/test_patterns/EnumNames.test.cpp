@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include "ComponentId.hpp"
+#include "EnumNames.hpp"
+
+/**
+ * TEST CASES
+ * EnumNamesTest
+ * - should_resolve_name_at_compile_time_when_enum_has_table
+ * - should_return_unknown_when_value_is_outside_table
+ * - should_resolve_captured_pair_when_looked_up_by_table_id
+ * - should_not_be_named_given_enum_has_no_table
+ */
+
+#define PUMP_STATES(X) X(IDLE) X(PRIMING) X(RUNNING)
+
+enum class pumpState_t : std::uint16_t {
+    PUMP_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(pumpState_t, PUMP_STATES)
+
+enum class unnamed_t { A, B };
+
+TEST(EnumNamesTest, should_resolve_name_at_compile_time_when_enum_has_table) {
+    static_assert(enum_names::count<pumpState_t>() == 3);
+    static_assert(std::string_view(enum_names::nameOf(pumpState_t::PRIMING)) == "PRIMING");
+    static_assert(std::string_view(enum_names::nameOf(componentId_t::MqttManager)) == "MqttManager");
+
+    EXPECT_STREQ(enum_names::nameOf(pumpState_t::RUNNING), "RUNNING");
+}
+
+TEST(EnumNamesTest, should_return_unknown_when_value_is_outside_table) {
+    EXPECT_STREQ(enum_names::nameOf(static_cast<pumpState_t>(7)), enum_names::kUnknown);
+}
+
+TEST(EnumNamesTest, should_resolve_captured_pair_when_looked_up_by_table_id) {
+    std::uint16_t pumpTable = enum_names::tableId<pumpState_t>();
+    std::uint16_t componentTable = enum_names::tableId<componentId_t>();
+
+    EXPECT_NE(pumpTable, componentTable);
+    EXPECT_EQ(enum_names::tableId<pumpState_t>(), pumpTable);
+    EXPECT_STREQ(enum_names::lookup(pumpTable, 2), "RUNNING");
+    EXPECT_STREQ(enum_names::lookup(componentTable, 0), "WifiManager");
+    EXPECT_STREQ(enum_names::lookup(pumpTable, 3), enum_names::kUnknown);
+    EXPECT_STREQ(enum_names::lookup(enum_names::kNoTable, 0), enum_names::kUnknown);
+}
+
+TEST(EnumNamesTest, should_not_be_named_given_enum_has_no_table) {
+    static_assert(enum_names::Named<pumpState_t>);
+    static_assert(!enum_names::Named<unnamed_t>);
+    static_assert(!enum_names::Named<int>);
+    SUCCEED();
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "EventBus.hpp"
+#include "StatefulObject.hpp"
+
+/**
+ * TEST CASES
+ * EventBusTest
+ * - should_deliver_only_matching_events_when_filter_restricts_component_and_type
+ * - should_drop_and_count_event_when_queue_is_full
+ * - should_stop_delivering_when_subscriber_unsubscribes
+ * - should_reject_subscription_when_all_slots_are_taken
+ * EventBusDispatcherTest
+ * - should_deliver_in_publish_order_on_dispatcher_task_when_events_are_published
+ * - should_return_immediately_when_publishing_given_subscriber_is_slow
+ * - should_publish_state_change_when_stateful_object_logged_changes_state
+ */
+
+#define DOOR_STATES(X) X(CLOSED) X(OPEN)
+
+enum class doorState_t : std::uint16_t {
+    DOOR_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(doorState_t, DOOR_STATES)
+
+TEST(EventBusTest, should_deliver_only_matching_events_when_filter_restricts_component_and_type) {
+    EventBus bus(false);
+    std::vector<Event> wifiStates;
+    std::vector<Event> faults;
+    std::vector<Event> all;
+    bus.subscribe(EventFilter::any().components(componentId_t::WifiManager).types(eventType_t::STATE_CHANGED),
+                  [&](const Event& event) { wifiStates.push_back(event); });
+    bus.subscribe(EventFilter::any().types(eventType_t::FAULT), [&](const Event& event) { faults.push_back(event); });
+    bus.subscribe(EventFilter::any(), [&](const Event& event) { all.push_back(event); });
+
+    bus.publish(Event::stateChanged(componentId_t::WifiManager, doorState_t::OPEN));
+    bus.publish(Event::stateChanged(componentId_t::MqttManager, doorState_t::OPEN));
+    bus.publish(Event::fault(componentId_t::WifiManager, 7));
+    EXPECT_EQ(bus.dispatchPending(), 3u);
+
+    ASSERT_EQ(wifiStates.size(), 1u);
+    EXPECT_TRUE(wifiStates[0].is(componentId_t::WifiManager, doorState_t::OPEN));
+    ASSERT_EQ(faults.size(), 1u);
+    EXPECT_EQ(faults[0].value, 7);
+    EXPECT_EQ(all.size(), 3u);
+}
+
+TEST(EventBusTest, should_drop_and_count_event_when_queue_is_full) {
+    EventBus bus(false);
+    std::size_t delivered = 0;
+    bus.subscribe(EventFilter::any(), [&](const Event&) { ++delivered; });
+
+    for (int i = 0; i < EVENT_BUS_QUEUE_SIZE; ++i) {
+        EXPECT_TRUE(bus.publish(Event::fault(componentId_t::System, 1)));
+    }
+    EXPECT_FALSE(bus.publish(Event::fault(componentId_t::System, 2)));
+    bus.dispatchPending();
+
+    EXPECT_EQ(delivered, static_cast<std::size_t>(EVENT_BUS_QUEUE_SIZE));
+    EXPECT_EQ(bus.droppedEvents(), 1u);
+}
+
+TEST(EventBusTest, should_stop_delivering_when_subscriber_unsubscribes) {
+    EventBus bus(false);
+    std::size_t delivered = 0;
+    EventBus::SubscriptionId id = bus.subscribe(EventFilter::any(), [&](const Event&) { ++delivered; });
+
+    bus.publish(Event::fault(componentId_t::System, 1));
+    bus.dispatchPending();
+    bus.unsubscribe(id);
+    bus.publish(Event::fault(componentId_t::System, 1));
+    bus.dispatchPending();
+
+    EXPECT_EQ(delivered, 1u);
+}
+
+TEST(EventBusTest, should_reject_subscription_when_all_slots_are_taken) {
+    EventBus bus(false);
+    for (int i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; ++i) {
+        EXPECT_NE(bus.subscribe(EventFilter::any(), [](const Event&) {}), EventBus::kInvalidSubscription);
+    }
+
+    EXPECT_EQ(bus.subscribe(EventFilter::any(), [](const Event&) {}), EventBus::kInvalidSubscription);
+    bus.unsubscribe(3);
+    EXPECT_EQ(bus.subscribe(EventFilter::any(), [](const Event&) {}), 3);
+}
+
+// =============================================================
+
+class EventBusDispatcherTest : public ::testing::Test {
+protected:
+    // Wait until the dispatcher delivered count events, false on timeout
+    bool waitForDeliveries(std::size_t count, std::chrono::milliseconds timeout = std::chrono::seconds(2)) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (delivered.load() < count) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    std::atomic<std::size_t> delivered{0};
+};
+
+TEST_F(EventBusDispatcherTest, should_deliver_in_publish_order_on_dispatcher_task_when_events_are_published) {
+    EventBus bus;
+    std::mutex mtx;
+    std::vector<std::uint32_t> order;
+    std::thread::id handlerThread;
+    bus.subscribe(EventFilter::any(), [&](const Event& event) {
+        std::lock_guard<std::mutex> lock(mtx);
+        order.push_back(event.detail);
+        handlerThread = std::this_thread::get_id();
+        ++delivered;
+    });
+
+    for (std::uint32_t i = 0; i < 200; ++i) {
+        while (!bus.publish(Event::fault(componentId_t::System, 0, i))) {
+            std::this_thread::yield();
+        }
+    }
+    ASSERT_TRUE(waitForDeliveries(200));
+
+    std::lock_guard<std::mutex> lock(mtx);
+    EXPECT_NE(handlerThread, std::this_thread::get_id());
+    for (std::uint32_t i = 0; i < order.size(); ++i) {
+        ASSERT_EQ(order[i], i);
+    }
+}
+
+TEST_F(EventBusDispatcherTest, should_return_immediately_when_publishing_given_subscriber_is_slow) {
+    EventBus bus;
+    bus.subscribe(EventFilter::any(), [&](const Event&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // e.g. an LED driver doing I/O
+        ++delivered;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(bus.publish(Event::fault(componentId_t::System, 1)));
+    }
+    auto publishTime = std::chrono::steady_clock::now() - start;
+
+    EXPECT_LT(publishTime, std::chrono::milliseconds(20));
+    EXPECT_TRUE(waitForDeliveries(5));
+}
+
+TEST_F(EventBusDispatcherTest, should_publish_state_change_when_stateful_object_logged_changes_state) {
+    class Door : public StatefulObjectLogged<doorState_t> {
+    public:
+        Door() : StatefulObjectLogged<doorState_t>(componentId_t::SDCard, doorState_t::CLOSED) {}
+    } door;
+    std::atomic<bool> opened{false};
+    EventBus& bus = EventBus::getInstance();
+    EventBus::SubscriptionId id = bus.subscribe(EventFilter::any().components(componentId_t::SDCard), [&](const Event& event) {
+        opened = opened || event.is(componentId_t::SDCard, doorState_t::OPEN);
+        ++delivered;
+    });
+
+    door.setState(doorState_t::OPEN);
+    bool deliveredInTime = waitForDeliveries(1);
+    bus.unsubscribe(id);
+
+    EXPECT_TRUE(deliveredInTime);
+    EXPECT_TRUE(opened);
+}
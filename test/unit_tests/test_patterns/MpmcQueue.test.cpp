@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "MpmcQueue.hpp"
+
+/**
+ * TEST CASES
+ * MpmcQueueTest
+ * - should_push_and_pop_items_in_fifo_order_given_single_thread
+ * - should_reject_push_when_queue_is_full
+ * - should_return_nullopt_after_timeout_when_popping_from_empty_queue
+ * - should_fail_push_after_timeout_when_queue_stays_full
+ * - should_pop_item_pushed_by_other_thread_before_timeout
+ *
+ * MpmcQueueWaitTest
+ * - should_sleep_until_item_is_published_when_popping_waitable_queue
+ * - should_sleep_until_slot_is_freed_when_pushing_full_waitable_queue
+ *
+ * MpmcQueueStressTest
+ * - should_deliver_every_item_exactly_once_given_multiple_producers_and_consumers
+ * - should_keep_per_producer_order_given_single_consumer
+ */
+
+class MpmcQueueTest : public ::testing::Test {
+protected:
+    MpmcQueue<int, 4> queue;
+};
+
+TEST_F(MpmcQueueTest, should_push_and_pop_items_in_fifo_order_given_single_thread) {
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+    EXPECT_EQ(queue.size(), 2);
+
+    EXPECT_EQ(queue.try_pop().value(), 1);
+    EXPECT_EQ(queue.try_pop().value(), 2);
+    EXPECT_TRUE(queue.is_empty());
+}
+
+TEST_F(MpmcQueueTest, should_reject_push_when_queue_is_full) {
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+
+    EXPECT_EQ(queue.try_pop().value(), 0);
+    EXPECT_TRUE(queue.try_push(4));
+}
+
+TEST_F(MpmcQueueTest, should_return_nullopt_after_timeout_when_popping_from_empty_queue) {
+    auto start = std::chrono::steady_clock::now();
+    auto item = queue.pop_for(std::chrono::milliseconds(20));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_FALSE(item.has_value());
+    EXPECT_GE(elapsed, std::chrono::milliseconds(20));
+}
+
+TEST_F(MpmcQueueTest, should_fail_push_after_timeout_when_queue_stays_full) {
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.push_for(4, std::chrono::milliseconds(10)));
+}
+
+TEST_F(MpmcQueueTest, should_pop_item_pushed_by_other_thread_before_timeout) {
+    std::thread producer([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        queue.try_push(42);
+    });
+
+    auto item = queue.pop_for(std::chrono::seconds(2));
+    producer.join();
+
+    ASSERT_TRUE(item.has_value());
+    EXPECT_EQ(*item, 42);
+}
+
+TEST(MpmcQueueWaitTest, should_sleep_until_item_is_published_when_popping_waitable_queue) {
+    MpmcQueue<int, 4, true> queue;
+    std::thread producer([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        queue.try_push(42);
+    });
+
+    EXPECT_EQ(queue.pop_wait(), 42);
+    producer.join();
+}
+
+TEST(MpmcQueueWaitTest, should_sleep_until_slot_is_freed_when_pushing_full_waitable_queue) {
+    MpmcQueue<int, 2, true> queue;
+    queue.try_push(1);
+    queue.try_push(2);
+    std::thread consumer([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        queue.try_pop();
+    });
+
+    queue.push_wait(3);
+    consumer.join();
+
+    EXPECT_EQ(queue.try_pop().value(), 2);
+    EXPECT_EQ(queue.try_pop().value(), 3);
+}
+
+// =============================================================
+
+TEST(MpmcQueueStressTest, should_deliver_every_item_exactly_once_given_multiple_producers_and_consumers) {
+    // Given: 4 producers and 2 consumers sharing a small queue
+    constexpr int kProducers = 4;
+    constexpr int kConsumers = 2;
+    constexpr std::uint32_t kItemsPerProducer = 250'000;
+    constexpr std::uint32_t kTotal = kProducers * kItemsPerProducer;
+    auto queue = std::make_unique<MpmcQueue<std::uint32_t, 128>>();
+    std::vector<std::atomic<std::uint8_t>> seen(kTotal);
+    std::atomic<std::uint32_t> received{0};
+
+    // When: every producer pushes its own id range while the consumers drain concurrently
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&, p] {
+            for (std::uint32_t i = 0; i < kItemsPerProducer; ++i) {
+                while (!queue->try_push(p * kItemsPerProducer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&] {
+            while (received.load() < kTotal) {
+                if (auto item = queue->try_pop()) {
+                    seen[*item].fetch_add(1);
+                    received.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Then: each id was delivered exactly once
+    std::uint32_t missingOrDuplicated = 0;
+    for (auto& count : seen) {
+        missingOrDuplicated += count.load() != 1;
+    }
+    EXPECT_EQ(missingOrDuplicated, 0u);
+    EXPECT_TRUE(queue->is_empty());
+}
+
+TEST(MpmcQueueStressTest, should_keep_per_producer_order_given_single_consumer) {
+    constexpr int kProducers = 3;
+    constexpr std::uint32_t kItemsPerProducer = 200'000;
+    auto queue = std::make_unique<MpmcQueue<std::pair<int, std::uint32_t>, 64>>();
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (std::uint32_t i = 0; i < kItemsPerProducer; ++i) {
+                while (!queue->try_push({p, i})) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<std::uint32_t> next(kProducers, 0);
+    std::uint32_t outOfOrder = 0;
+    for (std::uint32_t received = 0; received < kProducers * kItemsPerProducer;) {
+        auto item = queue->pop_for(std::chrono::seconds(5));
+        ASSERT_TRUE(item.has_value());
+        auto [producer, sequence] = *item;
+        outOfOrder += sequence != next[producer];
+        next[producer] = sequence + 1;
+        ++received;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(outOfOrder, 0u);
+}
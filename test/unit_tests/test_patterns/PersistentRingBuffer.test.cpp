@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include "PersistentRingBuffer.hpp"
+
+/**
+ * Restarts are simulated by destroying the ring and its mapping, then mapping the same file again.
+ *
+ * TEST CASES
+ * PersistentRingBufferTest
+ * - should_start_empty_when_storage_is_fresh
+ * - should_recover_items_in_fifo_order_when_reopened_after_restart
+ * - should_keep_overwrite_and_drop_count_when_reopened_after_wrap_around
+ * - should_fall_back_to_previous_header_when_latest_header_is_torn
+ * - should_start_empty_when_both_headers_are_corrupted
+ * - should_start_empty_when_storage_holds_ring_of_different_layout
+ * - should_refuse_push_when_storage_is_too_small
+ */
+
+namespace {
+
+struct Sample {
+    std::uint32_t timestamp;
+    float value;
+};
+
+using SampleRing = PersistentRingBuffer<Sample, 4, MappedFileStorage>;
+
+} // namespace
+
+class PersistentRingBufferTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = ::testing::TempDir() + "persistent_ring_" +
+               ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".bin";
+        std::remove(path.c_str());
+        boot();
+    }
+
+    void TearDown() override {
+        ring.reset();
+        storage.reset();
+        std::remove(path.c_str());
+    }
+
+    // Drop everything held in RAM and come back up on the same backing file
+    void boot() {
+        ring.reset();
+        storage = std::make_unique<MappedFileStorage>(path, SampleRing::kStorageBytes);
+        ASSERT_TRUE(storage->isOpen());
+        ring = std::make_unique<SampleRing>(*storage);
+    }
+
+    std::string path;
+    std::unique_ptr<MappedFileStorage> storage;
+    std::unique_ptr<SampleRing> ring;
+};
+
+TEST_F(PersistentRingBufferTest, should_start_empty_when_storage_is_fresh) {
+    EXPECT_FALSE(ring->recovered());
+    EXPECT_TRUE(ring->is_empty());
+    EXPECT_FALSE(ring->pop().has_value());
+}
+
+TEST_F(PersistentRingBufferTest, should_recover_items_in_fifo_order_when_reopened_after_restart) {
+    // Given: two samples buffered before a restart
+    ring->push({100, 1.5f});
+    ring->push({200, 2.5f});
+
+    // When: the device restarts
+    boot();
+
+    // Then: both samples come back in order
+    EXPECT_TRUE(ring->recovered());
+    ASSERT_EQ(ring->size(), 2u);
+    EXPECT_EQ(ring->pop()->timestamp, 100u);
+    EXPECT_EQ(ring->pop()->timestamp, 200u);
+
+    // And: the pops themselves are persisted too
+    boot();
+    EXPECT_TRUE(ring->is_empty());
+}
+
+TEST_F(PersistentRingBufferTest, should_keep_overwrite_and_drop_count_when_reopened_after_wrap_around) {
+    for (std::uint32_t i = 1; i <= 6; ++i) {
+        ring->push({i, 0.0f});
+    }
+
+    boot();
+
+    EXPECT_TRUE(ring->is_max());
+    EXPECT_EQ(ring->dropped(), 2u);
+    for (std::uint32_t expected = 3; expected <= 6; ++expected) {
+        EXPECT_EQ(ring->pop()->timestamp, expected);
+    }
+}
+
+TEST_F(PersistentRingBufferTest, should_fall_back_to_previous_header_when_latest_header_is_torn) {
+    ring->push({1, 0.0f});
+    ring->push({2, 0.0f}); // Constructor wrote sequence 1, pushes wrote 2 and 3: copy 1 holds the latest header
+
+    // Simulate a reset in the middle of writing the latest header copy
+    storage->data()[32 + 16] ^= std::byte{0xFF};
+    boot();
+
+    // The previous header (one item) is used, the second push is lost but nothing is corrupted
+    EXPECT_TRUE(ring->recovered());
+    ASSERT_EQ(ring->size(), 1u);
+    EXPECT_EQ(ring->pop()->timestamp, 1u);
+}
+
+TEST_F(PersistentRingBufferTest, should_start_empty_when_both_headers_are_corrupted) {
+    ring->push({1, 0.0f});
+    storage->data()[4] ^= std::byte{0x01};
+    storage->data()[32 + 4] ^= std::byte{0x01};
+
+    boot();
+
+    EXPECT_FALSE(ring->recovered());
+    EXPECT_TRUE(ring->is_empty());
+}
+
+TEST_F(PersistentRingBufferTest, should_start_empty_when_storage_holds_ring_of_different_layout) {
+    ring->push({1, 0.0f});
+    ring.reset();
+
+    // A firmware update changed the ring capacity
+    using BiggerRing = PersistentRingBuffer<Sample, 8, MappedFileStorage>;
+    MappedFileStorage biggerStorage(path, BiggerRing::kStorageBytes);
+    BiggerRing bigger(biggerStorage);
+
+    EXPECT_FALSE(bigger.recovered());
+    EXPECT_TRUE(bigger.is_empty());
+}
+
+TEST(PersistentRingBufferRegionTest, should_refuse_push_when_storage_is_too_small) {
+    std::byte memory[16] = {};
+    MemoryRegionStorage storage(memory);
+    PersistentRingBuffer<Sample, 4, MemoryRegionStorage> ring(storage);
+
+    EXPECT_FALSE(ring.push({1, 0.0f}));
+    EXPECT_TRUE(ring.is_empty());
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Signal.hpp"
+
+/**
+ * TEST CASES
+ * SignalTest
+ * - should_call_slots_in_connect_order_when_emitted
+ * - should_stop_calling_slot_when_connection_is_destroyed
+ * - should_keep_slot_connected_when_connection_is_moved
+ * - should_skip_slot_when_earlier_slot_disconnects_it_during_emit
+ * - should_call_slot_from_next_emit_on_when_connected_during_emit
+ * - should_drop_weak_slot_when_object_has_expired
+ * SignalLifetimeTest
+ * - should_leave_connection_disconnected_when_signal_is_destroyed
+ */
+
+namespace {
+
+std::vector<int> calls;
+
+void recordFree(int value) {
+    calls.push_back(-value);
+}
+
+struct Recorder {
+    int id;
+
+    void record(int value) {
+        calls.push_back(id * 100 + value);
+    }
+};
+
+} // namespace
+
+class SignalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        calls.clear();
+    }
+
+    Signal<int> signal;
+};
+
+TEST_F(SignalTest, should_call_slots_in_connect_order_when_emitted) {
+    Recorder first{1};
+    Recorder second{2};
+    Connection a = signal.connect<&Recorder::record>(first);
+    Connection b = signal.connect(&recordFree);
+    Connection c = signal.connect<&Recorder::record>(second);
+
+    signal.emit(7);
+
+    EXPECT_EQ(calls, (std::vector<int>{107, -7, 207}));
+}
+
+TEST_F(SignalTest, should_stop_calling_slot_when_connection_is_destroyed) {
+    Recorder recorder{1};
+    {
+        Connection scoped = signal.connect<&Recorder::record>(recorder);
+        signal.emit(1);
+    }
+    signal.emit(2);
+
+    EXPECT_EQ(calls, (std::vector<int>{101}));
+    EXPECT_TRUE(signal.empty());
+}
+
+TEST_F(SignalTest, should_keep_slot_connected_when_connection_is_moved) {
+    Recorder first{1};
+    Recorder second{2};
+    Connection a = signal.connect<&Recorder::record>(first);
+    Connection b = signal.connect<&Recorder::record>(second);
+    std::vector<Connection> owned;
+    owned.push_back(std::move(a));
+    owned.push_back(std::move(b)); // Reallocates, moving the first node again
+
+    signal.emit(3);
+
+    EXPECT_FALSE(a.connected());
+    EXPECT_TRUE(owned[0].connected());
+    EXPECT_EQ(calls, (std::vector<int>{103, 203}));
+}
+
+TEST_F(SignalTest, should_skip_slot_when_earlier_slot_disconnects_it_during_emit) {
+    struct Disconnector {
+        Connection* victim;
+
+        void run(int) {
+            calls.push_back(0);
+            victim->disconnect();
+        }
+    } disconnector{nullptr};
+    Recorder recorder{1};
+    Connection a = signal.connect<&Disconnector::run>(disconnector);
+    Connection b = signal.connect<&Recorder::record>(recorder);
+    disconnector.victim = &b;
+
+    signal.emit(4);
+    signal.emit(5);
+
+    EXPECT_EQ(calls, (std::vector<int>{0, 0}));
+}
+
+TEST_F(SignalTest, should_call_slot_from_next_emit_on_when_connected_during_emit) {
+    struct Connector {
+        Signal<int>* signal;
+        Recorder* recorder;
+        Connection added;
+
+        void run(int) {
+            if (!added.connected()) {
+                added = signal->connect<&Recorder::record>(*recorder);
+            }
+        }
+    };
+    Recorder recorder{1};
+    Connector connector{&signal, &recorder, {}};
+    Connection a = signal.connect<&Connector::run>(connector);
+
+    signal.emit(1);
+    signal.emit(2);
+
+    EXPECT_EQ(calls, (std::vector<int>{102}));
+}
+
+TEST_F(SignalTest, should_drop_weak_slot_when_object_has_expired) {
+    auto recorder = std::make_shared<Recorder>(Recorder{1});
+    Connection connection = signal.connect<&Recorder::record>(std::weak_ptr<Recorder>(recorder));
+
+    signal.emit(1);
+    recorder.reset();
+    signal.emit(2);
+
+    EXPECT_EQ(calls, (std::vector<int>{101}));
+    EXPECT_FALSE(connection.connected());
+}
+
+TEST(SignalLifetimeTest, should_leave_connection_disconnected_when_signal_is_destroyed) {
+    Recorder recorder{1};
+    Connection connection;
+    {
+        Signal<int> shortLived;
+        connection = shortLived.connect<&Recorder::record>(recorder);
+        EXPECT_TRUE(connection.connected());
+    }
+
+    EXPECT_FALSE(connection.connected());
+    connection.disconnect(); // No-op, the signal is gone
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include "SpscRingBuffer.hpp"
+
+/**
+ * TEST CASES
+ * SpscRingBufferTest
+ * - should_push_and_pop_items_in_fifo_order
+ * - should_reject_push_when_buffer_is_full
+ * - should_return_nullopt_when_popping_from_empty_buffer
+ * - should_wrap_around_when_items_are_pushed_and_popped_repeatedly
+ * - should_push_and_pop_unique_ptr_items
+ * - should_construct_in_place_and_destroy_on_pop_when_item_has_no_default_constructor
+ *
+ * SpscRingBufferStressTest
+ * - should_not_lose_or_reorder_items_when_producer_and_consumer_run_concurrently
+ */
+
+class SpscRingBufferTest : public ::testing::Test {
+protected:
+    SpscRingBuffer<int, 4> buffer;
+};
+
+TEST_F(SpscRingBufferTest, should_push_and_pop_items_in_fifo_order) {
+    EXPECT_TRUE(buffer.push(1));
+    EXPECT_TRUE(buffer.push(2));
+    EXPECT_TRUE(buffer.push(3));
+    ASSERT_EQ(buffer.size(), 3);
+
+    EXPECT_EQ(buffer.pop().value(), 1);
+    EXPECT_EQ(buffer.pop().value(), 2);
+    EXPECT_EQ(buffer.pop().value(), 3);
+    EXPECT_TRUE(buffer.is_empty());
+}
+
+TEST_F(SpscRingBufferTest, should_reject_push_when_buffer_is_full) {
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(buffer.push(i));
+    }
+    EXPECT_TRUE(buffer.is_max());
+
+    // Unlike CircularBuffer the oldest item is never overwritten
+    EXPECT_FALSE(buffer.push(99));
+    EXPECT_EQ(buffer.pop().value(), 0);
+    EXPECT_TRUE(buffer.push(4));
+}
+
+TEST_F(SpscRingBufferTest, should_return_nullopt_when_popping_from_empty_buffer) {
+    EXPECT_TRUE(buffer.is_empty());
+    EXPECT_FALSE(buffer.pop().has_value());
+}
+
+TEST_F(SpscRingBufferTest, should_wrap_around_when_items_are_pushed_and_popped_repeatedly) {
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(buffer.push(i));
+        ASSERT_TRUE(buffer.push(i + 1000));
+        ASSERT_EQ(buffer.pop().value(), i);
+        ASSERT_EQ(buffer.pop().value(), i + 1000);
+    }
+    EXPECT_TRUE(buffer.is_empty());
+}
+
+TEST(SpscRingBufferMovableTest, should_push_and_pop_unique_ptr_items) {
+    SpscRingBuffer<std::unique_ptr<std::string>, 2> buffer;
+
+    EXPECT_TRUE(buffer.push(std::make_unique<std::string>("hello")));
+    EXPECT_TRUE(buffer.emplace(new std::string("world")));
+
+    EXPECT_EQ(**buffer.pop(), "hello");
+    EXPECT_EQ(**buffer.pop(), "world");
+}
+
+TEST(SpscRingBufferMovableTest, should_construct_in_place_and_destroy_on_pop_when_item_has_no_default_constructor) {
+    static int alive = 0;
+    struct Tracked {
+        Tracked(int id, const char* name) : id(id), name(name) {
+            ++alive;
+        }
+        Tracked(Tracked&& other) noexcept : id(other.id), name(std::move(other.name)) {
+            ++alive;
+        }
+        Tracked& operator=(Tracked&&) = delete;
+        ~Tracked() {
+            --alive;
+        }
+
+        int id;
+        std::string name;
+    };
+    {
+        SpscRingBuffer<Tracked, 4> buffer;
+        EXPECT_EQ(alive, 0); // No slot constructed up front
+
+        EXPECT_TRUE(buffer.emplace(1, "first"));
+        EXPECT_TRUE(buffer.emplace(2, "second"));
+        EXPECT_EQ(alive, 2);
+
+        std::optional<Tracked> item = buffer.pop();
+        EXPECT_EQ(item->id, 1);
+        EXPECT_EQ(item->name, "first");
+        EXPECT_EQ(alive, 2); // The popped slot is destroyed, its value lives on in item
+    }
+    EXPECT_EQ(alive, 0); // The item left in the ring is destroyed with it
+}
+
+// =============================================================
+
+TEST(SpscRingBufferStressTest, should_not_lose_or_reorder_items_when_producer_and_consumer_run_concurrently) {
+    // Given: a small ring so that both the full and the empty path are hit constantly
+    constexpr std::uint32_t kItemCount = 2'000'000;
+    auto buffer = std::make_unique<SpscRingBuffer<std::uint32_t, 64>>();
+
+    // When: one thread pushes a strictly increasing sequence while another pops it
+    std::thread producer([&] {
+        for (std::uint32_t i = 0; i < kItemCount; ++i) {
+            while (!buffer->push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::uint32_t expected = 0;
+    std::uint32_t outOfOrder = 0;
+    while (expected < kItemCount) {
+        auto item = buffer->pop();
+        if (!item.has_value()) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (*item != expected) {
+            ++outOfOrder;
+        }
+        ++expected;
+    }
+    producer.join();
+
+    // Then: every item arrived exactly once and in order
+    EXPECT_EQ(outOfOrder, 0u);
+    EXPECT_TRUE(buffer->is_empty());
+}
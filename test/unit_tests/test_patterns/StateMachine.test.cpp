@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StateMachine.hpp"
+
+/**
+ * TEST CASES
+ * StateMachineTest
+ * - should_build_transition_table_when_compiling
+ * - should_run_exit_transition_and_entry_actions_in_order_when_transition_is_allowed
+ * - should_keep_state_and_skip_actions_when_transition_is_not_in_table
+ * - should_reenter_state_when_self_transition_is_in_table
+ * - should_see_new_state_from_entry_action_when_changing_state
+ * - should_run_actions_once_per_accepted_transition_when_tasks_change_state_concurrently
+ * StateMachineLoggedTest
+ * - should_log_and_publish_when_logged_machine_changes_state
+ */
+
+#define LINK_STATES(X) X(IDLE) X(CONNECTING) X(UP) X(FAILED)
+
+enum class linkState_t : std::uint16_t {
+    LINK_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(linkState_t, LINK_STATES)
+
+namespace {
+
+struct Link {
+    std::vector<std::string> trace;
+    linkState_t stateSeenOnEntry{linkState_t::IDLE};
+    const StateMachine<linkState_t, Link>* machine{nullptr};
+
+    static void exitIdle(Link& link, linkState_t, linkState_t to) {
+        link.trace.push_back(std::string("exit IDLE to ") + enum_names::nameOf(to));
+    }
+
+    static void dial(Link& link, linkState_t, linkState_t) {
+        link.trace.push_back("dial");
+    }
+
+    static void enterConnecting(Link& link, linkState_t from, linkState_t) {
+        link.trace.push_back(std::string("enter CONNECTING from ") + enum_names::nameOf(from));
+        if (link.machine != nullptr) {
+            link.stateSeenOnEntry = link.machine->getState();
+        }
+    }
+
+    static void retry(Link& link, linkState_t, linkState_t) {
+        link.trace.push_back("retry");
+    }
+};
+
+constexpr StateMachine<linkState_t, Link>::Table kLinkTable{
+    {
+        {linkState_t::IDLE, linkState_t::CONNECTING, &Link::dial},
+        {linkState_t::CONNECTING, linkState_t::UP},
+        {linkState_t::CONNECTING, linkState_t::FAILED},
+        {linkState_t::FAILED, linkState_t::FAILED, &Link::retry},
+        {linkState_t::UP, linkState_t::IDLE},
+    },
+    {
+        {linkState_t::IDLE, nullptr, &Link::exitIdle},
+        {linkState_t::CONNECTING, &Link::enterConnecting},
+    }};
+
+// Counts entries and exits from several tasks, like WifiManager changed by the esp_event loop and by reconnect()
+struct Race {
+    std::atomic<std::uint32_t> entered[4]{};
+    std::atomic<std::uint32_t> exited[4]{};
+
+    static void enter(Race& race, linkState_t, linkState_t to) {
+        race.entered[static_cast<std::size_t>(to)].fetch_add(1);
+    }
+
+    static void exit(Race& race, linkState_t from, linkState_t) {
+        race.exited[static_cast<std::size_t>(from)].fetch_add(1);
+        std::this_thread::yield(); // Let the other task race this transition even on one core
+    }
+};
+
+constexpr StateMachine<linkState_t, Race>::Table kRaceTable{
+    {
+        {linkState_t::IDLE, linkState_t::CONNECTING},
+        {linkState_t::CONNECTING, linkState_t::UP},
+        {linkState_t::CONNECTING, linkState_t::FAILED},
+        {linkState_t::UP, linkState_t::IDLE},
+        {linkState_t::FAILED, linkState_t::IDLE},
+    },
+    {
+        {linkState_t::IDLE, &Race::enter, &Race::exit},
+        {linkState_t::CONNECTING, &Race::enter, &Race::exit},
+        {linkState_t::UP, &Race::enter, &Race::exit},
+        {linkState_t::FAILED, &Race::enter, &Race::exit},
+    }};
+
+} // namespace
+
+TEST(StateMachineTest, should_build_transition_table_when_compiling) {
+    static_assert(kLinkTable.allows(linkState_t::IDLE, linkState_t::CONNECTING));
+    static_assert(!kLinkTable.allows(linkState_t::IDLE, linkState_t::UP));
+    static_assert(!kLinkTable.allows(linkState_t::UP, linkState_t::UP));
+    static_assert(kLinkTable.transitionAction(linkState_t::IDLE, linkState_t::CONNECTING) == &Link::dial);
+    EXPECT_FALSE(kLinkTable.allows(static_cast<linkState_t>(42), linkState_t::IDLE));
+}
+
+TEST(StateMachineTest, should_run_exit_transition_and_entry_actions_in_order_when_transition_is_allowed) {
+    Link link;
+    StateMachine<linkState_t, Link> machine(kLinkTable, link, linkState_t::IDLE);
+
+    EXPECT_TRUE(machine.changeToState(linkState_t::CONNECTING));
+
+    EXPECT_EQ(machine.getState(), linkState_t::CONNECTING);
+    EXPECT_EQ(link.trace, (std::vector<std::string>{"exit IDLE to CONNECTING", "dial", "enter CONNECTING from IDLE"}));
+}
+
+TEST(StateMachineTest, should_keep_state_and_skip_actions_when_transition_is_not_in_table) {
+    Link link;
+    StateMachine<linkState_t, Link> machine(kLinkTable, link, linkState_t::IDLE);
+
+    EXPECT_FALSE(machine.changeToState(linkState_t::UP));
+    EXPECT_FALSE(machine.changeToState(linkState_t::IDLE)); // No IDLE -> IDLE in the table
+
+    EXPECT_EQ(machine.getState(), linkState_t::IDLE);
+    EXPECT_TRUE(link.trace.empty());
+}
+
+TEST(StateMachineTest, should_reenter_state_when_self_transition_is_in_table) {
+    Link link;
+    StateMachine<linkState_t, Link> machine(kLinkTable, link, linkState_t::FAILED);
+
+    EXPECT_TRUE(machine.changeToState(linkState_t::FAILED));
+    EXPECT_TRUE(machine.changeToState(linkState_t::FAILED));
+
+    EXPECT_EQ(link.trace, (std::vector<std::string>{"retry", "retry"}));
+}
+
+TEST(StateMachineTest, should_see_new_state_from_entry_action_when_changing_state) {
+    Link link;
+    StateMachine<linkState_t, Link> machine(kLinkTable, link, linkState_t::IDLE);
+    link.machine = &machine;
+
+    machine.changeToState(linkState_t::CONNECTING);
+
+    EXPECT_EQ(link.stateSeenOnEntry, linkState_t::CONNECTING);
+}
+
+TEST(StateMachineTest, should_run_actions_once_per_accepted_transition_when_tasks_change_state_concurrently) {
+    Race race;
+    StateMachine<linkState_t, Race> machine(kRaceTable, race, linkState_t::IDLE);
+    constexpr int kRounds = 20000;
+    std::atomic<std::uint32_t> accepted[4]{};
+    // Both tasks dial from IDLE at once, then one wants UP and the other FAILED out of the same CONNECTING
+    auto hammer = [&](linkState_t outcome) {
+        for (int i = 0; i < kRounds; ++i) {
+            for (linkState_t state : {linkState_t::CONNECTING, outcome, linkState_t::IDLE}) {
+                if (machine.changeToState(state)) {
+                    accepted[static_cast<std::size_t>(state)].fetch_add(1);
+                }
+            }
+        }
+    };
+    std::thread up(hammer, linkState_t::UP);
+    std::thread failed(hammer, linkState_t::FAILED);
+    up.join();
+    failed.join();
+
+    const linkState_t last = machine.getState();
+    std::uint32_t total = 0;
+    for (std::size_t state = 0; state < 4; ++state) {
+        const std::uint32_t current = static_cast<linkState_t>(state) == last ? 1 : 0;
+        const std::uint32_t initial = static_cast<linkState_t>(state) == linkState_t::IDLE ? 1 : 0;
+        EXPECT_EQ(race.entered[state].load(), accepted[state].load()) << state;
+        // Every entered state but the current one was left exactly once
+        EXPECT_EQ(race.exited[state].load() + current, accepted[state].load() + initial) << state;
+        EXPECT_EQ(machine.stateStats().entries(static_cast<linkState_t>(state)), accepted[state].load() + initial)
+            << state;
+        total += accepted[state].load();
+    }
+    EXPECT_GT(total, 0u);
+    EXPECT_EQ(machine.stateStats().transitions(linkState_t::IDLE, linkState_t::CONNECTING),
+              accepted[static_cast<std::size_t>(linkState_t::CONNECTING)].load());
+    EXPECT_EQ(accepted[static_cast<std::size_t>(linkState_t::UP)].load() +
+                  accepted[static_cast<std::size_t>(linkState_t::FAILED)].load() +
+                  (last == linkState_t::CONNECTING ? 1 : 0),
+              accepted[static_cast<std::size_t>(linkState_t::CONNECTING)].load());
+}
+
+// =============================================================
+
+TEST(StateMachineLoggedTest, should_log_and_publish_when_logged_machine_changes_state) {
+    Link link;
+    StateMachineLogged<linkState_t, Link> machine(componentId_t::SDCard, kLinkTable, link, linkState_t::IDLE);
+    std::atomic<int> published{0};
+    EventBus::SubscriptionId id = EventBus::getInstance().subscribe(
+        EventFilter::any().components(componentId_t::SDCard),
+        [&](const Event& event) { published += event.is(componentId_t::SDCard, linkState_t::CONNECTING); });
+
+    EXPECT_TRUE(machine.changeToState(linkState_t::CONNECTING));
+    EXPECT_FALSE(machine.changeToState(linkState_t::IDLE));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (published.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EventBus::getInstance().unsubscribe(id);
+
+    EXPECT_EQ(published.load(), 1);
+    EXPECT_EQ(machine.getComponentId(), componentId_t::SDCard);
+    EXPECT_STREQ(machine.getStateName(), "CONNECTING");
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "StateStats.hpp"
+#include "StateMachine.hpp"
+#include "StatefulObject.hpp"
+
+/**
+ * TEST CASES
+ * StateStatsTest
+ * - should_count_initial_state_as_entered_when_constructed
+ * - should_accumulate_time_and_fill_log2_bucket_when_state_is_left
+ * - should_include_ongoing_stay_when_state_is_current
+ * - should_count_each_transition_pair_when_recorded
+ * - should_write_compact_json_record_when_exported
+ * - should_report_needed_length_and_terminate_when_buffer_is_too_small
+ * LatencyStatsTest
+ * - should_record_interval_from_latest_start_when_stopped
+ * - should_ignore_stop_when_interval_was_cancelled_or_never_started
+ * StateStatsIntegrationTest
+ * - should_record_change_when_stateful_object_changes_state
+ * - should_record_self_transition_when_state_machine_reenters_state
+ */
+
+#define LINK_STATS_STATES(X) X(DOWN) X(CONNECTING) X(UP)
+
+enum class linkStatsState_t : std::uint16_t {
+    LINK_STATS_STATES(ENUM_NAMES_VALUE)
+};
+
+DEFINE_ENUM_NAMES(linkStatsState_t, LINK_STATS_STATES)
+
+using time_service::FakeClock;
+using Stats = StateStats<linkStatsState_t, FakeClock>;
+
+class StateStatsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        FakeClock::set(1'000'000);
+    }
+};
+
+TEST_F(StateStatsTest, should_count_initial_state_as_entered_when_constructed) {
+    Stats stats(linkStatsState_t::DOWN);
+
+    EXPECT_EQ(stats.entries(linkStatsState_t::DOWN), 1u);
+    EXPECT_EQ(stats.entries(linkStatsState_t::UP), 0u);
+    EXPECT_EQ(stats.entries(static_cast<linkStatsState_t>(9)), 0u);
+}
+
+TEST_F(StateStatsTest, should_accumulate_time_and_fill_log2_bucket_when_state_is_left) {
+    Stats stats(linkStatsState_t::DOWN);
+
+    FakeClock::advance(500);       // 0.5 ms, bucket 0
+    stats.record(linkStatsState_t::DOWN, linkStatsState_t::CONNECTING);
+    FakeClock::advance(3'000'000); // 3000 ms, bucket 12: [2048, 4096)
+    stats.record(linkStatsState_t::CONNECTING, linkStatsState_t::DOWN);
+    FakeClock::advance(1'000);     // 1 ms, bucket 1
+    stats.record(linkStatsState_t::DOWN, linkStatsState_t::CONNECTING);
+
+    EXPECT_EQ(stats.timeInStateMicros(linkStatsState_t::DOWN, linkStatsState_t::CONNECTING), 1'500u);
+    EXPECT_EQ(stats.histogram(linkStatsState_t::DOWN, 0), 1u);
+    EXPECT_EQ(stats.histogram(linkStatsState_t::DOWN, 1), 1u);
+    EXPECT_EQ(stats.histogram(linkStatsState_t::CONNECTING, 12), 1u);
+    EXPECT_EQ(Stats::bucketFloorMillis(12), 2048u);
+    EXPECT_EQ(Stats::bucketOf(std::uint64_t{1} << 40), Stats::kBuckets - 1);
+}
+
+TEST_F(StateStatsTest, should_include_ongoing_stay_when_state_is_current) {
+    Stats stats(linkStatsState_t::DOWN);
+    FakeClock::advance(2'000);
+    stats.record(linkStatsState_t::DOWN, linkStatsState_t::UP);
+
+    FakeClock::advance(7'000);
+
+    EXPECT_EQ(stats.timeInStateMicros(linkStatsState_t::UP, linkStatsState_t::UP), 7'000u);
+    EXPECT_EQ(stats.timeInStateMicros(linkStatsState_t::UP, linkStatsState_t::DOWN), 0u);
+    EXPECT_EQ(stats.histogram(linkStatsState_t::UP, 0) + stats.histogram(linkStatsState_t::UP, 3), 0u);
+}
+
+TEST_F(StateStatsTest, should_count_each_transition_pair_when_recorded) {
+    Stats stats(linkStatsState_t::DOWN);
+
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        stats.record(linkStatsState_t::DOWN, linkStatsState_t::CONNECTING);
+        stats.record(linkStatsState_t::CONNECTING, linkStatsState_t::DOWN);
+    }
+    stats.record(linkStatsState_t::DOWN, linkStatsState_t::CONNECTING);
+    stats.record(linkStatsState_t::CONNECTING, linkStatsState_t::UP);
+
+    EXPECT_EQ(stats.transitions(linkStatsState_t::DOWN, linkStatsState_t::CONNECTING), 4u);
+    EXPECT_EQ(stats.transitions(linkStatsState_t::CONNECTING, linkStatsState_t::DOWN), 3u);
+    EXPECT_EQ(stats.transitions(linkStatsState_t::CONNECTING, linkStatsState_t::UP), 1u);
+    EXPECT_EQ(stats.transitions(linkStatsState_t::UP, linkStatsState_t::DOWN), 0u);
+    EXPECT_EQ(stats.entries(linkStatsState_t::DOWN), 4u);
+    EXPECT_EQ(stats.entries(linkStatsState_t::CONNECTING), 4u);
+}
+
+TEST_F(StateStatsTest, should_write_compact_json_record_when_exported) {
+    Stats stats(linkStatsState_t::DOWN);
+    FakeClock::advance(1'500);
+    stats.record(linkStatsState_t::DOWN, linkStatsState_t::CONNECTING);
+    FakeClock::advance(5'000);
+    stats.record(linkStatsState_t::CONNECTING, linkStatsState_t::DOWN);
+    FakeClock::advance(2'000);
+
+    char record[256];
+    std::size_t length = stats.writeJson(record, sizeof(record), linkStatsState_t::DOWN);
+
+    EXPECT_STREQ(record, "{\"DOWN\":{\"n\":2,\"ms\":3,\"h\":[0,1],\"to\":{\"CONNECTING\":1}},"
+                         "\"CONNECTING\":{\"n\":1,\"ms\":5,\"h\":[0,0,0,1],\"to\":{\"DOWN\":1}}}");
+    EXPECT_EQ(length, std::strlen(record));
+}
+
+TEST_F(StateStatsTest, should_report_needed_length_and_terminate_when_buffer_is_too_small) {
+    Stats stats(linkStatsState_t::DOWN);
+    stats.record(linkStatsState_t::DOWN, linkStatsState_t::UP);
+    char full[256];
+    std::size_t needed = stats.writeJson(full, sizeof(full), linkStatsState_t::UP);
+
+    char small[16];
+    std::size_t reported = stats.writeJson(small, sizeof(small), linkStatsState_t::UP);
+
+    EXPECT_EQ(reported, needed);
+    EXPECT_EQ(std::string(small), std::string(full, sizeof(small) - 1));
+    EXPECT_EQ(stats.writeJson(nullptr, 0, linkStatsState_t::UP), needed);
+}
+
+// =============================================================
+
+class LatencyStatsTest : public StateStatsTest {};
+
+TEST_F(LatencyStatsTest, should_record_interval_from_latest_start_when_stopped) {
+    LatencyStats<FakeClock> latency;
+
+    latency.start();
+    FakeClock::advance(400'000);
+    latency.start(); // Link came up again before the other side connected
+    FakeClock::advance(2'500'000);
+    EXPECT_TRUE(latency.stop());
+    latency.start();
+    FakeClock::advance(900);
+    EXPECT_TRUE(latency.stop());
+
+    EXPECT_EQ(latency.intervals(), 2u);
+    EXPECT_EQ(latency.totalIntervalMicros(), 2'500'900u);
+    EXPECT_EQ(latency.maxIntervalMicros(), 2'500'000u);
+    EXPECT_EQ(latency.bucket(0), 1u);
+    EXPECT_EQ(latency.bucket(12), 1u); // [2048, 4096) ms
+
+    char record[128];
+    std::size_t length = latency.writeJson(record, sizeof(record));
+    EXPECT_STREQ(record, "{\"n\":2,\"ms\":2500,\"max\":2500,\"h\":[1,0,0,0,0,0,0,0,0,0,0,0,1]}");
+    EXPECT_EQ(length, std::strlen(record));
+}
+
+TEST_F(LatencyStatsTest, should_ignore_stop_when_interval_was_cancelled_or_never_started) {
+    LatencyStats<FakeClock> latency;
+
+    EXPECT_FALSE(latency.stop());
+    latency.start();
+    FakeClock::advance(1'000);
+    latency.cancel(); // Link dropped first
+    EXPECT_FALSE(latency.stop());
+    latency.start();
+    EXPECT_TRUE(latency.stop());
+    EXPECT_FALSE(latency.stop());
+
+    EXPECT_EQ(latency.intervals(), 1u);
+    EXPECT_EQ(latency.totalIntervalMicros(), 0u);
+}
+
+// =============================================================
+
+namespace {
+
+struct Retrier {
+    static void retry(Retrier&, linkStatsState_t, linkStatsState_t) {
+    }
+};
+
+constexpr StateMachine<linkStatsState_t, Retrier>::Table kRetryTable{{
+    {linkStatsState_t::DOWN, linkStatsState_t::CONNECTING},
+    {linkStatsState_t::CONNECTING, linkStatsState_t::CONNECTING, &Retrier::retry},
+    {linkStatsState_t::CONNECTING, linkStatsState_t::UP},
+}};
+
+} // namespace
+
+TEST(StateStatsIntegrationTest, should_record_change_when_stateful_object_changes_state) {
+    StatefulObject<linkStatsState_t> link("link", linkStatsState_t::DOWN);
+
+    link.setState(linkStatsState_t::UP);
+    link.setState(linkStatsState_t::UP); // No change, nothing recorded
+    link.setState(linkStatsState_t::DOWN);
+
+    EXPECT_EQ(link.stateStats().transitions(linkStatsState_t::DOWN, linkStatsState_t::UP), 1u);
+    EXPECT_EQ(link.stateStats().transitions(linkStatsState_t::UP, linkStatsState_t::DOWN), 1u);
+    EXPECT_EQ(link.stateStats().entries(linkStatsState_t::UP), 1u);
+}
+
+TEST(StateStatsIntegrationTest, should_record_self_transition_when_state_machine_reenters_state) {
+    Retrier retrier;
+    StateMachine<linkStatsState_t, Retrier> machine(kRetryTable, retrier, linkStatsState_t::DOWN);
+
+    machine.changeToState(linkStatsState_t::CONNECTING);
+    machine.changeToState(linkStatsState_t::CONNECTING);
+    machine.changeToState(linkStatsState_t::CONNECTING);
+    machine.changeToState(linkStatsState_t::DOWN); // Not in the table
+    machine.changeToState(linkStatsState_t::UP);
+
+    EXPECT_EQ(machine.stateStats().transitions(linkStatsState_t::CONNECTING, linkStatsState_t::CONNECTING), 2u);
+    EXPECT_EQ(machine.stateStats().entries(linkStatsState_t::CONNECTING), 3u);
+    EXPECT_EQ(machine.stateStats().transitions(linkStatsState_t::CONNECTING, linkStatsState_t::UP), 1u);
+    EXPECT_EQ(machine.stateStats().transitions(linkStatsState_t::CONNECTING, linkStatsState_t::DOWN), 0u);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "TimeSeriesBuffer.hpp"
+
+/**
+ * TEST CASES
+ * TimeSeriesBufferTest
+ * - should_return_entries_at_or_after_t_when_since_is_called
+ * - should_return_inclusive_window_when_between_is_called
+ * - should_find_window_across_both_spans_given_buffer_has_wrapped
+ * - should_return_empty_view_when_window_is_outside_buffered_range
+ * - should_reject_push_when_timestamp_goes_backwards
+ * - should_release_replayed_entries_when_drop_before_is_called
+ */
+
+class TimeSeriesBufferTest : public ::testing::Test {
+protected:
+    using Series = TimeSeriesBuffer<int, 6>;
+
+    // Timestamps of a view, oldest first
+    static std::vector<std::uint64_t> timestamps(const Series::View& view) {
+        std::vector<std::uint64_t> result;
+        for (const auto& span : {view.first, view.second}) {
+            for (const auto& entry : span) {
+                result.push_back(entry.timestamp);
+            }
+        }
+        return result;
+    }
+
+    Series series;
+};
+
+TEST_F(TimeSeriesBufferTest, should_return_entries_at_or_after_t_when_since_is_called) {
+    for (std::uint64_t t : {10, 20, 30, 40}) {
+        series.push(t, static_cast<int>(t));
+    }
+
+    EXPECT_EQ(timestamps(series.since(20)), (std::vector<std::uint64_t>{20, 30, 40}));
+    EXPECT_EQ(timestamps(series.since(25)), (std::vector<std::uint64_t>{30, 40}));
+    EXPECT_EQ(timestamps(series.since(0)), (std::vector<std::uint64_t>{10, 20, 30, 40}));
+}
+
+TEST_F(TimeSeriesBufferTest, should_return_inclusive_window_when_between_is_called) {
+    for (std::uint64_t t : {10, 20, 20, 30, 40}) {
+        series.push(t, 0);
+    }
+
+    EXPECT_EQ(timestamps(series.between(20, 30)), (std::vector<std::uint64_t>{20, 20, 30}));
+    EXPECT_EQ(timestamps(series.between(11, 19)), (std::vector<std::uint64_t>{}));
+}
+
+TEST_F(TimeSeriesBufferTest, should_find_window_across_both_spans_given_buffer_has_wrapped) {
+    // Given: 10 pushes into 6 slots, the buffered region (50..100) is split over the end of the storage
+    for (std::uint64_t t = 10; t <= 100; t += 10) {
+        series.push(t, 0);
+    }
+    ASSERT_FALSE(series.all().second.empty());
+
+    EXPECT_EQ(timestamps(series.since(55)), (std::vector<std::uint64_t>{60, 70, 80, 90, 100}));
+    EXPECT_EQ(timestamps(series.between(60, 90)), (std::vector<std::uint64_t>{60, 70, 80, 90}));
+    EXPECT_EQ(timestamps(series.since(95)), (std::vector<std::uint64_t>{100}));
+}
+
+TEST_F(TimeSeriesBufferTest, should_return_empty_view_when_window_is_outside_buffered_range) {
+    series.push(10, 0);
+    series.push(20, 0);
+
+    EXPECT_EQ(series.since(21).size(), 0u);
+    EXPECT_EQ(series.between(30, 40).size(), 0u);
+    EXPECT_EQ(series.between(20, 10).size(), 0u);
+}
+
+TEST_F(TimeSeriesBufferTest, should_reject_push_when_timestamp_goes_backwards) {
+    EXPECT_TRUE(series.push(20, 1));
+    EXPECT_FALSE(series.push(10, 2));
+    EXPECT_TRUE(series.push(20, 3));
+
+    EXPECT_EQ(series.size(), 2u);
+}
+
+TEST_F(TimeSeriesBufferTest, should_release_replayed_entries_when_drop_before_is_called) {
+    for (std::uint64_t t = 10; t <= 80; t += 10) {
+        series.push(t, 0);
+    }
+
+    EXPECT_EQ(series.drop_before(55), 3u); // 30, 40, 50 (10 and 20 were already overwritten)
+
+    EXPECT_EQ(timestamps(series.all()), (std::vector<std::uint64_t>{60, 70, 80}));
+}
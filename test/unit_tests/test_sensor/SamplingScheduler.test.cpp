@@ -0,0 +1,405 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+#include <EventBus.hpp>
+#include <EventLogger.hpp>
+#include "SamplingScheduler.hpp"
+
+/**
+ * TEST CASES
+ * SamplingSchedulerTest
+ * - should_read_each_sensor_once_per_period_when_time_advances
+ * - should_read_earliest_deadline_first_when_several_sensors_are_due
+ * - should_not_read_sensor_when_deadline_has_not_passed
+ * - should_count_jitter_when_earlier_read_delays_sensor
+ * - should_skip_missed_periods_and_keep_phase_when_read_overruns
+ * - should_reject_sensor_when_capacity_is_full_or_period_is_zero
+ * SamplingSchedulerIsolationTest
+ * - should_hand_read_to_reader_when_sensor_has_read_budget
+ * - should_count_timeout_once_when_read_returns_after_budget
+ * - should_skip_periods_and_degrade_when_read_stalls_until_one_returns_on_time
+ * - should_count_jitter_from_read_start_when_read_waits_for_reader
+ * - should_skip_budgeted_reads_when_every_reader_is_held_by_an_overdue_read
+ * - should_log_and_publish_each_sensor_when_several_sensor_healths_change
+ * SamplingSchedulerTaskTest
+ * - should_sample_on_own_task_when_started
+ * - should_keep_healthy_sensor_jitter_below_stall_when_other_sensor_is_stalled
+ */
+
+using time_service::FakeClock;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::vector<std::string> reads;
+
+class FakeSensor : public Sensor {
+public:
+    FakeSensor(std::string id, std::chrono::microseconds readDuration = 0us)
+        : Sensor(std::move(id)), readDuration(readDuration) {
+    }
+
+    void sensorRead() override {
+        reads.push_back(getId());
+        FakeClock::advance(static_cast<std::uint64_t>(readDuration.count()));
+        ++count;
+    }
+
+    std::chrono::microseconds readDuration;
+    int count{0};
+};
+
+} // namespace
+
+class SamplingSchedulerTest : public ::testing::Test {
+protected:
+    using Scheduler = BasicSamplingScheduler<FakeClock, 4>;
+
+    void SetUp() override {
+        FakeClock::set(1'000'000);
+        reads.clear();
+    }
+
+    // Step through time in 1 ms ticks, like the sampler task waking at each deadline
+    void runFor(std::chrono::milliseconds duration) {
+        for (auto elapsed = 0ms; elapsed < duration; elapsed += 1ms) {
+            FakeClock::advance(1000);
+            scheduler.runDue();
+        }
+    }
+
+    Scheduler scheduler;
+};
+
+TEST_F(SamplingSchedulerTest, should_read_each_sensor_once_per_period_when_time_advances) {
+    FakeSensor fast("fast");
+    FakeSensor medium("medium");
+    FakeSensor slow("slow");
+    scheduler.add(fast, 10ms);
+    scheduler.add(medium, 20ms);
+    scheduler.add(slow, 50ms);
+
+    scheduler.runDue();
+    runFor(100ms);
+
+    EXPECT_EQ(fast.count, 11);  // 0, 10, ..., 100 ms
+    EXPECT_EQ(medium.count, 6);
+    EXPECT_EQ(slow.count, 3);
+    EXPECT_EQ(scheduler.nextDeadline(), 1'000'000u + 110'000u);
+}
+
+TEST_F(SamplingSchedulerTest, should_read_earliest_deadline_first_when_several_sensors_are_due) {
+    FakeSensor a("a");
+    FakeSensor b("b");
+    scheduler.add(a, 30ms);
+    scheduler.add(b, 20ms);
+    scheduler.runDue();
+    reads.clear();
+
+    runFor(60ms); // b at 20, a at 30, b at 40, then a and b both at 60
+
+    EXPECT_EQ(reads, (std::vector<std::string>{"b", "a", "b", "a", "b"}));
+}
+
+TEST_F(SamplingSchedulerTest, should_not_read_sensor_when_deadline_has_not_passed) {
+    FakeSensor sensor("sensor");
+    scheduler.add(sensor, 10ms);
+    EXPECT_EQ(scheduler.runDue(), 1u);
+
+    FakeClock::advance(9'999);
+
+    EXPECT_EQ(scheduler.runDue(), 0u);
+    FakeClock::advance(1);
+    EXPECT_EQ(scheduler.runDue(), 1u);
+}
+
+TEST_F(SamplingSchedulerTest, should_count_jitter_when_earlier_read_delays_sensor) {
+    FakeSensor blocking("blocking", 3ms);
+    FakeSensor delayed("delayed");
+    scheduler.add(blocking, 10ms);
+    std::size_t slot = scheduler.add(delayed, 10ms);
+
+    scheduler.runDue();
+    runFor(20ms);
+
+    SamplingStats stats = scheduler.stats(slot);
+    EXPECT_EQ(stats.samples, 3u);
+    EXPECT_EQ(stats.maxJitterMicros, 3000u);
+    EXPECT_EQ(stats.meanJitterMicros(), 3000u);
+    EXPECT_EQ(stats.overruns, 0u);
+    EXPECT_EQ(scheduler.stats(0).maxJitterMicros, 0u);
+}
+
+TEST_F(SamplingSchedulerTest, should_skip_missed_periods_and_keep_phase_when_read_overruns) {
+    FakeSensor stalled("stalled", 25ms);
+    std::size_t slot = scheduler.add(stalled, 10ms);
+
+    scheduler.runDue(); // Deadline 0 finishes at 25 ms, 10 and 20 are gone
+
+    EXPECT_EQ(scheduler.stats(slot).overruns, 2u);
+    EXPECT_EQ(scheduler.nextDeadline(), 1'000'000u + 30'000u);
+}
+
+TEST_F(SamplingSchedulerTest, should_reject_sensor_when_capacity_is_full_or_period_is_zero) {
+    std::vector<FakeSensor> sensors(5, FakeSensor("s"));
+
+    EXPECT_EQ(scheduler.add(sensors[0], 0ms), Scheduler::kNoSlot);
+    for (std::size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(scheduler.add(sensors[i], 1ms), i);
+    }
+    EXPECT_EQ(scheduler.add(sensors[4], 1ms), Scheduler::kNoSlot);
+    EXPECT_EQ(scheduler.size(), 4u);
+    EXPECT_EQ(scheduler.stats(Scheduler::kNoSlot).samples, 0u);
+}
+
+// =============================================================
+
+TEST_F(SamplingSchedulerTest, should_hand_read_to_reader_when_sensor_has_read_budget) {
+    FakeSensor isolated("isolated");
+    std::size_t slot = scheduler.add(isolated, 10ms, 5ms);
+
+    EXPECT_EQ(scheduler.runDue(), 1u);
+    EXPECT_EQ(isolated.count, 0); // Waits for a reader
+
+    EXPECT_EQ(scheduler.runReads(), 1u);
+    EXPECT_EQ(isolated.count, 1);
+    EXPECT_EQ(scheduler.stats(slot).samples, 1u);
+    EXPECT_EQ(scheduler.stats(slot).timeouts, 0u);
+    EXPECT_EQ(scheduler.health(slot).getState(), sensorState_t::HEALTHY);
+}
+
+TEST_F(SamplingSchedulerTest, should_count_timeout_once_when_read_returns_after_budget) {
+    FakeSensor slow("slow", 8ms);
+    std::size_t slot = scheduler.add(slow, 10ms, 5ms);
+    scheduler.runDue();
+
+    scheduler.runReads(); // Returns at 8 ms, budget ended at 5 ms
+    FakeClock::advance(1000);
+    scheduler.runDue();
+
+    EXPECT_EQ(scheduler.stats(slot).timeouts, 1u);
+    EXPECT_EQ(scheduler.stats(slot).consecutiveMisses, 1u);
+    EXPECT_EQ(scheduler.stats(slot).overruns, 0u); // Back before the next period
+}
+
+TEST_F(SamplingSchedulerTest, should_skip_periods_and_degrade_when_read_stalls_until_one_returns_on_time) {
+    FakeSensor healthy("healthy");
+    FakeSensor stalled("stalled");
+    std::size_t healthySlot = scheduler.add(healthy, 10ms);
+    std::size_t stalledSlot = scheduler.add(stalled, 10ms, 5ms);
+    scheduler.runDue(); // The stalled read is handed over and never run
+
+    runFor(5ms); // Budget runs out: miss 1
+    EXPECT_EQ(scheduler.stats(stalledSlot).timeouts, 1u);
+    runFor(15ms); // Periods at 10 and 20 ms skipped: misses 2 and 3
+
+    EXPECT_EQ(scheduler.stats(stalledSlot).consecutiveMisses, 3u);
+    EXPECT_EQ(scheduler.stats(stalledSlot).overruns, 2u);
+    EXPECT_EQ(scheduler.health(stalledSlot).getState(), sensorState_t::DEGRADED);
+    EXPECT_EQ(healthy.count, 3);
+    EXPECT_EQ(scheduler.stats(healthySlot).maxJitterMicros, 0u);
+    EXPECT_EQ(scheduler.health(healthySlot).getState(), sensorState_t::HEALTHY);
+
+    scheduler.runReads(); // The stalled read finally returns, already counted
+    runFor(10ms);         // Handed over again at 30 ms
+    scheduler.runReads(); // On time this time
+    runFor(1ms);
+
+    EXPECT_EQ(scheduler.stats(stalledSlot).timeouts, 1u);
+    EXPECT_EQ(scheduler.stats(stalledSlot).consecutiveMisses, 0u);
+    EXPECT_EQ(scheduler.health(stalledSlot).getState(), sensorState_t::HEALTHY);
+}
+
+TEST_F(SamplingSchedulerTest, should_count_jitter_from_read_start_when_read_waits_for_reader) {
+    FakeSensor isolated("isolated");
+    std::size_t slot = scheduler.add(isolated, 10ms, 5ms);
+    scheduler.runDue(); // Handed over on time
+
+    FakeClock::advance(2000); // Queued 2 ms for a reader
+    scheduler.runReads();
+
+    EXPECT_EQ(scheduler.stats(slot).samples, 1u);
+    EXPECT_EQ(scheduler.stats(slot).maxJitterMicros, 2000u);
+    EXPECT_EQ(scheduler.stats(slot).timeouts, 0u);
+}
+
+TEST_F(SamplingSchedulerTest, should_skip_budgeted_reads_when_every_reader_is_held_by_an_overdue_read) {
+    static_assert(SAMPLING_SCHEDULER_READERS == 2, "two hung sensors hold every reader");
+    FakeSensor hungA("hungA");
+    FakeSensor hungB("hungB");
+    FakeSensor waiting("waiting");
+    scheduler.add(hungA, 10ms, 5ms);
+    scheduler.add(hungB, 10ms, 5ms);
+    scheduler.runDue(); // Both handed over and never run
+    runFor(5ms);        // Both past their budget
+    std::size_t slot = scheduler.add(waiting, 10ms, 5ms);
+
+    EXPECT_EQ(scheduler.runDue(), 0u); // Not queued behind them
+
+    EXPECT_EQ(scheduler.stats(slot).samples, 0u);
+    EXPECT_EQ(scheduler.stats(slot).overruns, 1u);
+    EXPECT_EQ(scheduler.stats(slot).consecutiveMisses, 1u);
+
+    EXPECT_EQ(scheduler.runReads(), 2u); // The hung reads return, the readers are free again
+    runFor(5ms);                         // hungA and hungB handed over again at 10 ms
+    scheduler.runReads();
+    runFor(5ms); // waiting handed over at 15 ms
+    scheduler.runReads();
+
+    EXPECT_EQ(waiting.count, 1);
+    EXPECT_EQ(scheduler.stats(slot).consecutiveMisses, 0u);
+    EXPECT_EQ(scheduler.stats(0).timeouts, 1u);
+}
+
+namespace {
+std::mutex linesMutex;
+std::vector<std::string> lines;
+
+void captureLine(const char* line) {
+    std::lock_guard<std::mutex> lock(linesMutex);
+    lines.emplace_back(line);
+}
+} // namespace
+
+TEST_F(SamplingSchedulerTest, should_log_and_publish_each_sensor_when_several_sensor_healths_change) {
+    EventLogger& logger = EventLogger::getInstance();
+    logger.flush();
+    logger.setLineSink(captureLine);
+    lines.clear();
+    std::mutex eventsMutex;
+    std::vector<Event> events;
+    std::counting_semaphore<> delivered{0};
+    bool marked = false; // Only touched by the dispatcher
+    EventBus::SubscriptionId subscription = EventBus::getInstance().subscribe(
+        EventFilter::any().components(componentId_t::Sensor), [&](const Event& event) {
+            if (event.type == eventType_t::FAULT) {
+                marked = true;
+                return;
+            }
+            if (marked) {
+                {
+                    std::lock_guard<std::mutex> lock(eventsMutex);
+                    events.push_back(event);
+                }
+                delivered.release();
+            }
+        });
+    // Events of earlier tests may still be queued, the bus delivers in order so ours come after this marker
+    EventBus::getInstance().publish(Event::fault(componentId_t::Sensor, 0));
+    FakeSensor imu("imu");
+    FakeSensor baro("baro");
+    std::size_t imuSlot = scheduler.add(imu, 10ms, 5ms);
+    std::size_t baroSlot = scheduler.add(baro, 10ms, 5ms);
+
+    scheduler.runDue();
+    runFor(25ms); // Both stalled: DEGRADED
+    scheduler.runReads();
+    runFor(5ms); // Handed over again at 30 ms
+    scheduler.runReads();
+    runFor(1ms); // Both on time again: HEALTHY
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(delivered.try_acquire_for(1s));
+    }
+    EventBus::getInstance().unsubscribe(subscription);
+    logger.flush();
+    logger.setLineSink(nullptr);
+
+    // Four changes of one component in a flap window, none folded: each sensor has a window of its own
+    auto countLines = [](const std::string& needle) {
+        std::lock_guard<std::mutex> lock(linesMutex);
+        return std::count_if(lines.begin(), lines.end(),
+                             [&](const std::string& line) { return line.find(needle) != std::string::npos; });
+    };
+    EXPECT_EQ(countLines("] Sensor imu -> DEGRADED"), 1);
+    EXPECT_EQ(countLines("] Sensor baro -> DEGRADED"), 1);
+    EXPECT_EQ(countLines("] Sensor imu -> HEALTHY"), 1);
+    EXPECT_EQ(countLines("] Sensor baro -> HEALTHY"), 1);
+    EXPECT_EQ(scheduler.health(baroSlot).getId(), "Sensor baro");
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_TRUE(events[0].is(componentId_t::Sensor, sensorState_t::DEGRADED));
+    EXPECT_EQ(events[0].detail, imuSlot);
+    EXPECT_EQ(events[1].detail, baroSlot);
+    EXPECT_TRUE(events[3].is(componentId_t::Sensor, sensorState_t::HEALTHY));
+    EXPECT_EQ(events[3].detail, baroSlot);
+}
+
+// =============================================================
+
+TEST(SamplingSchedulerTaskTest, should_sample_on_own_task_when_started) {
+    struct CountingSensor : Sensor {
+        CountingSensor() : Sensor("counting") {
+        }
+
+        void sensorRead() override {
+            count.fetch_add(1);
+        }
+
+        std::atomic<int> count{0};
+    } sensor;
+    BasicSamplingScheduler<time_service::SteadyClock, 2> scheduler;
+    scheduler.add(sensor, 2ms);
+
+    scheduler.start();
+    std::this_thread::sleep_for(50ms);
+    scheduler.stop();
+
+    // The rate is covered by the step-mode tests, on the host clock only that the task samples and counts each read
+    EXPECT_GT(sensor.count.load(), 0);
+    EXPECT_EQ(scheduler.stats(0).samples, static_cast<std::uint32_t>(sensor.count.load()));
+}
+
+TEST(SamplingSchedulerTaskTest, should_keep_healthy_sensor_jitter_below_stall_when_other_sensor_is_stalled) {
+    struct CountingSensor : Sensor {
+        CountingSensor() : Sensor("healthy") {
+        }
+
+        void sensorRead() override {
+            count.fetch_add(1);
+        }
+
+        std::atomic<int> count{0};
+    } healthy;
+    // Hangs like a device holding the I2C bus, until released
+    struct StalledSensor : Sensor {
+        StalledSensor() : Sensor("stalled") {
+        }
+
+        void sensorRead() override {
+            if (reads.fetch_add(1) == 0) {
+                unstall.acquire();
+            }
+        }
+
+        std::atomic<int> reads{0};
+        std::binary_semaphore unstall{0};
+    } stalled;
+    BasicSamplingScheduler<time_service::SteadyClock, 2> scheduler;
+    scheduler.add(healthy, 2ms);
+    scheduler.add(stalled, 5ms, 2ms);
+
+    scheduler.start();
+    std::this_thread::sleep_for(50ms);
+    const SamplingStats early = scheduler.stats(0);
+    std::this_thread::sleep_for(100ms);
+    const SamplingStats late = scheduler.stats(0);
+    EXPECT_TRUE(scheduler.health(1).waitFor(sensorState_t::DEGRADED, 1000ms));
+    EXPECT_EQ(scheduler.stats(1).timeouts, 1u);
+    EXPECT_GE(scheduler.stats(1).consecutiveMisses, 20u);
+    stalled.unstall.release();
+    EXPECT_TRUE(scheduler.health(1).waitFor(sensorState_t::HEALTHY, 1000ms));
+    scheduler.stop();
+
+    // Held up by the 150 ms stall, the healthy sensor would have read once, 150 ms late, and skipped every later
+    // period. what is left is the host's wake-up latency, a few ms on a loaded single core
+    EXPECT_LT(late.maxJitterMicros, 50'000u);
+    EXPECT_GE(late.samples - early.samples, 25u); // Of 50 periods in those 100 ms
+    EXPECT_LT(late.overruns - early.overruns, 25u);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "TimeService.hpp"
+
+/**
+ * TEST CASES
+ * TimeServiceTest
+ * - should_advance_ticks_when_fake_clock_advances
+ * - should_not_convert_when_never_synced
+ * - should_convert_ticks_captured_before_sync_when_sync_happens_later
+ * - should_use_latest_sync_at_or_before_sample_when_clock_was_resynced
+ * - should_ignore_sync_when_it_is_older_than_the_latest_one
+ * - should_not_convert_when_sync_points_were_reset
+ * - should_widen_32bit_ticks_when_tick_counter_wrapped
+ */
+
+class TimeServiceTest : public ::testing::Test {
+protected:
+    using Service = BasicTimeService<time_service::FakeClock>;
+
+    void SetUp() override {
+        time_service::FakeClock::set(5'000'000); // 5 s after boot
+    }
+
+    static constexpr std::int64_t kUnix2026 = 1'790'000'000LL * 1'000'000; // Some wall time in microseconds
+    Service service;
+};
+
+TEST_F(TimeServiceTest, should_advance_ticks_when_fake_clock_advances) {
+    std::uint64_t before = Service::now();
+    time_service::FakeClock::advance(1500);
+
+    EXPECT_EQ(Service::now() - before, 1500u);
+    EXPECT_EQ(Service::now32(), 5001u);
+}
+
+TEST_F(TimeServiceTest, should_not_convert_when_never_synced) {
+    EXPECT_FALSE(service.isSynced());
+    EXPECT_FALSE(service.toWallMicros(Service::now()).has_value());
+}
+
+TEST_F(TimeServiceTest, should_convert_ticks_captured_before_sync_when_sync_happens_later) {
+    // Given: a sample captured while offline
+    std::uint64_t sampleTicks = Service::now();
+
+    // When: SNTP syncs 10 minutes later
+    time_service::FakeClock::advance(600'000'000);
+    service.sync(kUnix2026);
+
+    // Then: the sample maps to 10 minutes before the sync
+    EXPECT_EQ(service.toWallMicros(sampleTicks), kUnix2026 - 600'000'000);
+}
+
+TEST_F(TimeServiceTest, should_use_latest_sync_at_or_before_sample_when_clock_was_resynced) {
+    service.sync(kUnix2026);
+    std::uint64_t firstSync = Service::now();
+    time_service::FakeClock::advance(3'600'000'000); // An hour later the tick clock has drifted 2 ms behind
+    service.sync(kUnix2026 + 3'600'002'000);
+
+    std::uint64_t afterSecond = Service::now() + 1000;
+    EXPECT_EQ(service.toWallMicros(firstSync + 1000), kUnix2026 + 1000);
+    EXPECT_EQ(service.toWallMicros(afterSecond), kUnix2026 + 3'600'002'000 + 1000);
+    EXPECT_EQ(service.toWallMicros(firstSync - 1000), kUnix2026 - 1000); // Before any sync: the earliest one
+}
+
+TEST_F(TimeServiceTest, should_ignore_sync_when_it_is_older_than_the_latest_one) {
+    service.sync(kUnix2026, 2'000'000);
+    service.sync(kUnix2026 + 42, 1'000'000);
+
+    EXPECT_EQ(service.toWallMicros(3'000'000), kUnix2026 + 1'000'000);
+}
+
+TEST_F(TimeServiceTest, should_not_convert_when_sync_points_were_reset) {
+    service.sync(kUnix2026);
+    service.reset();
+
+    EXPECT_FALSE(service.isSynced());
+    EXPECT_FALSE(service.toWallMicros(Service::now()).has_value());
+
+    // An older sync is accepted again, the history starts over
+    service.sync(kUnix2026, Service::now() - 1000);
+    EXPECT_EQ(service.toWallMicros(Service::now()), kUnix2026 + 1000);
+}
+
+TEST_F(TimeServiceTest, should_widen_32bit_ticks_when_tick_counter_wrapped) {
+    std::uint64_t captured = (std::uint64_t{1} << 32) * 1000 - 3000; // 3 ms before the 32-bit millisecond wrap
+    std::uint32_t compact = static_cast<std::uint32_t>(captured / 1000);
+    std::uint64_t reference = captured + 10'000; // 10 ms later, after the wrap
+
+    EXPECT_LT(static_cast<std::uint32_t>(reference / 1000), compact);
+    EXPECT_EQ(Service::widen(compact, reference), captured);
+}
@@ -0,0 +1,76 @@
+/**
+ * @file logdecode.cpp
+ * @brief host CLI that turns LogStore segments pulled from a field unit's SD card back into text, one line per
+ * record in the same "[seconds.micros] message" form EventLogger prints on the console.
+ *
+ * build: g++ -std=c++20 -Ilib/Logger tools/logdecode/logdecode.cpp -o logdecode
+ * usage: logdecode LG000012.BIN LG000013.BIN ...   (segments are printed in sequence order)
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "LogStore.hpp"
+
+namespace {
+
+struct Segment {
+    std::string path;
+    std::vector<std::uint8_t> bytes;
+    std::uint32_t sequence{0};
+};
+
+bool load(Segment& segment) {
+    std::ifstream file(segment.path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    segment.bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    // A header-only pass, so the segments can be sorted before anything is printed
+    return log_store::decode(std::span<const std::uint8_t>(segment.bytes).first(
+                                 std::min(segment.bytes.size(), log_store::kHeaderBytes)),
+                             [](const LogRecord&) {}, &segment.sequence);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <segment.BIN>...\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<Segment> segments;
+    int status = 0;
+    for (int i = 1; i < argc; ++i) {
+        Segment segment;
+        segment.path = argv[i];
+        if (!load(segment)) {
+            std::fprintf(stderr, "%s: not a log segment\n", argv[i]);
+            status = 1;
+            continue;
+        }
+        segments.push_back(std::move(segment));
+    }
+    std::sort(segments.begin(), segments.end(),
+              [](const Segment& a, const Segment& b) { return a.sequence < b.sequence; });
+
+    for (const Segment& segment : segments) {
+        bool complete = log_store::decode(segment.bytes, [](const LogRecord& record) {
+            char line[256];
+            log_record::format(record, line, sizeof(line));
+            std::printf("[%llu.%06llu] %s\n", static_cast<unsigned long long>(record.timestamp / 1000000),
+                        static_cast<unsigned long long>(record.timestamp % 1000000), line);
+        });
+        if (!complete) {
+            std::fprintf(stderr, "%s: truncated after the last printed record\n", segment.path.c_str());
+            status = 1;
+        }
+    }
+    return status;
+}